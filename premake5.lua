@@ -89,6 +89,30 @@ if _OPTIONS["with-tests"] then
     language "C++"
 
     files { "tests/**.cc" }
+    -- Replaces operator new for the whole program, so it runs on its own.
+    removefiles { "tests/sampling_heap_profiler_unittest.cc" }
+    includedirs { "src", "tests", "third_party" }
+    defines { "UNICODE" }
+
+    filter "system:linux"
+      buildoptions { "-std=c++14", "-fno-rtti" }
+      links { "chromium_base", "pthread" }
+
+    filter "system:windows"
+      links { "chromium_base", "winmm", "shlwapi", "Ole32", "Dbghelp" }
+
+    filter "system:macosx"
+      buildoptions { "-std=c++14", "-fno-rtti" }
+      links { "chromium_base", "pthread" }
+
+  project "chromium_base_heap_profiler_unittest"
+    kind "ConsoleApp"
+    language "C++"
+
+    files {
+      "tests/main.cc",
+      "tests/sampling_heap_profiler_unittest.cc"
+    }
     includedirs { "src", "tests", "third_party" }
     defines { "UNICODE" }
 
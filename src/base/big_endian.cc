@@ -7,9 +7,48 @@
 #include <string.h>
 
 #include "base/strings/string_piece.h"
+#include "base/sys_byteorder.h"
 
 namespace base {
 
+namespace {
+
+// Overloads so that the templates below can pick the bulk conversion by type.
+inline void NetToHostBuffer(const char* src, uint8_t* dst, size_t count) {
+  memcpy(dst, src, count);
+}
+inline void NetToHostBuffer(const char* src, uint16_t* dst, size_t count) {
+  NetToHostBuffer16(src, dst, count);
+}
+inline void NetToHostBuffer(const char* src, uint32_t* dst, size_t count) {
+  NetToHostBuffer32(src, dst, count);
+}
+inline void NetToHostBuffer(const char* src, uint64_t* dst, size_t count) {
+  NetToHostBuffer64(src, dst, count);
+}
+
+inline void HostToNetBuffer(const uint16_t* src, char* dst, size_t count) {
+  HostToNetBuffer16(src, dst, count);
+}
+inline void HostToNetBuffer(const uint32_t* src, char* dst, size_t count) {
+  HostToNetBuffer32(src, dst, count);
+}
+inline void HostToNetBuffer(const uint64_t* src, char* dst, size_t count) {
+  HostToNetBuffer64(src, dst, count);
+}
+
+}  // namespace
+
+template <typename T>
+void BigEndianArrayView<T>::CopyTo(T* out) const {
+  NetToHostBuffer(data_, out, size_);
+}
+
+template class BASE_EXPORT BigEndianArrayView<uint8_t>;
+template class BASE_EXPORT BigEndianArrayView<uint16_t>;
+template class BASE_EXPORT BigEndianArrayView<uint32_t>;
+template class BASE_EXPORT BigEndianArrayView<uint64_t>;
+
 BigEndianReader::BigEndianReader(const char* buf, size_t len)
     : ptr_(buf), end_(ptr_ + len) {}
 
@@ -61,6 +100,34 @@ bool BigEndianReader::ReadU64(uint64_t* value) {
   return Read(value);
 }
 
+bool BigEndianReader::SkipArray(size_t element_size, size_t count) {
+  if (count > static_cast<size_t>(end_ - ptr_) / element_size)
+    return false;
+  ptr_ += count * element_size;
+  return true;
+}
+
+template<typename T>
+bool BigEndianReader::ReadArray(T* out, size_t count) {
+  const char* start = ptr_;
+  if (!SkipArray(sizeof(T), count))
+    return false;
+  NetToHostBuffer(start, out, count);
+  return true;
+}
+
+bool BigEndianReader::ReadU16Array(uint16_t* out, size_t count) {
+  return ReadArray(out, count);
+}
+
+bool BigEndianReader::ReadU32Array(uint32_t* out, size_t count) {
+  return ReadArray(out, count);
+}
+
+bool BigEndianReader::ReadU64Array(uint64_t* out, size_t count) {
+  return ReadArray(out, count);
+}
+
 BigEndianWriter::BigEndianWriter(char* buf, size_t len)
     : ptr_(buf), end_(ptr_ + len) {}
 
@@ -104,4 +171,25 @@ bool BigEndianWriter::WriteU64(uint64_t value) {
   return Write(value);
 }
 
+template<typename T>
+bool BigEndianWriter::WriteArray(const T* values, size_t count) {
+  if (count > static_cast<size_t>(end_ - ptr_) / sizeof(T))
+    return false;
+  HostToNetBuffer(values, ptr_, count);
+  ptr_ += count * sizeof(T);
+  return true;
+}
+
+bool BigEndianWriter::WriteU16Array(const uint16_t* values, size_t count) {
+  return WriteArray(values, count);
+}
+
+bool BigEndianWriter::WriteU32Array(const uint32_t* values, size_t count) {
+  return WriteArray(values, count);
+}
+
+bool BigEndianWriter::WriteU64Array(const uint64_t* values, size_t count) {
+  return WriteArray(values, count);
+}
+
 }  // namespace base
@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <type_traits>
+
 #include "base/base_export.h"
 #include "base/strings/string_piece.h"
 
@@ -49,6 +51,38 @@ inline void WriteBigEndian<uint8_t>(char buf[], uint8_t val) {
   buf[0] = static_cast<char>(val);
 }
 
+// A zero-copy view of |size()| consecutive big endian integers of type T in an
+// underlying buffer, which must outlive the view. Elements are decoded lazily
+// on access; CopyTo() decodes the whole array at once using the bulk
+// conversions from base/sys_byteorder.h.
+template <typename T>
+class BigEndianArrayView {
+ public:
+  static_assert(std::is_integral<T>::value && std::is_unsigned<T>::value,
+                "BigEndianArrayView is for unsigned integer types");
+
+  BigEndianArrayView() : data_(nullptr), size_(0) {}
+  BigEndianArrayView(const char* data, size_t size)
+      : data_(data), size_(size) {}
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  const char* data() const { return data_; }
+
+  T operator[](size_t i) const {
+    T value;
+    ReadBigEndian<T>(data_ + i * sizeof(T), &value);
+    return value;
+  }
+
+  // Decodes all elements into |out|, which must hold at least size() values.
+  void CopyTo(T* out) const;
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
 // Allows reading integers in network order (big endian) while iterating over
 // an underlying buffer. All the reading functions advance the internal pointer.
 class BASE_EXPORT BigEndianReader {
@@ -67,10 +101,32 @@ class BASE_EXPORT BigEndianReader {
   bool ReadU32(uint32_t* value);
   bool ReadU64(uint64_t* value);
 
+  // Reads |count| consecutive integers into |out|. These convert the whole
+  // array at once and are much faster than calling ReadU16() etc. in a loop.
+  bool ReadU16Array(uint16_t* out, size_t count);
+  bool ReadU32Array(uint32_t* out, size_t count);
+  bool ReadU64Array(uint64_t* out, size_t count);
+
+  // Creates a BigEndianArrayView in |out| that points to |count| integers in
+  // the underlying buffer. Nothing is decoded until the view is accessed.
+  template <typename T>
+  bool ReadArrayView(BigEndianArrayView<T>* out, size_t count) {
+    const char* start = ptr_;
+    if (!SkipArray(sizeof(T), count))
+      return false;
+    *out = BigEndianArrayView<T>(start, count);
+    return true;
+  }
+
  private:
   // Hidden to promote type safety.
   template<typename T>
   bool Read(T* v);
+  template<typename T>
+  bool ReadArray(T* out, size_t count);
+
+  // Skips |count| elements of |element_size| bytes, checking for overflow.
+  bool SkipArray(size_t element_size, size_t count);
 
   const char* ptr_;
   const char* end_;
@@ -92,10 +148,18 @@ class BASE_EXPORT BigEndianWriter {
   bool WriteU32(uint32_t value);
   bool WriteU64(uint64_t value);
 
+  // Writes |count| consecutive integers from |values|, converting the whole
+  // array at once.
+  bool WriteU16Array(const uint16_t* values, size_t count);
+  bool WriteU32Array(const uint32_t* values, size_t count);
+  bool WriteU64Array(const uint64_t* values, size_t count);
+
  private:
   // Hidden to promote type safety.
   template<typename T>
   bool Write(T v);
+  template<typename T>
+  bool WriteArray(const T* values, size_t count);
 
   char* ptr_;
   char* end_;
@@ -11,6 +11,11 @@
 #include <stdint.h>
 
 #include "base/logging.h"
+#include "build/build_config.h"
+
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
 
 namespace base {
 namespace bits {
@@ -49,6 +54,18 @@ inline size_t Align(size_t size, size_t alignment) {
   return (size + alignment - 1) & ~(alignment - 1);
 }
 
+// Returns the number of trailing zero bits in |x|, which must not be zero.
+inline int CountTrailingZeroBits32(uint32_t x) {
+  DCHECK_NE(x, 0u);
+#if defined(COMPILER_MSVC)
+  unsigned long index;
+  _BitScanForward(&index, x);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(x);
+#endif
+}
+
 }  // namespace bits
 }  // namespace base
 
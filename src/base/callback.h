@@ -5,22 +5,24 @@
 #ifndef BASE_CALLBACK_H_
 #define BASE_CALLBACK_H_
 
-#include <memory>
 #include <functional>
 
 #include "base/callback_forward.h"
+#include "base/memory/weak_ptr.h"
 
 namespace base {
 
-class WeakFlag {};
+// The weak flag of a WeakCallback. It shares WeakPtr's slot table, so taking
+// and copying one allocates nothing and touches no reference count.
+typedef internal::WeakReference WeakFlag;
 
 template <typename T>
 class WeakCallback {
  public:
-  WeakCallback(const std::weak_ptr<WeakFlag>& weak_flag, const T& t)
+  WeakCallback(const WeakFlag& weak_flag, const T& t)
       : weak_flag_(weak_flag), t_(t) {}
 
-  WeakCallback(const std::weak_ptr<WeakFlag>& weak_flag, T&& t)
+  WeakCallback(const WeakFlag& weak_flag, T&& t)
       : weak_flag_(weak_flag), t_(std::move(t)) {}
 
   template <class WeakType>
@@ -34,23 +36,27 @@ class WeakCallback {
   //   ->decltype(t_(std::forward<Args>(args)...))
   // #endif
   {
-    if (!weak_flag_.expired()) {
+    if (weak_flag_.is_valid()) {
       return t_(std::forward<Args>(args)...);
     }
     return decltype(t_(std::forward<Args>(args)...))();
   }
 
-  bool Expired() const { return weak_flag_.expired(); }
+  bool Expired() const { return !weak_flag_.is_valid(); }
 
-  std::weak_ptr<WeakFlag> weak_flag_;
+  WeakFlag weak_flag_;
   mutable T t_;
 };
 
 class BASE_EXPORT SupportWeakCallback {
  public:
-  typedef std::weak_ptr<WeakFlag> _TyWeakFlag;
+  typedef WeakFlag _TyWeakFlag;
 
  public:
+  SupportWeakCallback() {}
+  // A copy gets weak callbacks of its own.
+  SupportWeakCallback(const SupportWeakCallback&) {}
+  SupportWeakCallback& operator=(const SupportWeakCallback&) { return *this; }
   virtual ~SupportWeakCallback(){};
 
   template <typename CallbackType>
@@ -59,20 +65,15 @@ class BASE_EXPORT SupportWeakCallback {
     return WeakCallback<CallbackType>(GetWeakFlag(), closure);
   }
 
-  std::weak_ptr<WeakFlag> GetWeakFlag() {
-    if (sp_weak_flag_.use_count() == 0) {
-      sp_weak_flag_.reset((WeakFlag*)NULL);
-    }
-    return sp_weak_flag_;
-  }
+  WeakFlag GetWeakFlag() { return weak_flag_owner_.GetRef(); }
 
  private:
-  template <typename ReturnValue, typename... Param, typename WeakFlag>
+  template <typename ReturnValue, typename... Param>
   static std::function<ReturnValue(Param...)> ConvertToWeakCallback(
       const std::function<ReturnValue(Param...)>& callback,
-      std::weak_ptr<WeakFlag> expiredFlag) {
+      WeakFlag expiredFlag) {
     auto weakCallback = [expiredFlag, callback](Param... p) {
-      if (!expiredFlag.expired()) {
+      if (expiredFlag.is_valid()) {
         return callback(p...);
       }
       return ReturnValue();
@@ -82,7 +83,7 @@ class BASE_EXPORT SupportWeakCallback {
   }
 
  protected:
-  std::shared_ptr<WeakFlag> sp_weak_flag_;
+  internal::WeakReferenceOwner weak_flag_owner_;
 };
 
 // WeakCallbackFlag 一般作为类成员变量使用，要继承，可使用不带 Cancel() 函数的
@@ -94,9 +95,9 @@ class BASE_EXPORT SupportWeakCallback {
 // Callback，一一对应的控制每个支持 Weak 语义的 Callback。
 class BASE_EXPORT WeakCallbackFlag final : public SupportWeakCallback {
  public:
-  void Cancel() { sp_weak_flag_.reset(); }
+  void Cancel() { weak_flag_owner_.Invalidate(); }
 
-  bool HasUsed() { return sp_weak_flag_.use_count() != 0; }
+  bool HasUsed() { return weak_flag_owner_.HasRefs(); }
 };
 
 // global function
@@ -112,7 +113,7 @@ auto Bind(F&& f, Args&&... args) -> decltype(std::bind(f, args...)) {
 template <class R, class C, class... DArgs, class P, class... Args>
 auto Bind(R (C::*f)(DArgs...) const, P&& p, Args&&... args)
     -> WeakCallback<decltype(std::bind(f, p, args...))> {
-  std::weak_ptr<WeakFlag> weak_flag = ((SupportWeakCallback*)p)->GetWeakFlag();
+  WeakFlag weak_flag = ((SupportWeakCallback*)p)->GetWeakFlag();
   auto bind_obj = std::bind(f, p, args...);
   static_assert(std::is_base_of<base::SupportWeakCallback, C>::value,
                 "base::SupportWeakCallback should be base of C");
@@ -125,7 +126,7 @@ auto Bind(R (C::*f)(DArgs...) const, P&& p, Args&&... args)
 template <class R, class C, class... DArgs, class P, class... Args>
 auto Bind(R (C::*f)(DArgs...), P&& p, Args&&... args)
     -> WeakCallback<decltype(std::bind(f, p, args...))> {
-  std::weak_ptr<WeakFlag> weak_flag = ((SupportWeakCallback*)p)->GetWeakFlag();
+  WeakFlag weak_flag = ((SupportWeakCallback*)p)->GetWeakFlag();
   auto bind_obj = std::bind(f, p, args...);
   static_assert(std::is_base_of<base::SupportWeakCallback, C>::value,
                 "base::SupportWeakCallback should be base of C");
@@ -402,7 +402,7 @@ void CommandLine::PrependWrapper(const CommandLine::StringType& wrapper) {
     return;
   // The wrapper may have embedded arguments (like "gdb --args"). In this case,
   // we don't pretend to do anything fancy, we just split on spaces.
-  StringVector wrapper_argv = SplitString(
+  std::vector<StringType> wrapper_argv = SplitString(
       wrapper, FilePath::StringType(1, ' '), base::TRIM_WHITESPACE,
       base::SPLIT_WANT_ALL);
   // Prepend the wrapper and update the switches/arguments |begin_args_|.
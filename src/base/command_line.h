@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "base/base_export.h"
+#include "base/containers/small_vector.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
 #include "build/build_config.h"
@@ -39,7 +40,8 @@ class BASE_EXPORT CommandLine {
 #endif
 
   typedef StringType::value_type CharType;
-  typedef std::vector<StringType> StringVector;
+  // Command lines are short, so argv normally lives inline.
+  typedef SmallVector<StringType, 8> StringVector;
   typedef std::map<std::string, StringType> SwitchMap;
   typedef std::map<base::StringPiece, const StringType*> StringPieceSwitchMap;
 
@@ -0,0 +1,584 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// FlatHashMap and FlatHashSet are open-addressing hash containers modeled on
+// the SwissTable design. All elements live in one contiguous array next to a
+// parallel array of one-byte control words; lookups compare 16 control bytes
+// at a time (with SSE2 where available), so a typical miss or hit touches one
+// or two cache lines instead of chasing list or tree nodes.
+//
+// They are good replacements for std::map and std::unordered_map when the
+// iteration order does not matter. Differences from the standard containers:
+//
+//   - Inserting or erasing may move elements, so any insertion invalidates
+//     all iterators, pointers and references into the container.
+//   - erase(iterator) returns void.
+//   - Keys are hashed with base::FlatHash<Key> by default, which uses
+//     base::Hash() for strings. Supply your own functor for other key types.
+//
+// For small maps that are read much more often than they are written, also
+// consider base::flat_map in base/containers/flat_map.h.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/hash.h"
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "build/build_config.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BASE_FLAT_HASH_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace base {
+
+// Default hash functor for FlatHashMap and FlatHashSet. The tables mix the
+// result again before use, so the value does not need to be well distributed.
+template <typename T, typename Enable = void>
+struct FlatHash;
+
+template <typename T>
+struct FlatHash<T,
+                typename std::enable_if<std::is_integral<T>::value ||
+                                        std::is_enum<T>::value>::type> {
+  size_t operator()(T value) const { return static_cast<size_t>(value); }
+};
+
+template <typename T>
+struct FlatHash<T*> {
+  size_t operator()(const T* value) const {
+    return reinterpret_cast<uintptr_t>(value);
+  }
+};
+
+template <>
+struct FlatHash<std::string> {
+  size_t operator()(const std::string& value) const { return Hash(value); }
+};
+
+template <>
+struct FlatHash<StringPiece> {
+  size_t operator()(const StringPiece& value) const {
+    return Hash(value.data(), value.size());
+  }
+};
+
+namespace internal {
+
+// Control bytes. Full slots hold the low 7 bits of the hash (H2), so they are
+// never negative.
+typedef int8_t FlatHashCtrl;
+const FlatHashCtrl kFlatHashEmpty = -128;
+const FlatHashCtrl kFlatHashDeleted = -2;
+const size_t kFlatHashGroupWidth = 16;
+
+// Returns kFlatHashGroupWidth empty control bytes, used by tables that have
+// not allocated yet so that lookups need no special case.
+inline const FlatHashCtrl* FlatHashEmptyGroup() {
+  alignas(16) static const FlatHashCtrl kEmptyGroup[kFlatHashGroupWidth] = {
+      kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty,
+      kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty, kFlatHashEmpty};
+  return kEmptyGroup;
+}
+
+// A view of kFlatHashGroupWidth consecutive control bytes. The Match*()
+// methods return a bit mask with bit i set if byte i matches.
+class FlatHashGroup {
+ public:
+  explicit FlatHashGroup(const FlatHashCtrl* ctrl) {
+#if defined(BASE_FLAT_HASH_USE_SSE2)
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    memcpy(ctrl_, ctrl, sizeof(ctrl_));
+#endif
+  }
+
+  uint32_t Match(FlatHashCtrl h2) const {
+#if defined(BASE_FLAT_HASH_USE_SSE2)
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kFlatHashGroupWidth; ++i)
+      mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+    return mask;
+#endif
+  }
+
+  uint32_t MatchEmpty() const { return Match(kFlatHashEmpty); }
+
+  // Empty and deleted bytes are the only negative ones.
+  uint32_t MatchEmptyOrDeleted() const {
+#if defined(BASE_FLAT_HASH_USE_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kFlatHashGroupWidth; ++i)
+      mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(BASE_FLAT_HASH_USE_SSE2)
+  __m128i ctrl_;
+#else
+  FlatHashCtrl ctrl_[kFlatHashGroupWidth];
+#endif
+};
+
+struct FlatHashIdentity {
+  template <typename T>
+  const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+struct FlatHashSelectFirst {
+  template <typename T>
+  const typename T::first_type& operator()(const T& value) const {
+    return value.first;
+  }
+};
+
+// The table shared by FlatHashMap and FlatHashSet. |Value| is the stored
+// element type and |KeyOf| extracts the key from it.
+template <typename Key,
+          typename Value,
+          typename KeyOf,
+          typename HashFn,
+          typename KeyEqual>
+class FlatHashTable {
+ public:
+  typedef Key key_type;
+  typedef Value value_type;
+  typedef size_t size_type;
+  typedef HashFn hasher;
+  typedef KeyEqual key_equal;
+
+  template <typename V>
+  class Iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<V>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef V* pointer;
+    typedef V& reference;
+
+    Iterator() : ctrl_(nullptr), end_(nullptr), slot_(nullptr) {}
+
+    // Allows conversion from iterator to const_iterator.
+    template <typename U,
+              typename = typename std::enable_if<
+                  std::is_convertible<U*, V*>::value>::type>
+    Iterator(const Iterator<U>& other)
+        : ctrl_(other.ctrl_), end_(other.end_), slot_(other.slot_) {}
+
+    V& operator*() const { return *slot_; }
+    V* operator->() const { return slot_; }
+
+    Iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++*this;
+      return result;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return slot_ == other.slot_;
+    }
+    bool operator!=(const Iterator& other) const {
+      return slot_ != other.slot_;
+    }
+
+   private:
+    friend class FlatHashTable;
+    template <typename U>
+    friend class Iterator;
+
+    Iterator(const FlatHashCtrl* ctrl, const FlatHashCtrl* end, V* slot)
+        : ctrl_(ctrl), end_(end), slot_(slot) {}
+
+    void SkipEmptyOrDeleted() {
+      while (ctrl_ != end_ && *ctrl_ < 0) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    const FlatHashCtrl* ctrl_;
+    const FlatHashCtrl* end_;
+    V* slot_;
+  };
+
+  // A set's elements are their own keys, so like std::unordered_set it only
+  // hands them out as const.
+  typedef Iterator<typename std::conditional<std::is_same<Key, Value>::value,
+                                             const Value,
+                                             Value>::type>
+      iterator;
+  typedef Iterator<const Value> const_iterator;
+
+  FlatHashTable()
+      : ctrl_(const_cast<FlatHashCtrl*>(FlatHashEmptyGroup())),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        growth_left_(0) {}
+
+  FlatHashTable(const FlatHashTable& other) : FlatHashTable() {
+    reserve(other.size());
+    for (const Value& value : other)
+      insert(value);
+  }
+
+  FlatHashTable(FlatHashTable&& other) : FlatHashTable() { swap(other); }
+
+  ~FlatHashTable() { DestroyAndFree(); }
+
+  FlatHashTable& operator=(const FlatHashTable& other) {
+    if (this != &other) {
+      FlatHashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashTable& operator=(FlatHashTable&& other) {
+    FlatHashTable moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  iterator begin() {
+    iterator it(ctrl_, ctrl_ + capacity_, slots_);
+    it.SkipEmptyOrDeleted();
+    return it;
+  }
+  iterator end() {
+    return iterator(ctrl_ + capacity_, ctrl_ + capacity_, slots_ + capacity_);
+  }
+  const_iterator begin() const {
+    return const_cast<FlatHashTable*>(this)->begin();
+  }
+  const_iterator end() const {
+    return const_cast<FlatHashTable*>(this)->end();
+  }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  void clear() {
+    if (!capacity_)
+      return;
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0)
+        slots_[i].~Value();
+    }
+    ResetCtrl();
+    size_ = 0;
+    growth_left_ = MaxLoad(capacity_);
+  }
+
+  // Makes room for at least |count| elements without rehashing.
+  void reserve(size_t count) {
+    if (count <= size_ + growth_left_)
+      return;
+    size_t capacity = kFlatHashGroupWidth;
+    while (MaxLoad(capacity) < count)
+      capacity *= 2;
+    Resize(capacity);
+  }
+
+  std::pair<iterator, bool> insert(const Value& value) {
+    std::pair<size_t, bool> result = FindOrPrepareInsert(KeyOf()(value));
+    if (result.second)
+      new (slots_ + result.first) Value(value);
+    return std::make_pair(IteratorAt(result.first), result.second);
+  }
+
+  std::pair<iterator, bool> insert(Value&& value) {
+    std::pair<size_t, bool> result = FindOrPrepareInsert(KeyOf()(value));
+    if (result.second)
+      new (slots_ + result.first) Value(std::move(value));
+    return std::make_pair(IteratorAt(result.first), result.second);
+  }
+
+  template <typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  // Constructs a value from |args| and inserts it unless an element with the
+  // same key is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(Value(std::forward<Args>(args)...));
+  }
+
+  iterator find(const Key& key) {
+    size_t index = FindIndex(key);
+    return index == kNotFound ? end() : IteratorAt(index);
+  }
+  const_iterator find(const Key& key) const {
+    return const_cast<FlatHashTable*>(this)->find(key);
+  }
+
+  size_t count(const Key& key) const { return FindIndex(key) != kNotFound; }
+
+  void erase(const_iterator it) {
+    DCHECK(it != end());
+    EraseAt(static_cast<size_t>(it.slot_ - slots_));
+  }
+
+  size_t erase(const Key& key) {
+    size_t index = FindIndex(key);
+    if (index == kNotFound)
+      return 0;
+    EraseAt(index);
+    return 1;
+  }
+
+  void swap(FlatHashTable& other) {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+  }
+
+ protected:
+  static const size_t kNotFound = static_cast<size_t>(-1);
+
+  // Returns the index of the element with |key|, adding a control byte for it
+  // if it is missing. The second member is true if the caller must construct
+  // the element in slots_[index].
+  std::pair<size_t, bool> FindOrPrepareInsert(const Key& key) {
+    const uint64_t hash = MixHash(key);
+    size_t index = FindIndex(key, hash);
+    if (index != kNotFound)
+      return std::make_pair(index, false);
+    if (!growth_left_)
+      Grow();
+    index = FindFirstNonFull(hash);
+    if (ctrl_[index] == kFlatHashEmpty)
+      --growth_left_;
+    SetCtrl(index, H2(hash));
+    ++size_;
+    return std::make_pair(index, true);
+  }
+
+  iterator IteratorAt(size_t index) {
+    return iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index);
+  }
+
+  Value* slot(size_t index) { return slots_ + index; }
+
+ private:
+  // Mixes the user hash so that both the probe position (low bits) and the
+  // control byte (top bits) are well distributed even for identity hashes.
+  uint64_t MixHash(const Key& key) const {
+    uint64_t h = static_cast<uint64_t>(HashFn()(key)) * 0x9e3779b97f4a7c15ull;
+    return h ^ (h >> 32);
+  }
+  static size_t H1(uint64_t hash) { return static_cast<size_t>(hash); }
+  static FlatHashCtrl H2(uint64_t hash) {
+    return static_cast<FlatHashCtrl>(hash >> 57);
+  }
+
+  static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+  size_t FindIndex(const Key& key) const { return FindIndex(key, MixHash(key)); }
+
+  size_t FindIndex(const Key& key, uint64_t hash) const {
+    if (!capacity_)
+      return kNotFound;
+    const size_t mask = capacity_ - 1;
+    size_t pos = H1(hash) & mask;
+    size_t step = 0;
+    while (true) {
+      FlatHashGroup group(ctrl_ + pos);
+      for (uint32_t match = group.Match(H2(hash)); match;
+           match &= match - 1) {
+        size_t index = (pos + bits::CountTrailingZeroBits32(match)) & mask;
+        if (KeyEqual()(KeyOf()(slots_[index]), key))
+          return index;
+      }
+      if (group.MatchEmpty())
+        return kNotFound;
+      // Triangular probing over groups visits every group of a power-of-two
+      // table exactly once.
+      step += kFlatHashGroupWidth;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  size_t FindFirstNonFull(uint64_t hash) const {
+    const size_t mask = capacity_ - 1;
+    size_t pos = H1(hash) & mask;
+    size_t step = 0;
+    while (true) {
+      uint32_t free = FlatHashGroup(ctrl_ + pos).MatchEmptyOrDeleted();
+      if (free)
+        return (pos + bits::CountTrailingZeroBits32(free)) & mask;
+      step += kFlatHashGroupWidth;
+      pos = (pos + step) & mask;
+    }
+  }
+
+  // The first kFlatHashGroupWidth control bytes are mirrored after the end of
+  // the array so that a group can be loaded at any position.
+  void SetCtrl(size_t index, FlatHashCtrl value) {
+    ctrl_[index] = value;
+    if (index < kFlatHashGroupWidth)
+      ctrl_[capacity_ + index] = value;
+  }
+
+  void ResetCtrl() {
+    memset(ctrl_, kFlatHashEmpty, capacity_ + kFlatHashGroupWidth);
+  }
+
+  void EraseAt(size_t index) {
+    slots_[index].~Value();
+    // Leave a tombstone so that probes for other keys continue past this slot.
+    SetCtrl(index, kFlatHashDeleted);
+    --size_;
+  }
+
+  void Grow() {
+    if (!capacity_) {
+      Resize(kFlatHashGroupWidth);
+    } else if (size_ <= MaxLoad(capacity_) / 2) {
+      // Mostly tombstones; rehashing in place reclaims them.
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ * 2);
+    }
+  }
+
+  static size_t SlotOffset(size_t capacity) {
+    return bits::Align(capacity + kFlatHashGroupWidth, ALIGNOF(Value));
+  }
+
+  void Resize(size_t new_capacity) {
+    DCHECK_EQ(new_capacity & (new_capacity - 1), 0u);
+    DCHECK_GE(new_capacity, kFlatHashGroupWidth);
+    FlatHashCtrl* old_ctrl = ctrl_;
+    Value* old_slots = slots_;
+    const size_t old_capacity = capacity_;
+
+    char* memory = static_cast<char*>(::operator new(
+        SlotOffset(new_capacity) + new_capacity * sizeof(Value)));
+    ctrl_ = reinterpret_cast<FlatHashCtrl*>(memory);
+    slots_ = reinterpret_cast<Value*>(memory + SlotOffset(new_capacity));
+    capacity_ = new_capacity;
+    ResetCtrl();
+    growth_left_ = MaxLoad(new_capacity) - size_;
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] < 0)
+        continue;
+      const uint64_t hash = MixHash(KeyOf()(old_slots[i]));
+      const size_t index = FindFirstNonFull(hash);
+      SetCtrl(index, H2(hash));
+      new (slots_ + index) Value(std::move(old_slots[i]));
+      old_slots[i].~Value();
+    }
+    if (old_capacity)
+      ::operator delete(old_ctrl);
+  }
+
+  void DestroyAndFree() {
+    if (!capacity_)
+      return;
+    for (size_t i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0)
+        slots_[i].~Value();
+    }
+    ::operator delete(ctrl_);
+  }
+
+  FlatHashCtrl* ctrl_;
+  Value* slots_;
+  size_t capacity_;  // Zero or a power of two no smaller than a group.
+  size_t size_;
+  // Number of empty slots that may still be filled before growing.
+  size_t growth_left_;
+};
+
+}  // namespace internal
+
+template <typename Key,
+          typename HashFn = FlatHash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public internal::FlatHashTable<Key,
+                                                   Key,
+                                                   internal::FlatHashIdentity,
+                                                   HashFn,
+                                                   KeyEqual> {};
+
+template <typename Key,
+          typename Mapped,
+          typename HashFn = FlatHash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+    : public internal::FlatHashTable<Key,
+                                     std::pair<const Key, Mapped>,
+                                     internal::FlatHashSelectFirst,
+                                     HashFn,
+                                     KeyEqual> {
+ public:
+  typedef Mapped mapped_type;
+
+  Mapped& operator[](const Key& key) {
+    std::pair<size_t, bool> result = this->FindOrPrepareInsert(key);
+    if (result.second) {
+      new (this->slot(result.first)) typename FlatHashMap::value_type(
+          std::piecewise_construct, std::forward_as_tuple(key),
+          std::tuple<>());
+    }
+    return this->slot(result.first)->second;
+  }
+
+  Mapped& operator[](Key&& key) {
+    std::pair<size_t, bool> result = this->FindOrPrepareInsert(key);
+    if (result.second) {
+      new (this->slot(result.first)) typename FlatHashMap::value_type(
+          std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+          std::tuple<>());
+    }
+    return this->slot(result.first)->second;
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
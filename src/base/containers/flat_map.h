@@ -0,0 +1,168 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_MAP_H_
+#define BASE_CONTAINERS_FLAT_MAP_H_
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace base {
+
+// flat_map is an ordered map backed by a sorted std::vector of key/value
+// pairs. Lookups are a binary search over contiguous memory, and iteration is
+// a linear scan, which makes it faster and much smaller than std::map for
+// small or read-mostly maps. Insertions and erasures in the middle are O(n),
+// so prefer building the contents up front with the vector constructor and
+// avoid it for large maps that change often (see FlatHashMap instead).
+//
+// Like std::vector, any insertion or erasure invalidates iterators and
+// references. Unlike std::map, value_type is std::pair<Key, Mapped>; do not
+// modify keys through iterators.
+template <typename Key, typename Mapped, typename Compare = std::less<Key>>
+class flat_map {
+ public:
+  typedef Key key_type;
+  typedef Mapped mapped_type;
+  typedef std::pair<Key, Mapped> value_type;
+  typedef Compare key_compare;
+  typedef std::vector<value_type> underlying_type;
+  typedef typename underlying_type::size_type size_type;
+  typedef typename underlying_type::iterator iterator;
+  typedef typename underlying_type::const_iterator const_iterator;
+  typedef typename underlying_type::reverse_iterator reverse_iterator;
+  typedef typename underlying_type::const_reverse_iterator
+      const_reverse_iterator;
+
+  flat_map() {}
+
+  // Takes ownership of |items|, sorting them by key. When keys repeat, the
+  // first occurrence wins, as if the items had been inserted in order.
+  explicit flat_map(underlying_type items) : items_(std::move(items)) {
+    SortAndUnique();
+  }
+
+  template <typename InputIterator>
+  flat_map(InputIterator first, InputIterator last) : items_(first, last) {
+    SortAndUnique();
+  }
+
+  iterator begin() { return items_.begin(); }
+  iterator end() { return items_.end(); }
+  const_iterator begin() const { return items_.begin(); }
+  const_iterator end() const { return items_.end(); }
+  const_iterator cbegin() const { return items_.cbegin(); }
+  const_iterator cend() const { return items_.cend(); }
+  reverse_iterator rbegin() { return items_.rbegin(); }
+  reverse_iterator rend() { return items_.rend(); }
+  const_reverse_iterator rbegin() const { return items_.rbegin(); }
+  const_reverse_iterator rend() const { return items_.rend(); }
+
+  bool empty() const { return items_.empty(); }
+  size_type size() const { return items_.size(); }
+  size_type capacity() const { return items_.capacity(); }
+  void reserve(size_type count) { items_.reserve(count); }
+  void shrink_to_fit() { items_.shrink_to_fit(); }
+  void clear() { items_.clear(); }
+
+  key_compare key_comp() const { return key_compare(); }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+  iterator upper_bound(const Key& key) {
+    return std::upper_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+  const_iterator upper_bound(const Key& key) const {
+    return std::upper_bound(items_.begin(), items_.end(), key, KeyLess());
+  }
+
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    return (it != end() && !Compare()(key, it->first)) ? it : end();
+  }
+  const_iterator find(const Key& key) const {
+    const_iterator it = lower_bound(key);
+    return (it != end() && !Compare()(key, it->first)) ? it : end();
+  }
+
+  size_type count(const Key& key) const { return find(key) != end(); }
+
+  Mapped& operator[](const Key& key) {
+    iterator it = lower_bound(key);
+    if (it == end() || Compare()(key, it->first))
+      it = items_.insert(it, value_type(key, Mapped()));
+    return it->second;
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert(value_type(value));
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    iterator it = lower_bound(value.first);
+    if (it != end() && !Compare()(value.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(items_.insert(it, std::move(value)), true);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  iterator erase(const_iterator position) { return items_.erase(position); }
+  iterator erase(const_iterator first, const_iterator last) {
+    return items_.erase(first, last);
+  }
+  size_type erase(const Key& key) {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    items_.erase(it);
+    return 1;
+  }
+
+  void swap(flat_map& other) { items_.swap(other.items_); }
+
+  bool operator==(const flat_map& other) const {
+    return items_ == other.items_;
+  }
+  bool operator!=(const flat_map& other) const { return !(*this == other); }
+
+ private:
+  struct KeyLess {
+    bool operator()(const value_type& lhs, const Key& rhs) const {
+      return Compare()(lhs.first, rhs);
+    }
+    bool operator()(const Key& lhs, const value_type& rhs) const {
+      return Compare()(lhs, rhs.first);
+    }
+  };
+
+  void SortAndUnique() {
+    std::stable_sort(items_.begin(), items_.end(),
+                     [](const value_type& lhs, const value_type& rhs) {
+                       return Compare()(lhs.first, rhs.first);
+                     });
+    items_.erase(std::unique(items_.begin(), items_.end(),
+                             [](const value_type& lhs, const value_type& rhs) {
+                               return !Compare()(lhs.first, rhs.first);
+                             }),
+                 items_.end());
+  }
+
+  underlying_type items_;
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_MAP_H_
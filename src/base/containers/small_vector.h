@@ -0,0 +1,518 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_SMALL_VECTOR_H_
+#define BASE_CONTAINERS_SMALL_VECTOR_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+
+namespace base {
+
+// Whether a T can be moved to another address with memcpy(), leaving the
+// source as raw memory that is not destroyed. True for trivially copyable
+// types. Specialize it for other types whose objects never point into
+// themselves, such as smart pointers:
+//
+//   template <typename T>
+//   struct IsTriviallyRelocatable<scoped_refptr<T>> : std::true_type {};
+//
+// Never specialize it for std::string: libstdc++ strings point at their own
+// inline buffer.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// SmallVector is a std::vector work-alike that keeps its first |N| elements
+// inside the object, so small vectors never touch the heap. Past |N| it moves
+// to a heap buffer that grows by half its size each time, like std::vector
+// with a gentler factor, which lets a growing vector reuse the blocks it
+// freed earlier.
+//
+// Use it for local or member vectors that are usually short, such as split
+// results or observer lists:
+//
+//   SmallVector<StringPiece, 8> fields;
+//   SplitStringPiece(line, ",", TRIM_WHITESPACE, SPLIT_WANT_ALL, &fields);
+//
+// Differences from std::vector:
+//  - Iterators are raw pointers.
+//  - Moving a vector that uses its inline storage moves each element, so
+//    the move is O(N) and the source's iterators do not carry over.
+//  - Elements that are IsTriviallyRelocatable are moved with memcpy() when
+//    the vector grows or is moved.
+//  - Over-aligned types (beyond alignof(max_align_t)) are not supported on
+//    the heap.
+template <typename T, size_t N>
+class SmallVector {
+ public:
+  static_assert(N > 0, "SmallVector needs inline capacity");
+
+  typedef T value_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  SmallVector() : data_(inline_data()), size_(0), capacity_(N) {}
+
+  explicit SmallVector(size_type count) : SmallVector() { resize(count); }
+
+  SmallVector(size_type count, const T& value) : SmallVector() {
+    assign(count, value);
+  }
+
+  template <typename InputIterator,
+            typename = typename std::enable_if<
+                !std::is_integral<InputIterator>::value>::type>
+  SmallVector(InputIterator first, InputIterator last) : SmallVector() {
+    assign(first, last);
+  }
+
+  SmallVector(std::initializer_list<T> values) : SmallVector() {
+    assign(values.begin(), values.end());
+  }
+
+  SmallVector(const SmallVector& other) : SmallVector() {
+    assign(other.begin(), other.end());
+  }
+
+  SmallVector(SmallVector&& other) noexcept(
+      IsTriviallyRelocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value)
+      : SmallVector() {
+    TakeFrom(&other);
+  }
+
+  ~SmallVector() {
+    DestroyRange(begin(), end());
+    FreeHeapBuffer();
+  }
+
+  SmallVector& operator=(const SmallVector& other) {
+    if (this != &other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(
+      IsTriviallyRelocatable<T>::value ||
+      std::is_nothrow_move_constructible<T>::value) {
+    if (this != &other) {
+      clear();
+      FreeHeapBuffer();
+      data_ = inline_data();
+      capacity_ = N;
+      TakeFrom(&other);
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(std::initializer_list<T> values) {
+    assign(values.begin(), values.end());
+    return *this;
+  }
+
+  void assign(size_type count, const T& value) {
+    // |value| may live in this vector, so copy it before clearing.
+    T copy(value);
+    clear();
+    if (count > capacity_)
+      Reallocate(count);
+    std::uninitialized_fill_n(data_, count, copy);
+    size_ = count;
+  }
+
+  template <typename InputIterator,
+            typename = typename std::enable_if<
+                !std::is_integral<InputIterator>::value>::type>
+  void assign(InputIterator first, InputIterator last) {
+    clear();
+    AppendRange(first, last, IteratorCategory<InputIterator>());
+  }
+
+  void assign(std::initializer_list<T> values) {
+    assign(values.begin(), values.end());
+  }
+
+  // Element access.
+  reference at(size_type index) {
+    CHECK_LT(index, size_);
+    return data_[index];
+  }
+  const_reference at(size_type index) const {
+    CHECK_LT(index, size_);
+    return data_[index];
+  }
+  reference operator[](size_type index) {
+    DCHECK_LT(index, size_);
+    return data_[index];
+  }
+  const_reference operator[](size_type index) const {
+    DCHECK_LT(index, size_);
+    return data_[index];
+  }
+  reference front() { return (*this)[0]; }
+  const_reference front() const { return (*this)[0]; }
+  reference back() { return (*this)[size_ - 1]; }
+  const_reference back() const { return (*this)[size_ - 1]; }
+  T* data() { return data_; }
+  const T* data() const { return data_; }
+
+  // Iterators.
+  iterator begin() { return data_; }
+  iterator end() { return data_ + size_; }
+  const_iterator begin() const { return data_; }
+  const_iterator end() const { return data_ + size_; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+  const_reverse_iterator crbegin() const { return rbegin(); }
+  const_reverse_iterator crend() const { return rend(); }
+
+  // Capacity.
+  bool empty() const { return size_ == 0; }
+  size_type size() const { return size_; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+  size_type capacity() const { return capacity_; }
+  static constexpr size_type inline_capacity() { return N; }
+
+  // Whether the elements are in the inline buffer rather than on the heap.
+  bool using_inline_storage() const { return data_ == inline_data(); }
+
+  void reserve(size_type new_capacity) {
+    if (new_capacity > capacity_)
+      Reallocate(new_capacity);
+  }
+
+  // Moves the elements back inline if they fit, else to a heap buffer of
+  // exactly size() elements.
+  void shrink_to_fit() {
+    if (!using_inline_storage() && size_ < capacity_)
+      Reallocate(size_);
+  }
+
+  // Modifiers.
+  void clear() {
+    DestroyRange(begin(), end());
+    size_ = 0;
+  }
+
+  iterator insert(const_iterator position, const T& value) {
+    return emplace(position, value);
+  }
+
+  iterator insert(const_iterator position, T&& value) {
+    return emplace(position, std::move(value));
+  }
+
+  iterator insert(const_iterator position, size_type count, const T& value) {
+    size_type index = position - begin();
+    DCHECK_LE(index, size_);
+    if (count == 0)
+      return begin() + index;
+    T copy(value);
+    if (size_ + count > capacity_)
+      Reallocate(GrownCapacity(size_ + count));
+    std::uninitialized_fill_n(end(), count, copy);
+    size_ += count;
+    RotateIntoPlace(index, count);
+    return begin() + index;
+  }
+
+  template <typename InputIterator,
+            typename = typename std::enable_if<
+                !std::is_integral<InputIterator>::value>::type>
+  iterator insert(const_iterator position,
+                  InputIterator first,
+                  InputIterator last) {
+    size_type index = position - begin();
+    DCHECK_LE(index, size_);
+    size_type old_size = size_;
+    AppendRange(first, last, IteratorCategory<InputIterator>());
+    RotateIntoPlace(index, size_ - old_size);
+    return begin() + index;
+  }
+
+  iterator insert(const_iterator position, std::initializer_list<T> values) {
+    return insert(position, values.begin(), values.end());
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args&&... args) {
+    size_type index = position - begin();
+    DCHECK_LE(index, size_);
+    emplace_back(std::forward<Args>(args)...);
+    RotateIntoPlace(index, 1);
+    return begin() + index;
+  }
+
+  iterator erase(const_iterator position) {
+    return erase(position, position + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    iterator first_it = begin() + (first - cbegin());
+    iterator last_it = begin() + (last - cbegin());
+    DCHECK(begin() <= first_it && first_it <= last_it && last_it <= end());
+    if (first_it != last_it) {
+      iterator new_end = std::move(last_it, end(), first_it);
+      DestroyRange(new_end, end());
+      size_ = new_end - begin();
+    }
+    return first_it;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args&&... args) {
+    if (UNLIKELY(size_ == capacity_))
+      return GrowAndEmplaceBack(std::forward<Args>(args)...);
+    T* element = new (data_ + size_) T(std::forward<Args>(args)...);
+    ++size_;
+    return *element;
+  }
+
+  void pop_back() {
+    DCHECK(!empty());
+    --size_;
+    data_[size_].~T();
+  }
+
+  void resize(size_type count) {
+    if (count < size_) {
+      erase(begin() + count, end());
+      return;
+    }
+    reserve(count);
+    for (; size_ < count; ++size_)
+      new (data_ + size_) T();
+  }
+
+  void resize(size_type count, const T& value) {
+    if (count < size_)
+      erase(begin() + count, end());
+    else
+      insert(end(), count - size_, value);
+  }
+
+  void swap(SmallVector& other) {
+    if (!using_inline_storage() && !other.using_inline_storage()) {
+      std::swap(data_, other.data_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+      return;
+    }
+    SmallVector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+  }
+
+ private:
+  template <typename Iterator>
+  using IteratorCategory =
+      typename std::iterator_traits<Iterator>::iterator_category;
+
+  T* inline_data() { return reinterpret_cast<T*>(inline_buffer_); }
+  const T* inline_data() const {
+    return reinterpret_cast<const T*>(inline_buffer_);
+  }
+
+  static void DestroyRange(T* first, T* last) {
+    if (std::is_trivially_destructible<T>::value)
+      return;
+    for (; first != last; ++first)
+      first->~T();
+  }
+
+  // Moves |count| elements from |from| to uninitialized memory at |to| and
+  // ends their lifetime at |from|.
+  static void Relocate(T* from, size_type count, T* to) {
+    if (IsTriviallyRelocatable<T>::value) {
+      if (count)
+        memcpy(static_cast<void*>(to), static_cast<const void*>(from),
+               count * sizeof(T));
+      return;
+    }
+    for (size_type i = 0; i < count; ++i) {
+      new (to + i) T(std::move(from[i]));
+      from[i].~T();
+    }
+  }
+
+  // The capacity to grow to when |required| elements do not fit.
+  size_type GrownCapacity(size_type required) const {
+    CHECK_LE(required, max_size());
+    size_type grown = capacity_ + capacity_ / 2 + 1;
+    if (grown > max_size() || grown < required)
+      grown = required;
+    return grown;
+  }
+
+  void FreeHeapBuffer() {
+    if (!using_inline_storage())
+      ::operator delete(data_);
+  }
+
+  // Moves the elements to a buffer of |new_capacity|, which is inline if it
+  // fits there.
+  void Reallocate(size_type new_capacity) {
+    DCHECK_GE(new_capacity, size_);
+    T* new_data;
+    if (new_capacity <= N) {
+      if (using_inline_storage())
+        return;
+      new_data = inline_data();
+      new_capacity = N;
+    } else {
+      CHECK_LE(new_capacity, max_size());
+      new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+    }
+    Relocate(data_, size_, new_data);
+    FreeHeapBuffer();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  template <typename... Args>
+  NOINLINE reference GrowAndEmplaceBack(Args&&... args) {
+    size_type new_capacity = GrownCapacity(size_ + 1);
+    T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+    // Construct first: |args| may refer to an element of this vector.
+    T* element = new (new_data + size_) T(std::forward<Args>(args)...);
+    Relocate(data_, size_, new_data);
+    FreeHeapBuffer();
+    data_ = new_data;
+    capacity_ = new_capacity;
+    ++size_;
+    return *element;
+  }
+
+  // Moves the last |count| elements to |index|, shifting the ones after
+  // |index| up.
+  void RotateIntoPlace(size_type index, size_type count) {
+    size_type tail = size_ - count - index;
+    if (count == 0 || tail == 0)
+      return;
+    std::rotate(begin() + index, end() - count, end());
+  }
+
+  template <typename InputIterator>
+  void AppendRange(InputIterator first,
+                   InputIterator last,
+                   std::input_iterator_tag) {
+    for (; first != last; ++first)
+      emplace_back(*first);
+  }
+
+  template <typename ForwardIterator>
+  void AppendRange(ForwardIterator first,
+                   ForwardIterator last,
+                   std::forward_iterator_tag) {
+    size_type count = std::distance(first, last);
+    if (size_ + count > capacity_) {
+      // Copy before moving: the range may be part of this vector.
+      size_type new_capacity = GrownCapacity(size_ + count);
+      T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+      std::uninitialized_copy(first, last, new_data + size_);
+      Relocate(data_, size_, new_data);
+      FreeHeapBuffer();
+      data_ = new_data;
+      capacity_ = new_capacity;
+      size_ += count;
+      return;
+    }
+    std::uninitialized_copy(first, last, end());
+    size_ += count;
+  }
+
+  // Takes the elements of |other|, which is left empty. This vector must be
+  // empty and inline.
+  void TakeFrom(SmallVector* other) {
+    if (!other->using_inline_storage()) {
+      data_ = other->data_;
+      capacity_ = other->capacity_;
+      size_ = other->size_;
+      other->data_ = other->inline_data();
+      other->capacity_ = N;
+      other->size_ = 0;
+      return;
+    }
+    Relocate(other->data_, other->size_, data_);
+    size_ = other->size_;
+    other->size_ = 0;
+  }
+
+  T* data_;
+  size_type size_;
+  size_type capacity_;
+  alignas(T) unsigned char inline_buffer_[sizeof(T) * N];
+};
+
+template <typename T, size_t N>
+bool operator==(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+template <typename T, size_t N>
+bool operator!=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return !(a == b);
+}
+
+template <typename T, size_t N>
+bool operator<(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <typename T, size_t N>
+bool operator>(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return b < a;
+}
+
+template <typename T, size_t N>
+bool operator<=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return !(b < a);
+}
+
+template <typename T, size_t N>
+bool operator>=(const SmallVector<T, N>& a, const SmallVector<T, N>& b) {
+  return !(a < b);
+}
+
+template <typename T, size_t N>
+void swap(SmallVector<T, N>& a, SmallVector<T, N>& b) {
+  a.swap(b);
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_SMALL_VECTOR_H_
@@ -224,6 +224,9 @@ class StackString16 : public StackContainer<
 
 // StackVector -----------------------------------------------------------------
 
+// New code should use SmallVector (base/containers/small_vector.h), which is
+// movable and does not depend on a separate stack buffer.
+//
 // Example:
 //   StackVector<int, 16> foo;
 //   foo->push_back(22);  // we have overloaded operator->
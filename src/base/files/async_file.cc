@@ -0,0 +1,258 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+
+namespace base {
+
+namespace {
+
+// Runs blocking File reads and writes on a few threads.
+class ThreadPoolBackend : public internal::AsyncFileBackend,
+                          public DelegateSimpleThread::Delegate {
+ public:
+  ThreadPoolBackend(File* file, int num_threads)
+      : file_(file),
+        work_available_(&lock_),
+        work_done_(&lock_),
+        shutting_down_(false) {
+    DCHECK_GT(num_threads, 0);
+    for (int i = 0; i < num_threads; ++i) {
+      threads_.push_back(std::unique_ptr<DelegateSimpleThread>(
+          new DelegateSimpleThread(this, "AsyncFile")));
+      threads_.back()->Start();
+    }
+  }
+
+  ~ThreadPoolBackend() override {
+    {
+      AutoLock lock(lock_);
+      shutting_down_ = true;
+      work_available_.Broadcast();
+    }
+    for (const std::unique_ptr<DelegateSimpleThread>& thread : threads_)
+      thread->Join();
+  }
+
+  // internal::AsyncFileBackend:
+  void Queue(int slot,
+             const internal::AsyncFileOperation& operation) override {
+    queued_.push_back(std::make_pair(slot, operation));
+  }
+
+  void Submit() override {
+    if (queued_.empty())
+      return;
+    AutoLock lock(lock_);
+    pending_.insert(pending_.end(), queued_.begin(), queued_.end());
+    queued_.clear();
+    work_available_.Broadcast();
+  }
+
+  void Reap(bool wait,
+            std::vector<std::pair<int, int>>* completions) override {
+    AutoLock lock(lock_);
+    while (wait && completed_.empty())
+      work_done_.Wait();
+    completions->insert(completions->end(), completed_.begin(),
+                        completed_.end());
+    completed_.clear();
+  }
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override {
+    AutoLock lock(lock_);
+    for (;;) {
+      while (pending_.empty() && !shutting_down_)
+        work_available_.Wait();
+      if (pending_.empty())
+        return;
+      std::pair<int, internal::AsyncFileOperation> work = pending_.front();
+      pending_.pop_front();
+
+      const internal::AsyncFileOperation& operation = work.second;
+      int result;
+      {
+        AutoUnlock unlock(lock_);
+        result = operation.write ? file_->Write(operation.offset,
+                                                operation.data, operation.size)
+                                 : file_->Read(operation.offset,
+                                               operation.data, operation.size);
+      }
+      completed_.push_back(std::make_pair(work.first, result));
+      work_done_.Signal();
+    }
+  }
+
+ private:
+  File* const file_;
+
+  // Only touched by the AsyncFile's thread.
+  std::vector<std::pair<int, internal::AsyncFileOperation>> queued_;
+
+  Lock lock_;
+  ConditionVariable work_available_;
+  ConditionVariable work_done_;
+  std::deque<std::pair<int, internal::AsyncFileOperation>> pending_;
+  std::vector<std::pair<int, int>> completed_;
+  bool shutting_down_;
+
+  std::vector<std::unique_ptr<DelegateSimpleThread>> threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadPoolBackend);
+};
+
+}  // namespace
+
+AsyncFile::Options::Options()
+    : queue_depth(128), fallback_threads(4), disable_io_uring(false) {}
+
+AsyncFile::Options::~Options() {}
+
+AsyncFile::AsyncFile(File* file) : AsyncFile(file, Options()) {}
+
+AsyncFile::AsyncFile(File* file, const Options& options)
+    : options_(options),
+      using_io_uring_(false),
+      slots_(options.queue_depth),
+      in_flight_(0),
+      has_queued_(false) {
+  DCHECK(file->IsValid());
+  DCHECK_GT(options.queue_depth, 0);
+#if defined(OS_LINUX)
+  if (!options.disable_io_uring) {
+    backend_ = internal::CreateIoUringBackend(file->GetPlatformFile(),
+                                              options.queue_depth);
+    using_io_uring_ = !!backend_;
+  }
+#endif
+  if (!backend_)
+    backend_.reset(new ThreadPoolBackend(file, options.fallback_threads));
+
+  free_slots_.reserve(options.queue_depth);
+  for (int slot = options.queue_depth - 1; slot >= 0; --slot)
+    free_slots_.push_back(slot);
+}
+
+AsyncFile::~AsyncFile() {
+  // The backend may still write into the callers' buffers until every
+  // operation has finished.
+  Submit();
+  std::vector<std::pair<int, int>> completions;
+  while (in_flight_) {
+    completions.clear();
+    backend_->Reap(true, &completions);
+    in_flight_ -= static_cast<int>(completions.size());
+  }
+}
+
+bool AsyncFile::Read(int64_t offset,
+                     char* data,
+                     int size,
+                     const CompletionCallback& callback) {
+  return Queue(offset, data, size, false, callback);
+}
+
+bool AsyncFile::Write(int64_t offset,
+                      const char* data,
+                      int size,
+                      const CompletionCallback& callback) {
+  return Queue(offset, const_cast<char*>(data), size, true, callback);
+}
+
+bool AsyncFile::Queue(int64_t offset,
+                      char* data,
+                      int size,
+                      bool write,
+                      const CompletionCallback& callback) {
+  DCHECK_GE(size, 0);
+  if (free_slots_.empty())
+    return false;
+  int index = free_slots_.back();
+  free_slots_.pop_back();
+
+  Slot& slot = slots_[index];
+  slot.operation.offset = offset;
+  slot.operation.data = data;
+  slot.operation.size = size;
+  slot.operation.write = write;
+  slot.done = 0;
+  slot.callback = callback;
+  backend_->Queue(index, slot.operation);
+  ++in_flight_;
+  has_queued_ = true;
+  return true;
+}
+
+void AsyncFile::Submit() {
+  if (!has_queued_)
+    return;
+  backend_->Submit();
+  has_queued_ = false;
+}
+
+int AsyncFile::ProcessCompletions(bool wait) {
+  if (wait)
+    Submit();
+
+  int ran = 0;
+  std::vector<std::pair<int, int>> completions;
+  do {
+    if (!in_flight_)
+      break;
+    completions.clear();
+    backend_->Reap(wait, &completions);
+
+    bool requeued = false;
+    for (const std::pair<int, int>& completion : completions) {
+      Slot& slot = slots_[completion.first];
+      int result = completion.second;
+      if (result > 0 && slot.done + result < slot.operation.size) {
+        // A short transfer, which File::Read() and File::Write() would retry
+        // for the rest.
+        slot.done += result;
+        internal::AsyncFileOperation rest = slot.operation;
+        rest.offset += slot.done;
+        rest.data += slot.done;
+        rest.size -= slot.done;
+        backend_->Queue(completion.first, rest);
+        requeued = true;
+        continue;
+      }
+      if (result >= 0 || slot.done)
+        result = slot.done + std::max(result, 0);
+
+      CompletionCallback callback;
+      callback.swap(slot.callback);
+      free_slots_.push_back(completion.first);
+      --in_flight_;
+      ++ran;
+      if (options_.post_task)
+        options_.post_task(std::bind(callback, result));
+      else
+        callback(result);
+    }
+    if (requeued) {
+      has_queued_ = true;
+      Submit();
+    }
+  } while (wait && !ran);
+  return ran;
+}
+
+void AsyncFile::WaitForAll() {
+  while (in_flight_)
+    ProcessCompletions(true);
+}
+
+}  // namespace base
@@ -0,0 +1,166 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_ASYNC_FILE_H_
+#define BASE_FILES_ASYNC_FILE_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+#include "base/files/file.h"
+#include "base/macros.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace internal {
+
+// One read or write in flight on an AsyncFile.
+struct AsyncFileOperation {
+  int64_t offset;
+  char* data;
+  int size;
+  bool write;
+};
+
+// Carries out AsyncFile operations. Operations are identified by a slot
+// number below the queue depth.
+class AsyncFileBackend {
+ public:
+  virtual ~AsyncFileBackend() {}
+
+  // Queues |operation| under |slot|. It starts at the next Submit().
+  virtual void Queue(int slot, const AsyncFileOperation& operation) = 0;
+
+  // Starts every queued operation.
+  virtual void Submit() = 0;
+
+  // Appends (slot, result) for finished operations to |completions|. If
+  // |wait| and none has finished, blocks until one does. The result is a
+  // byte count or -1, and may be short of the requested size.
+  virtual void Reap(bool wait,
+                    std::vector<std::pair<int, int>>* completions) = 0;
+};
+
+#if defined(OS_LINUX)
+// Returns NULL if io_uring is unavailable, e.g. on kernels before 5.1 or
+// where it is disabled.
+std::unique_ptr<AsyncFileBackend> CreateIoUringBackend(PlatformFile file,
+                                                       int queue_depth);
+#endif
+
+}  // namespace internal
+
+// Keeps many reads and writes on one File in flight from a single thread.
+// Operations are queued, then submitted as a batch, and their callbacks run
+// when the caller reaps completions:
+//
+//   AsyncFile async_file(&file);
+//   for (int i = 0; i < 64; ++i)
+//     async_file.Read(i * kBlockSize, buffers[i], kBlockSize, callback);
+//   async_file.Submit();
+//   while (async_file.in_flight())
+//     async_file.ProcessCompletions(true);
+//
+// On Linux the operations go through io_uring, so a batch costs one system
+// call and no threads. Elsewhere, or where io_uring is unavailable, a small
+// pool of threads runs blocking File reads and writes.
+//
+// An AsyncFile is used from one thread; to run the callbacks elsewhere, such
+// as on a MessageLoop, set Options::post_task.
+class BASE_EXPORT AsyncFile {
+ public:
+  // Receives the same result File::Read() or File::Write() would return: the
+  // number of bytes transferred, which is short only at end of file, or -1.
+  typedef std::function<void(int result)> CompletionCallback;
+
+  struct BASE_EXPORT Options {
+    Options();
+    ~Options();
+
+    // The maximum number of operations in flight.
+    int queue_depth;
+
+    // Threads used when io_uring is unavailable.
+    int fallback_threads;
+
+    // Uses the thread pool even if io_uring is available.
+    bool disable_io_uring;
+
+    // If set, completion callbacks are handed to it as tasks rather than
+    // run by ProcessCompletions(), e.g. to post them to a MessageLoop.
+    std::function<void(const Closure& task)> post_task;
+  };
+
+  // |file| must be valid and outlive this object.
+  explicit AsyncFile(File* file);
+  AsyncFile(File* file, const Options& options);
+
+  // Waits for the operations in flight. Their callbacks are not run.
+  ~AsyncFile();
+
+  // Queues a read of |size| bytes at |offset| into |data|, or a write of
+  // |data|. |data| must stay valid until |callback| runs. Returns false if
+  // queue_depth() operations are already in flight.
+  bool Read(int64_t offset,
+            char* data,
+            int size,
+            const CompletionCallback& callback);
+  bool Write(int64_t offset,
+             const char* data,
+             int size,
+             const CompletionCallback& callback);
+
+  // Starts the queued operations.
+  void Submit();
+
+  // Runs the callbacks of finished operations and returns how many ran. If
+  // |wait|, submits queued operations and blocks until at least one
+  // finishes, unless none is in flight. Callbacks may queue new operations
+  // but must not call ProcessCompletions().
+  int ProcessCompletions(bool wait);
+
+  // Submits and processes completions until nothing is in flight.
+  void WaitForAll();
+
+  // The operations queued or started but not yet completed.
+  int in_flight() const { return in_flight_; }
+  int queue_depth() const { return static_cast<int>(slots_.size()); }
+  bool using_io_uring() const { return using_io_uring_; }
+
+ private:
+  struct Slot {
+    internal::AsyncFileOperation operation;
+    // Bytes transferred by earlier, short, attempts.
+    int done;
+    CompletionCallback callback;
+  };
+
+  bool Queue(int64_t offset,
+             char* data,
+             int size,
+             bool write,
+             const CompletionCallback& callback);
+
+  const Options options_;
+  std::unique_ptr<internal::AsyncFileBackend> backend_;
+  bool using_io_uring_;
+
+  std::vector<Slot> slots_;
+  std::vector<int> free_slots_;
+  int in_flight_;
+  bool has_queued_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncFile);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_ASYNC_FILE_H_
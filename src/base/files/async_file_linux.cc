@@ -0,0 +1,243 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/async_file.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "base/atomicops.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define HAS_IO_URING_HEADER 1
+#endif
+#endif
+
+namespace base {
+namespace internal {
+
+#if defined(HAS_IO_URING_HEADER)
+
+namespace {
+
+// glibc has no wrappers for these, and liburing is not a dependency.
+#if !defined(__NR_io_uring_setup)
+#define __NR_io_uring_setup 425
+#endif
+#if !defined(__NR_io_uring_enter)
+#define __NR_io_uring_enter 426
+#endif
+
+int IoUringSetup(unsigned entries, struct io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                 unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, NULL, 0));
+}
+
+// The ring indices are shared with the kernel, which reads and writes them
+// with acquire and release semantics.
+uint32_t LoadAcquire(const uint32_t* index) {
+  return static_cast<uint32_t>(subtle::Acquire_Load(
+      reinterpret_cast<const volatile subtle::Atomic32*>(index)));
+}
+
+void StoreRelease(uint32_t* index, uint32_t value) {
+  subtle::Release_Store(reinterpret_cast<volatile subtle::Atomic32*>(index),
+                        static_cast<subtle::Atomic32>(value));
+}
+
+// Submits reads and writes on one file through an io_uring instance of its
+// own. The AsyncFile never has more operations in flight than the ring has
+// entries, so neither ring can overflow.
+class IoUringBackend : public AsyncFileBackend {
+ public:
+  IoUringBackend(PlatformFile file, int queue_depth)
+      : file_(file),
+        iovecs_(queue_depth),
+        sq_ring_(NULL),
+        sq_ring_size_(0),
+        cq_ring_(NULL),
+        cq_ring_size_(0),
+        sqes_(NULL),
+        sqes_size_(0),
+        to_submit_(0) {}
+
+  ~IoUringBackend() override {
+    if (sqes_)
+      munmap(sqes_, sqes_size_);
+    if (cq_ring_ && cq_ring_ != sq_ring_)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sq_ring_)
+      munmap(sq_ring_, sq_ring_size_);
+  }
+
+  bool Initialize() {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_.reset(IoUringSetup(static_cast<unsigned>(iovecs_.size()),
+                                &params));
+    if (!ring_fd_.is_valid()) {
+      DPLOG(WARNING) << "io_uring_setup";
+      return false;
+    }
+
+    sq_ring_size_ =
+        params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+    if (!sq_ring_)
+      return false;
+    cq_ring_ =
+        single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+    if (!cq_ring_)
+      return false;
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    sqes_ = static_cast<struct io_uring_sqe*>(Map(sqes_size_,
+                                                  IORING_OFF_SQES));
+    if (!sqes_)
+      return false;
+
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  // AsyncFileBackend:
+  void Queue(int slot, const AsyncFileOperation& operation) override {
+    // READV and WRITEV work on every kernel with io_uring; READ and WRITE
+    // need 5.6. The kernel reads the iovec at submission.
+    struct iovec& iov = iovecs_[slot];
+    iov.iov_base = operation.data;
+    iov.iov_len = operation.size;
+
+    uint32_t tail = *sq_tail_;
+    uint32_t index = tail & sq_mask_;
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = operation.write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = file_;
+    sqe->off = operation.offset;
+    sqe->addr = reinterpret_cast<uintptr_t>(&iov);
+    sqe->len = 1;
+    sqe->user_data = static_cast<uint64_t>(slot);
+    sq_array_[index] = index;
+    StoreRelease(sq_tail_, tail + 1);
+    ++to_submit_;
+  }
+
+  void Submit() override {
+    while (to_submit_) {
+      int submitted = IoUringEnter(ring_fd_.get(), to_submit_, 0, 0);
+      if (submitted < 0) {
+        if (errno == EINTR || errno == EAGAIN)
+          continue;
+        PLOG(FATAL) << "io_uring_enter";
+      }
+      to_submit_ -= submitted;
+    }
+  }
+
+  void Reap(bool wait,
+            std::vector<std::pair<int, int>>* completions) override {
+    uint32_t head = *cq_head_;
+    while (wait && head == LoadAcquire(cq_tail_)) {
+      if (IoUringEnter(ring_fd_.get(), 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+          errno != EINTR) {
+        PLOG(FATAL) << "io_uring_enter";
+      }
+    }
+    uint32_t tail = LoadAcquire(cq_tail_);
+    for (; head != tail; ++head) {
+      const struct io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      completions->push_back(std::make_pair(static_cast<int>(cqe.user_data),
+                                            cqe.res < 0 ? -1 : cqe.res));
+    }
+    StoreRelease(cq_head_, head);
+  }
+
+ private:
+  void* Map(size_t size, off_t offset) {
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring_fd_.get(), offset);
+    if (memory == MAP_FAILED) {
+      DPLOG(WARNING) << "mmap io_uring";
+      return NULL;
+    }
+    return memory;
+  }
+
+  const PlatformFile file_;
+  ScopedFD ring_fd_;
+  std::vector<struct iovec> iovecs_;
+
+  void* sq_ring_;
+  size_t sq_ring_size_;
+  void* cq_ring_;
+  size_t cq_ring_size_;
+  struct io_uring_sqe* sqes_;
+  size_t sqes_size_;
+
+  uint32_t* sq_tail_;
+  uint32_t sq_mask_;
+  uint32_t* sq_array_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  struct io_uring_cqe* cqes_;
+
+  // Queued entries the kernel has not consumed yet.
+  unsigned to_submit_;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUringBackend);
+};
+
+}  // namespace
+
+std::unique_ptr<AsyncFileBackend> CreateIoUringBackend(PlatformFile file,
+                                                       int queue_depth) {
+  std::unique_ptr<IoUringBackend> backend(
+      new IoUringBackend(file, queue_depth));
+  if (!backend->Initialize())
+    return nullptr;
+  return backend;
+}
+
+#else  // defined(HAS_IO_URING_HEADER)
+
+std::unique_ptr<AsyncFileBackend> CreateIoUringBackend(
+    PlatformFile /* file */,
+    int /* queue_depth */) {
+  return nullptr;
+}
+
+#endif  // defined(HAS_IO_URING_HEADER)
+
+}  // namespace internal
+}  // namespace base
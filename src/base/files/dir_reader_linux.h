@@ -5,10 +5,12 @@
 #ifndef BASE_FILES_DIR_READER_LINUX_H_
 #define BASE_FILES_DIR_READER_LINUX_H_
 
+#include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/syscall.h>
 #include <unistd.h>
 
@@ -28,16 +30,25 @@ struct linux_dirent {
   char            d_name[0];
 };
 
-class DirReaderLinux {
+// Each getdents64() call fills a |BufferSize| byte buffer. DirReaderLinux
+// keeps it small for the stacks of signal handlers and forked children;
+// enumerating large directories wants tens of kilobytes.
+template <size_t BufferSize>
+class BasicDirReaderLinux {
  public:
-  explicit DirReaderLinux(const char* directory_path)
-      : fd_(open(directory_path, O_RDONLY | O_DIRECTORY)),
+  explicit BasicDirReaderLinux(const char* directory_path)
+      : BasicDirReaderLinux(AT_FDCWD, directory_path) {}
+
+  // Opens |directory_path| relative to the directory open as |directory_fd|.
+  BasicDirReaderLinux(int directory_fd, const char* directory_path)
+      : fd_(openat(directory_fd, directory_path,
+                   O_RDONLY | O_DIRECTORY | O_CLOEXEC)),
         offset_(0),
         size_(0) {
     memset(buf_, 0, sizeof(buf_));
   }
 
-  ~DirReaderLinux() {
+  ~BasicDirReaderLinux() {
     if (fd_ >= 0) {
       if (IGNORE_EINTR(close(fd_))) {
         // RAW_LOG(ERROR, "Failed to close directory handle");
@@ -80,6 +91,17 @@ class DirReaderLinux {
     return dirent->d_name;
   }
 
+  // Returns the DT_* type of the current entry, which is DT_UNKNOWN on file
+  // systems that do not record it.
+  unsigned char type() const {
+    if (!size_)
+      return DT_UNKNOWN;
+
+    const linux_dirent* dirent =
+        reinterpret_cast<const linux_dirent*>(&buf_[offset_]);
+    return dirent->d_type;
+  }
+
   int fd() const {
     return fd_;
   }
@@ -90,13 +112,19 @@ class DirReaderLinux {
 
  private:
   const int fd_;
-  unsigned char buf_[512];
+  alignas(linux_dirent) unsigned char buf_[BufferSize];
   size_t offset_;
   size_t size_;
 
-  DISALLOW_COPY_AND_ASSIGN(DirReaderLinux);
+  DISALLOW_COPY_AND_ASSIGN(BasicDirReaderLinux);
 };
 
+typedef BasicDirReaderLinux<512> DirReaderLinux;
+
+// For enumerating large directories: enough for a few hundred entries per
+// getdents64() call.
+typedef BasicDirReaderLinux<16 * 1024> LargeDirReaderLinux;
+
 }  // namespace base
 
 #endif  // BASE_FILES_DIR_READER_LINUX_H_
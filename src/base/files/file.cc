@@ -10,6 +10,9 @@
 
 namespace base {
 
+// static
+const size_t File::kDirectIOAlignment;
+
 File::Info::Info()
     : size(0),
       is_directory(false),
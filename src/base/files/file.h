@@ -5,6 +5,7 @@
 #ifndef BASE_FILES_FILE_H_
 #define BASE_FILES_FILE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <string>
@@ -24,6 +25,7 @@
 
 #if defined(OS_POSIX)
 #include <sys/stat.h>
+#include <sys/uio.h>
 #endif
 
 namespace base {
@@ -84,8 +86,38 @@ class BASE_EXPORT File {
     FLAG_BACKUP_SEMANTICS = 1 << 17,  // Used on Windows only.
     FLAG_EXECUTE = 1 << 18,           // Used on Windows only.
     FLAG_SEQUENTIAL_SCAN = 1 << 19,   // Used on Windows only.
+    FLAG_DIRECT = 1 << 20,            // Bypasses the OS cache; see below.
   };
 
+  // With FLAG_DIRECT, reads and writes go straight between the caller's
+  // buffers and the disk. Buffer addresses, offsets and sizes must then be
+  // multiples of the device's logical block size, which this always is, e.g.
+  // AlignedAlloc(size, File::kDirectIOAlignment). On Mac, where uncached I/O
+  // has no alignment requirements, the OS cache is only bypassed as far as
+  // possible.
+  static const size_t kDirectIOAlignment = 4096;
+
+#if defined(OS_POSIX)
+  // Modifiers for ReadV() and WriteV().
+  enum IOFlags {
+    // Fails with EAGAIN, or returns a short count, rather than waiting for
+    // data that is not already cached. Reads only; Linux 4.14 and later.
+    IO_NOWAIT = 1 << 0,
+    // Returns only once the data written is on disk, as if followed by
+    // fdatasync().
+    IO_DSYNC = 1 << 1,
+  };
+
+  // How a range of the file will be used, for Advise().
+  enum Advice {
+    ADVICE_NORMAL,
+    ADVICE_SEQUENTIAL,  // Read ahead more.
+    ADVICE_RANDOM,      // Do not read ahead.
+    ADVICE_WILL_NEED,   // Start reading the range into the cache.
+    ADVICE_DONT_NEED,   // Drop the range from the cache.
+  };
+#endif
+
   // This enum has been recorded in multiple histograms. If the order of the
   // fields needs to change, please ensure that those histograms are obsolete or
   // have been moved to a different enum.
@@ -241,6 +273,31 @@ class BASE_EXPORT File {
   // platforms. Returns the number of bytes written, or -1 on error.
   int WriteAtCurrentPosNoBestEffort(const char* data, int size);
 
+#if defined(OS_POSIX)
+  // Reads into, or writes from, the |count| buffers of |iov| in turn,
+  // starting at |offset|, in as few system calls as possible. Sizes are not
+  // limited to int. Like Read() and Write() these make a best effort to
+  // transfer everything, so the result is short only at the end of the file,
+  // or on an error or IO_NOWAIT once some data has been transferred. Returns
+  // the number of bytes transferred, or -1. |flags| are IOFlags. WriteV()
+  // ignores |offset| if the file was opened with FLAG_APPEND.
+  int64_t ReadV(int64_t offset, const struct iovec* iov, int count, int flags);
+  int64_t WriteV(int64_t offset,
+                 const struct iovec* iov,
+                 int count,
+                 int flags);
+
+  // Reserves disk space for |length| bytes at |offset|, so writes there can
+  // not fail for lack of space and are laid out contiguously. The file grows
+  // to cover the range unless |keep_size|, which is only supported on Linux.
+  bool Preallocate(int64_t offset, int64_t length, bool keep_size);
+
+  // Tells the OS how the |length| bytes at |offset| will be used, so it can
+  // adjust read ahead and caching. A |length| of 0 extends to the end of the
+  // file. Returns false where the advice is not supported.
+  bool Advise(int64_t offset, int64_t length, Advice advice);
+#endif
+
   // Returns the current size of this file, or a negative number on failure.
   int64_t GetLength();
 
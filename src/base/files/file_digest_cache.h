@@ -0,0 +1,122 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_FILE_DIGEST_CACHE_H_
+#define BASE_FILES_FILE_DIGEST_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/md5.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+
+// Remembers the MD5 digests of file contents across runs, so that scans
+// which keep hashing or comparing the same files cost a stat() per
+// unchanged file rather than a full read:
+//
+//   FileDigestCache cache;
+//   if (!cache.Initialize(cache_dir.AppendASCII("digests")))
+//     return;
+//   MD5Digest digest;
+//   if (cache.GetDigest(path, &digest))
+//     ...
+//
+// Digests are recorded under the file's device, inode, size and
+// modification time, and a file whose contents change without any of those
+// changing is not noticed. Files modified within the last second are not
+// recorded, as further writes may yet land within the same time stamp.
+//
+// The index is an open addressing hash table in a memory mapped file.
+// Entries are only ever added: GetDigest() reads without taking locks, and
+// those adding entries take one only among themselves. The table doubles
+// as it fills, up to 64 MB, and then starts over, which is also when
+// entries for files that have since changed are dropped. A table that has
+// been replaced stays mapped only until the lookups that started before
+// the switch have finished. One process at a time may open a given index.
+//
+// Only available on POSIX.
+class BASE_EXPORT FileDigestCache {
+ public:
+  FileDigestCache();
+  ~FileDigestCache();
+
+  // Opens the index at |index_path|, creating it, or starting over if it is
+  // unreadable. Returns false if it cannot be created or another process
+  // has it open.
+  bool Initialize(const FilePath& index_path);
+
+  // Sets |digest| to the MD5 of the contents of |path|, reading the file
+  // only if no digest is recorded for it as it is now. Returns false if the
+  // file cannot be read. May be called from any thread.
+  bool GetDigest(const FilePath& path, MD5Digest* digest);
+
+  // Returns whether the files have the same contents, going by size and
+  // then by digest. Returns false if either cannot be read. Since MD5
+  // collisions can be manufactured, this does not suit files from untrusted
+  // sources.
+  bool ContentsEqual(const FilePath& path1, const FilePath& path2);
+
+  // The number of digests recorded, including stale ones.
+  size_t size() const;
+
+ private:
+  struct Table;
+
+  // Maps the index at |index_path_|. Returns NULL if it is missing or not
+  // a valid index.
+  std::unique_ptr<Table> OpenTable();
+
+  // Creates a table of |capacity| slots, holding the entries of |old| if it
+  // is not NULL, and moves it into place at |index_path_|.
+  std::unique_ptr<Table> CreateTable(uint32_t capacity, const Table* old);
+
+  // Returns the table in use. Never NULL once initialized.
+  Table* table() const;
+
+  // Bracket lookups in the table returned by BeginRead(), which stays mapped
+  // until the matching EndRead().
+  const Table* BeginRead() const;
+  void EndRead();
+
+  // Unmaps the tables that have been replaced if no lookup is under way.
+  // Called with |lock_| held.
+  void ReleaseReplacedTables();
+
+  // Look up and record the digest for a file with the status |stat_buf|.
+  bool FindDigest(const struct stat& stat_buf, MD5Digest* digest);
+  void AddDigest(const struct stat& stat_buf, const MD5Digest& digest);
+
+  FilePath index_path_;
+  // Locked for as long as the index is open.
+  File lock_file_;
+
+  // Held while adding entries and while releasing tables.
+  Lock lock_;
+  // The table in use last, after those it replaced that lookups may still
+  // be using.
+  std::vector<std::unique_ptr<Table>> tables_;
+  // The Table* in use.
+  subtle::AtomicWord table_;
+  // The number of lookups under way.
+  mutable subtle::Atomic32 readers_;
+  // Whether |tables_| holds replaced tables.
+  subtle::Atomic32 has_replaced_tables_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileDigestCache);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_FILE_DIGEST_CACHE_H_
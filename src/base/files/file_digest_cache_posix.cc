@@ -0,0 +1,385 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_digest_cache.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/hash.h"
+#include "base/logging.h"
+#include "base/strings/string_piece.h"
+#include "base/threading/thread_restrictions.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace {
+
+const uint32_t kMagic = 0x31434446;  // "FDC1"
+const uint32_t kVersion = 1;
+
+// 256 KB to start with. A full table of the largest size, 64 MB, is
+// replaced by an empty one, which also drops stale entries.
+const uint32_t kInitialCapacity = 1 << 12;
+const uint32_t kMaxCapacity = 1 << 20;
+
+// Files modified more recently than this are not recorded, since a write in
+// the same time stamp tick could follow unnoticed.
+const int64_t kRecentNanoseconds = 1000000000;
+
+const subtle::Atomic32 kReady = 1;
+
+struct DigestKey {
+  bool operator==(const DigestKey& other) const {
+    return device == other.device && inode == other.inode &&
+           size == other.size && last_modified == other.last_modified;
+  }
+
+  uint64_t device;
+  uint64_t inode;
+  int64_t size;
+  // Nanoseconds since the epoch.
+  int64_t last_modified;
+};
+
+struct Header {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  subtle::Atomic32 size;
+  uint8_t reserved[48];
+};
+
+struct Slot {
+  subtle::Atomic32 state;
+  // Of |key| and |digest|, to catch entries torn by a crash.
+  uint32_t checksum;
+  DigestKey key;
+  uint8_t digest[16];
+  uint8_t reserved[8];
+};
+
+static_assert(sizeof(Header) == 64, "Header is part of the index format");
+static_assert(sizeof(Slot) == 64, "Slot is part of the index format");
+static_assert(sizeof(MD5Digest) == sizeof(Slot::digest),
+              "digests must fit in slots");
+
+int64_t ToNanoseconds(const struct timespec& time) {
+  return time.tv_sec * static_cast<int64_t>(1000000000) + time.tv_nsec;
+}
+
+DigestKey KeyFromStat(const struct stat& stat_buf) {
+  DigestKey key;
+  key.device = stat_buf.st_dev;
+  key.inode = stat_buf.st_ino;
+  key.size = stat_buf.st_size;
+#if defined(OS_MACOSX)
+  key.last_modified = ToNanoseconds(stat_buf.st_mtimespec);
+#else
+  key.last_modified = ToNanoseconds(stat_buf.st_mtim);
+#endif
+  return key;
+}
+
+uint32_t HashKey(const DigestKey& key) {
+  return static_cast<uint32_t>(HashInts64(key.device, key.inode));
+}
+
+uint32_t Checksum(const Slot& slot) {
+  static_assert(
+      offsetof(Slot, digest) == offsetof(Slot, key) + sizeof(DigestKey),
+      "the checksum covers the key and digest together");
+  return Hash(reinterpret_cast<const char*>(&slot.key),
+              sizeof(slot.key) + sizeof(slot.digest));
+}
+
+bool HashFile(File* file, MD5Digest* digest) {
+  file->Advise(0, 0, File::ADVICE_SEQUENTIAL);
+  const int kBufferSize = 1 << 16;
+  std::unique_ptr<char[]> buffer(new char[kBufferSize]);
+  MD5Context context;
+  MD5Init(&context);
+  int length;
+  while ((length = file->ReadAtCurrentPos(buffer.get(), kBufferSize)) > 0)
+    MD5Update(&context, StringPiece(buffer.get(), length));
+  if (length < 0)
+    return false;
+  MD5Final(digest, &context);
+  return true;
+}
+
+bool RecentlyModified(const DigestKey& key) {
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return key.last_modified > ToNanoseconds(now) - kRecentNanoseconds;
+}
+
+}  // namespace
+
+struct FileDigestCache::Table {
+  void Attach() {
+    header = reinterpret_cast<Header*>(file.writable_data());
+    slots = reinterpret_cast<Slot*>(header + 1);
+    mask = header->capacity - 1;
+  }
+
+  // Returns the entry for |key|, or NULL. Safe against concurrent Add()s.
+  const Slot* Find(const DigestKey& key) const {
+    uint32_t index = HashKey(key);
+    for (uint32_t probe = 0; probe <= mask; ++probe, ++index) {
+      const Slot& slot = slots[index & mask];
+      if (subtle::Acquire_Load(&slot.state) != kReady)
+        return NULL;
+      if (slot.key == key && slot.checksum == Checksum(slot))
+        return &slot;
+    }
+    return NULL;
+  }
+
+  // Adds an entry unless one for |key| exists. The caller makes sure the
+  // table has room.
+  void Add(const DigestKey& key, const uint8_t* digest) {
+    uint32_t index = HashKey(key);
+    for (uint32_t probe = 0; probe <= mask; ++probe, ++index) {
+      Slot& slot = slots[index & mask];
+      if (subtle::NoBarrier_Load(&slot.state) == kReady) {
+        if (slot.key == key && slot.checksum == Checksum(slot))
+          return;
+        continue;
+      }
+      slot.key = key;
+      memcpy(slot.digest, digest, sizeof(slot.digest));
+      slot.checksum = Checksum(slot);
+      subtle::Release_Store(&slot.state, kReady);
+      subtle::NoBarrier_Store(&header->size,
+                              subtle::NoBarrier_Load(&header->size) + 1);
+      return;
+    }
+    NOTREACHED();
+  }
+
+  // Whether another entry would fill more than half the slots.
+  bool IsFull() const {
+    return static_cast<uint32_t>(subtle::NoBarrier_Load(&header->size)) >=
+           (mask + 1) / 2;
+  }
+
+  MemoryMappedFile file;
+  Header* header;
+  Slot* slots;
+  uint32_t mask;
+};
+
+FileDigestCache::FileDigestCache()
+    : table_(0), readers_(0), has_replaced_tables_(0) {}
+
+FileDigestCache::~FileDigestCache() {}
+
+bool FileDigestCache::Initialize(const FilePath& index_path) {
+  ThreadRestrictions::AssertIOAllowed();
+  DCHECK(!table());
+  index_path_ = index_path;
+  lock_file_.Initialize(index_path.AddExtension("lock"),
+                        File::FLAG_OPEN_ALWAYS | File::FLAG_READ |
+                            File::FLAG_WRITE);
+  if (!lock_file_.IsValid() || lock_file_.Lock() != File::FILE_OK)
+    return false;
+
+  std::unique_ptr<Table> table = OpenTable();
+  if (!table)
+    table = CreateTable(kInitialCapacity, NULL);
+  if (!table)
+    return false;
+  subtle::Release_Store(&table_,
+                        reinterpret_cast<subtle::AtomicWord>(table.get()));
+  tables_.push_back(std::move(table));
+  return true;
+}
+
+bool FileDigestCache::GetDigest(const FilePath& path, MD5Digest* digest) {
+  ThreadRestrictions::AssertIOAllowed();
+  DCHECK(table());
+  struct stat stat_buf;
+  if (stat(path.value().c_str(), &stat_buf) != 0 || !S_ISREG(stat_buf.st_mode))
+    return false;
+  if (FindDigest(stat_buf, digest))
+    return true;
+
+  // The file is hashed as it is once opened, and its digest recorded only
+  // if it did not change while being read.
+  File file(path, File::FLAG_OPEN | File::FLAG_READ);
+  if (!file.IsValid() || fstat(file.GetPlatformFile(), &stat_buf) != 0 ||
+      !HashFile(&file, digest)) {
+    return false;
+  }
+  struct stat after;
+  if (fstat(file.GetPlatformFile(), &after) == 0 &&
+      KeyFromStat(after) == KeyFromStat(stat_buf) &&
+      !RecentlyModified(KeyFromStat(after))) {
+    AddDigest(after, *digest);
+  }
+  return true;
+}
+
+bool FileDigestCache::ContentsEqual(const FilePath& path1,
+                                    const FilePath& path2) {
+  ThreadRestrictions::AssertIOAllowed();
+  struct stat stat1;
+  struct stat stat2;
+  if (stat(path1.value().c_str(), &stat1) != 0 ||
+      stat(path2.value().c_str(), &stat2) != 0) {
+    return false;
+  }
+  if (stat1.st_size != stat2.st_size)
+    return false;
+  if (stat1.st_dev == stat2.st_dev && stat1.st_ino == stat2.st_ino)
+    return S_ISREG(stat1.st_mode);
+
+  MD5Digest digest1;
+  MD5Digest digest2;
+  return GetDigest(path1, &digest1) && GetDigest(path2, &digest2) &&
+         memcmp(digest1.a, digest2.a, sizeof(digest1.a)) == 0;
+}
+
+size_t FileDigestCache::size() const {
+  // Replaced tables are left for the next lookup or addition to release.
+  const Table* table = BeginRead();
+  size_t size = subtle::NoBarrier_Load(&table->header->size);
+  subtle::Barrier_AtomicIncrement(&readers_, -1);
+  return size;
+}
+
+std::unique_ptr<FileDigestCache::Table> FileDigestCache::OpenTable() {
+  if (!PathExists(index_path_))
+    return NULL;
+  std::unique_ptr<Table> table(new Table);
+  MemoryMappedFile::Options options;
+  options.access = MemoryMappedFile::READ_WRITE;
+  if (!table->file.Initialize(index_path_, options) ||
+      table->file.length() < sizeof(Header)) {
+    return NULL;
+  }
+  const Header* header = reinterpret_cast<const Header*>(table->file.data());
+  uint32_t capacity = header->capacity;
+  if (header->magic != kMagic || header->version != kVersion ||
+      capacity < kInitialCapacity || capacity > kMaxCapacity ||
+      (capacity & (capacity - 1)) ||
+      table->file.length() != sizeof(Header) + capacity * sizeof(Slot)) {
+    return NULL;
+  }
+  table->Attach();
+  return table;
+}
+
+std::unique_ptr<FileDigestCache::Table> FileDigestCache::CreateTable(
+    uint32_t capacity,
+    const Table* old) {
+  FilePath new_path = index_path_.AddExtension("new");
+  File file(new_path,
+            File::FLAG_CREATE_ALWAYS | File::FLAG_READ | File::FLAG_WRITE);
+  if (!file.IsValid() ||
+      !file.SetLength(sizeof(Header) + capacity * sizeof(Slot))) {
+    return NULL;
+  }
+  std::unique_ptr<Table> table(new Table);
+  MemoryMappedFile::Options options;
+  options.access = MemoryMappedFile::READ_WRITE;
+  if (!table->file.Initialize(std::move(file),
+                              MemoryMappedFile::Region::kWholeFile, options)) {
+    DeleteFile(new_path, false);
+    return NULL;
+  }
+
+  Header* header = reinterpret_cast<Header*>(table->file.writable_data());
+  header->version = kVersion;
+  header->capacity = capacity;
+  table->Attach();
+  if (old) {
+    for (uint32_t i = 0; i <= old->mask; ++i) {
+      const Slot& slot = old->slots[i];
+      if (subtle::NoBarrier_Load(&slot.state) == kReady &&
+          slot.checksum == Checksum(slot)) {
+        table->Add(slot.key, slot.digest);
+      }
+    }
+  }
+  header->magic = kMagic;
+
+  if (!ReplaceFile(new_path, index_path_, NULL)) {
+    DeleteFile(new_path, false);
+    return NULL;
+  }
+  return table;
+}
+
+FileDigestCache::Table* FileDigestCache::table() const {
+  return reinterpret_cast<Table*>(subtle::Acquire_Load(&table_));
+}
+
+const FileDigestCache::Table* FileDigestCache::BeginRead() const {
+  // The full barrier orders the count before the load of |table_|, pairing
+  // with the one in ReleaseReplacedTables(): either the replacing thread
+  // sees this lookup, or this lookup sees the new table.
+  subtle::Barrier_AtomicIncrement(&readers_, 1);
+  return table();
+}
+
+void FileDigestCache::EndRead() {
+  if (subtle::Barrier_AtomicIncrement(&readers_, -1) == 0 &&
+      subtle::NoBarrier_Load(&has_replaced_tables_)) {
+    AutoLock lock(lock_);
+    ReleaseReplacedTables();
+  }
+}
+
+void FileDigestCache::ReleaseReplacedTables() {
+  lock_.AssertAcquired();
+  if (tables_.size() < 2)
+    return;
+  subtle::MemoryBarrier();
+  // Lookups that start from now on see only the last table, so once none
+  // is under way, none can be using the others.
+  if (subtle::NoBarrier_Load(&readers_) != 0)
+    return;
+  tables_.erase(tables_.begin(), tables_.end() - 1);
+  subtle::NoBarrier_Store(&has_replaced_tables_, 0);
+}
+
+bool FileDigestCache::FindDigest(const struct stat& stat_buf,
+                                 MD5Digest* digest) {
+  const Slot* slot = BeginRead()->Find(KeyFromStat(stat_buf));
+  if (slot)
+    memcpy(digest->a, slot->digest, sizeof(digest->a));
+  EndRead();
+  return slot != NULL;
+}
+
+void FileDigestCache::AddDigest(const struct stat& stat_buf,
+                                const MD5Digest& digest) {
+  AutoLock lock(lock_);
+  Table* current = table();
+  if (current->IsFull()) {
+    uint32_t capacity = current->mask + 1;
+    std::unique_ptr<Table> grown =
+        capacity < kMaxCapacity ? CreateTable(capacity * 2, current)
+                                : CreateTable(kInitialCapacity, NULL);
+    if (!grown)
+      return;
+    current = grown.get();
+    tables_.push_back(std::move(grown));
+    subtle::Release_Store(&table_,
+                          reinterpret_cast<subtle::AtomicWord>(current));
+    subtle::NoBarrier_Store(&has_replaced_tables_, 1);
+  }
+  current->Add(KeyFromStat(stat_buf), digest.a);
+  ReleaseReplacedTables();
+}
+
+}  // namespace base
@@ -13,6 +13,7 @@
 
 #include "base/base_export.h"
 #include "base/files/file_path.h"
+#include "base/files/scoped_file.h"
 #include "base/macros.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
@@ -66,12 +67,15 @@ class BASE_EXPORT FileEnumerator {
 
    private:
     friend class FileEnumerator;
+    friend class ParallelFileEnumerator;
 
 #if defined(OS_WIN)
     WIN32_FIND_DATA find_data_;
 #elif defined(OS_POSIX)
     struct stat stat_;
     FilePath filename_;
+    // True while |stat_| only holds the file type from the directory entry.
+    bool needs_stat_;
 #endif
   };
 
@@ -134,9 +138,17 @@ class BASE_EXPORT FileEnumerator {
   HANDLE find_handle_;
 #elif defined(OS_POSIX)
 
-  // Read the filenames in source into the vector of DirectoryEntryInfo's
+  // Read the filenames in source into the vector of DirectoryEntryInfo's.
+  // Where the directory entries record file types, only the entries whose
+  // type is otherwise unknown are stat()ed, and |directory_fd| is left open
+  // so GetInfo() can stat the rest relative to it.
   static bool ReadDirectory(std::vector<FileInfo>* entries,
-                            const FilePath& source, bool show_links);
+                            const FilePath& source,
+                            bool show_links,
+                            ScopedFD* directory_fd);
+
+  // The directory the entries are in, if they still need stat()ing.
+  ScopedFD directory_fd_;
 
   // The files in the current directory
   std::vector<FileInfo> directory_entries_;
@@ -7,18 +7,48 @@
 #include <string.h>
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdint.h>
 
+#include <utility>
+
 #include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
 #include "base/threading/thread_restrictions.h"
 #include "build/build_config.h"
 
+#if defined(OS_LINUX)
+#include "base/files/dir_reader_linux.h"
+#endif
+
 namespace base {
 
+namespace {
+
+#if defined(OS_LINUX)
+// stat()s, or with |show_links| lstat()s, the entry |name| of the directory
+// open as |directory_fd|.
+void StatDirectoryEntry(int directory_fd,
+                        const char* name,
+                        bool show_links,
+                        struct stat* stat_buf) {
+  if (fstatat(directory_fd, name, stat_buf,
+              show_links ? AT_SYMLINK_NOFOLLOW : 0) < 0) {
+    // Print the stat() error message unless it was ENOENT and we're
+    // following symlinks.
+    if (!(errno == ENOENT && !show_links))
+      DPLOG(ERROR) << "Couldn't stat " << name;
+    memset(stat_buf, 0, sizeof(*stat_buf));
+  }
+}
+#endif  // defined(OS_LINUX)
+
+}  // namespace
+
 // FileEnumerator::FileInfo ----------------------------------------------------
 
-FileEnumerator::FileInfo::FileInfo() {
+FileEnumerator::FileInfo::FileInfo() : needs_stat_(false) {
   memset(&stat_, 0, sizeof(stat_));
 }
 
@@ -87,10 +117,14 @@ FilePath FileEnumerator::Next() {
     pending_paths_.pop();
 
     std::vector<FileInfo> entries;
-    if (!ReadDirectory(&entries, root_path_, file_type_ & SHOW_SYM_LINKS))
+    ScopedFD directory_fd;
+    if (!ReadDirectory(&entries, root_path_, file_type_ & SHOW_SYM_LINKS,
+                       &directory_fd)) {
       continue;
+    }
 
     directory_entries_.clear();
+    directory_fd_ = std::move(directory_fd);
     current_directory_entry_ = 0;
     for (std::vector<FileInfo>::const_iterator i = entries.begin();
          i != entries.end(); ++i) {
@@ -116,11 +150,53 @@ FilePath FileEnumerator::Next() {
 }
 
 FileEnumerator::FileInfo FileEnumerator::GetInfo() const {
-  return directory_entries_[current_directory_entry_];
+  FileInfo info = directory_entries_[current_directory_entry_];
+#if defined(OS_LINUX)
+  if (info.needs_stat_) {
+    base::ThreadRestrictions::AssertIOAllowed();
+    StatDirectoryEntry(directory_fd_.get(), info.filename_.value().c_str(),
+                       (file_type_ & SHOW_SYM_LINKS) != 0, &info.stat_);
+    info.needs_stat_ = false;
+  }
+#endif
+  return info;
 }
 
+#if defined(OS_LINUX)
+bool FileEnumerator::ReadDirectory(std::vector<FileInfo>* entries,
+                                   const FilePath& source,
+                                   bool show_links,
+                                   ScopedFD* directory_fd) {
+  base::ThreadRestrictions::AssertIOAllowed();
+  LargeDirReaderLinux reader(source.value().c_str());
+  if (!reader.IsValid())
+    return false;
+
+  while (reader.Next()) {
+    FileInfo info;
+    info.filename_ = FilePath(reader.name());
+
+    // The file type is all Next() needs; GetInfo() stats the rest on demand.
+    // Only entries of unknown type, and links whose target type decides
+    // whether they are directories, are stat()ed now.
+    unsigned char type = reader.type();
+    if (type == DT_UNKNOWN || (type == DT_LNK && !show_links)) {
+      StatDirectoryEntry(reader.fd(), reader.name(), show_links, &info.stat_);
+    } else {
+      info.stat_.st_mode = DTTOIF(type);
+      info.needs_stat_ = true;
+    }
+    entries->push_back(info);
+  }
+
+  directory_fd->reset(HANDLE_EINTR(fcntl(reader.fd(), F_DUPFD_CLOEXEC, 0)));
+  return true;
+}
+#else  // defined(OS_LINUX)
 bool FileEnumerator::ReadDirectory(std::vector<FileInfo>* entries,
-                                   const FilePath& source, bool show_links) {
+                                   const FilePath& source,
+                                   bool show_links,
+                                   ScopedFD* directory_fd) {
   base::ThreadRestrictions::AssertIOAllowed();
   DIR* dir = opendir(source.value().c_str());
   if (!dir)
@@ -159,5 +235,6 @@ bool FileEnumerator::ReadDirectory(std::vector<FileInfo>* entries,
   closedir(dir);
   return true;
 }
+#endif  // defined(OS_LINUX)
 
 }  // namespace base
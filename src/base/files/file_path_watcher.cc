@@ -0,0 +1,255 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_path_watcher.h"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+
+#include "base/files/file.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/logging.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+
+namespace {
+
+class PollingBackend : public internal::FilePathWatcherBackend {
+ public:
+  PollingBackend(const FilePath& path, bool recursive, TimeDelta poll_interval)
+      : path_(path),
+        recursive_(recursive),
+        poll_interval_(poll_interval),
+        cancelled_(false),
+        cancelled_signal_(&lock_) {
+    TakeSnapshot(&snapshot_);
+    next_poll_ = TimeTicks::Now() + poll_interval_;
+  }
+
+  // internal::FilePathWatcherBackend:
+  bool Wait(TimeDelta timeout,
+            std::vector<FilePath>* changed,
+            bool* /* error */) override {
+    TimeTicks now = TimeTicks::Now();
+    TimeTicks deadline = next_poll_;
+    if (!timeout.is_max())
+      deadline = std::min(deadline, now + timeout);
+    {
+      AutoLock lock(lock_);
+      while (!cancelled_ && now < deadline) {
+        cancelled_signal_.TimedWait(deadline - now);
+        now = TimeTicks::Now();
+      }
+      if (cancelled_)
+        return false;
+    }
+    if (now < next_poll_)
+      return true;
+
+    Snapshot snapshot;
+    TakeSnapshot(&snapshot);
+    Compare(snapshot_, snapshot, changed);
+    snapshot_.swap(snapshot);
+    next_poll_ = TimeTicks::Now() + poll_interval_;
+    return true;
+  }
+
+  void Cancel() override {
+    AutoLock lock(lock_);
+    cancelled_ = true;
+    cancelled_signal_.Signal();
+  }
+
+ private:
+  struct Entry {
+    bool operator!=(const Entry& other) const {
+      return last_modified != other.last_modified || size != other.size ||
+             is_directory != other.is_directory;
+    }
+
+    Time last_modified;
+    int64_t size;
+    bool is_directory;
+  };
+  typedef std::map<FilePath, Entry> Snapshot;
+
+  void TakeSnapshot(Snapshot* snapshot) {
+    File::Info info;
+    if (!GetFileInfo(path_, &info))
+      return;
+    Entry& entry = (*snapshot)[path_];
+    entry.last_modified = info.last_modified;
+    entry.size = info.size;
+    entry.is_directory = info.is_directory;
+    if (!info.is_directory)
+      return;
+
+    FileEnumerator enumerator(path_, recursive_,
+                              FileEnumerator::FILES |
+                                  FileEnumerator::DIRECTORIES |
+                                  FileEnumerator::SHOW_SYM_LINKS);
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      FileEnumerator::FileInfo file_info = enumerator.GetInfo();
+      Entry& entry = (*snapshot)[path];
+      entry.last_modified = file_info.GetLastModifiedTime();
+      entry.size = file_info.GetSize();
+      entry.is_directory = file_info.IsDirectory();
+    }
+  }
+
+  // Appends the paths added, removed or modified between the snapshots.
+  static void Compare(const Snapshot& before,
+                      const Snapshot& after,
+                      std::vector<FilePath>* changed) {
+    auto old_entry = before.begin();
+    auto new_entry = after.begin();
+    while (old_entry != before.end() || new_entry != after.end()) {
+      if (new_entry == after.end() ||
+          (old_entry != before.end() && old_entry->first < new_entry->first)) {
+        changed->push_back((old_entry++)->first);
+      } else if (old_entry == before.end() ||
+                 new_entry->first < old_entry->first) {
+        changed->push_back((new_entry++)->first);
+      } else {
+        if (old_entry->second != new_entry->second)
+          changed->push_back(new_entry->first);
+        ++old_entry;
+        ++new_entry;
+      }
+    }
+  }
+
+  const FilePath path_;
+  const bool recursive_;
+  const TimeDelta poll_interval_;
+
+  Snapshot snapshot_;
+  TimeTicks next_poll_;
+
+  Lock lock_;
+  bool cancelled_;
+  ConditionVariable cancelled_signal_;
+
+  DISALLOW_COPY_AND_ASSIGN(PollingBackend);
+};
+
+}  // namespace
+
+namespace internal {
+
+std::unique_ptr<FilePathWatcherBackend> CreatePollingBackend(
+    const FilePath& path,
+    bool recursive,
+    TimeDelta poll_interval) {
+  return std::unique_ptr<FilePathWatcherBackend>(
+      new PollingBackend(path, recursive, poll_interval));
+}
+
+}  // namespace internal
+
+FilePathWatcher::Options::Options()
+    : recursive(false),
+      debounce(TimeDelta::FromMilliseconds(50)),
+      max_delay(TimeDelta::FromMilliseconds(500)),
+      force_polling(false),
+      poll_interval(TimeDelta::FromSeconds(2)) {}
+
+FilePathWatcher::Options::~Options() {}
+
+FilePathWatcher::FilePathWatcher() : using_inotify_(false) {}
+
+FilePathWatcher::~FilePathWatcher() {
+  if (!thread_)
+    return;
+  backend_->Cancel();
+  thread_->Join();
+}
+
+bool FilePathWatcher::Watch(const FilePath& path,
+                            bool recursive,
+                            const Callback& callback) {
+  Options options;
+  options.recursive = recursive;
+  return Watch(path, options, callback);
+}
+
+bool FilePathWatcher::Watch(const FilePath& path,
+                            const Options& options,
+                            const Callback& callback) {
+  DCHECK(!backend_);
+  const FilePath watched_path = path.StripTrailingSeparators();
+#if defined(OS_LINUX)
+  if (!options.force_polling) {
+    backend_ = internal::CreateInotifyBackend(watched_path, options.recursive);
+    using_inotify_ = !!backend_;
+  }
+#endif
+  if (!backend_) {
+    if (!DirectoryExists(watched_path.DirName()))
+      return false;
+    backend_ = internal::CreatePollingBackend(watched_path, options.recursive,
+                                              options.poll_interval);
+  }
+
+  options_ = options;
+  callback_ = callback;
+  thread_.reset(new DelegateSimpleThread(this, "FilePathWatcher"));
+  thread_->Start();
+  return true;
+}
+
+void FilePathWatcher::Run() {
+  std::set<FilePath> pending;
+  bool error = false;
+  TimeTicks first_change;
+  TimeTicks last_change;
+  for (;;) {
+    TimeDelta timeout = TimeDelta::Max();
+    if (!pending.empty() || error) {
+      TimeTicks deadline = std::min(last_change + options_.debounce,
+                                    first_change + options_.max_delay);
+      timeout = std::max(deadline - TimeTicks::Now(), TimeDelta());
+    }
+
+    std::vector<FilePath> changed;
+    bool missed = false;
+    if (!backend_->Wait(timeout, &changed, &missed))
+      return;
+
+    TimeTicks now = TimeTicks::Now();
+    if (!changed.empty() || missed) {
+      if (pending.empty() && !error)
+        first_change = now;
+      last_change = now;
+      pending.insert(changed.begin(), changed.end());
+      error |= missed;
+    }
+    if (pending.empty() && !error)
+      continue;
+    if (now < std::min(last_change + options_.debounce,
+                       first_change + options_.max_delay)) {
+      continue;
+    }
+
+    RunCallback(std::vector<FilePath>(pending.begin(), pending.end()), error);
+    pending.clear();
+    error = false;
+  }
+}
+
+void FilePathWatcher::RunCallback(const std::vector<FilePath>& paths,
+                                  bool error) {
+  if (options_.post_task)
+    options_.post_task(std::bind(callback_, paths, error));
+  else
+    callback_(paths, error);
+}
+
+}  // namespace base
@@ -0,0 +1,137 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_FILE_PATH_WATCHER_H_
+#define BASE_FILES_FILE_PATH_WATCHER_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/callback_forward.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace internal {
+
+// Reports changes below a watched path to a FilePathWatcher.
+class FilePathWatcherBackend {
+ public:
+  virtual ~FilePathWatcherBackend() {}
+
+  // Waits up to |timeout|, which may be TimeDelta::Max(), for changes and
+  // appends the paths changed to |changed|. Sets |*error| if changes may
+  // have been missed. Returns false once Cancel() has been called.
+  virtual bool Wait(TimeDelta timeout,
+                    std::vector<FilePath>* changed,
+                    bool* error) = 0;
+
+  // Makes Wait() return false. May be called from any thread.
+  virtual void Cancel() = 0;
+};
+
+// Watches by taking snapshots of the modification times below the path.
+std::unique_ptr<FilePathWatcherBackend> CreatePollingBackend(
+    const FilePath& path,
+    bool recursive,
+    TimeDelta poll_interval);
+
+#if defined(OS_LINUX)
+// Returns NULL if inotify is unavailable or out of watches, or if the
+// directory holding |path| does not exist.
+std::unique_ptr<FilePathWatcherBackend> CreateInotifyBackend(
+    const FilePath& path,
+    bool recursive);
+#endif
+
+}  // namespace internal
+
+// Watches a file or directory and reports when it, or with |recursive|
+// anything below it, is created, deleted, renamed, written or has its
+// attributes changed. Bursts of changes, such as an editor saving a file or
+// a tool unpacking a tree, are collected and reported together once things
+// have been quiet for Options::debounce:
+//
+//   FilePathWatcher watcher;
+//   watcher.Watch(config_dir, true,
+//                 [](const std::vector<FilePath>& paths, bool error) {
+//                   ReloadConfig();
+//                 });
+//
+// The path need not exist yet, but the directory holding it must.
+//
+// On Linux changes are watched with inotify, at no cost while nothing
+// happens. Elsewhere, or when inotify is out of watches, the watcher polls
+// the modification times of everything it watches.
+class BASE_EXPORT FilePathWatcher : public DelegateSimpleThread::Delegate {
+ public:
+  // Receives the paths that changed since the previous call, each once, in
+  // no particular order. A directory's path stands for changes that cannot
+  // be pinned down further. If |error| is set, changes were missed and
+  // everything below the watched path may have changed.
+  typedef std::function<void(const std::vector<FilePath>& paths, bool error)>
+      Callback;
+
+  struct BASE_EXPORT Options {
+    Options();
+    ~Options();
+
+    // Also watches everything below a watched directory.
+    bool recursive;
+
+    // Changes are reported once none has followed for this long...
+    TimeDelta debounce;
+    // ...or once the oldest of them is this old.
+    TimeDelta max_delay;
+
+    // Polls even where inotify is available.
+    bool force_polling;
+    // How often to poll.
+    TimeDelta poll_interval;
+
+    // If set, callbacks are handed to it as tasks rather than run on the
+    // watcher's own thread, e.g. to post them to a MessageLoop.
+    std::function<void(const Closure& task)> post_task;
+  };
+
+  FilePathWatcher();
+
+  // Stops watching. No callback starts after this returns, though tasks
+  // already handed to Options::post_task may still run them.
+  ~FilePathWatcher() override;
+
+  // Starts watching |path|, calling |callback| with each batch of changes.
+  // Returns false if the path cannot be watched. May be called only once.
+  bool Watch(const FilePath& path, bool recursive, const Callback& callback);
+  bool Watch(const FilePath& path,
+             const Options& options,
+             const Callback& callback);
+
+  // Whether changes are watched with inotify rather than polled for.
+  bool using_inotify() const { return using_inotify_; }
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override;
+
+ private:
+  void RunCallback(const std::vector<FilePath>& paths, bool error);
+
+  Options options_;
+  Callback callback_;
+  std::unique_ptr<internal::FilePathWatcherBackend> backend_;
+  bool using_inotify_;
+  std::unique_ptr<DelegateSimpleThread> thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(FilePathWatcher);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_FILE_PATH_WATCHER_H_
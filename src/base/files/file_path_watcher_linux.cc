@@ -0,0 +1,228 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_path_watcher.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdint.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/posix/eintr_wrapper.h"
+
+namespace base {
+
+namespace {
+
+const uint32_t kWatchMask = IN_ATTRIB | IN_CREATE | IN_DELETE |
+                            IN_DELETE_SELF | IN_MODIFY | IN_MOVE_SELF |
+                            IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR |
+                            IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+// Watches the directory holding the path, for the path itself being
+// created, replaced or removed, and the path and what is below it.
+class InotifyBackend : public internal::FilePathWatcherBackend {
+ public:
+  InotifyBackend(const FilePath& path, bool recursive)
+      : path_(path), recursive_(recursive), parent_watch_(-1) {}
+
+  bool Init() {
+    inotify_fd_.reset(inotify_init1(IN_NONBLOCK | IN_CLOEXEC));
+    wakeup_fd_.reset(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+    if (!inotify_fd_.is_valid() || !wakeup_fd_.is_valid())
+      return false;
+    parent_watch_ = inotify_add_watch(inotify_fd_.get(),
+                                      path_.DirName().value().c_str(),
+                                      kWatchMask);
+    if (parent_watch_ < 0)
+      return false;
+    return !DirectoryExists(path_) || AddWatches(path_, NULL);
+  }
+
+  // internal::FilePathWatcherBackend:
+  bool Wait(TimeDelta timeout,
+            std::vector<FilePath>* changed,
+            bool* error) override {
+    struct pollfd fds[] = {{inotify_fd_.get(), POLLIN, 0},
+                           {wakeup_fd_.get(), POLLIN, 0}};
+    int timeout_ms = -1;
+    if (!timeout.is_max()) {
+      timeout_ms = static_cast<int>(
+          std::min<int64_t>(timeout.InMillisecondsRoundedUp(), INT_MAX));
+    }
+    if (HANDLE_EINTR(poll(fds, 2, timeout_ms)) < 0) {
+      DPLOG(ERROR) << "poll";
+      *error = true;
+      return true;
+    }
+    if (fds[1].revents)
+      return false;
+    if (fds[0].revents)
+      ReadEvents(changed, error);
+    return true;
+  }
+
+  void Cancel() override {
+    uint64_t one = 1;
+    ignore_result(HANDLE_EINTR(write(wakeup_fd_.get(), &one, sizeof(one))));
+  }
+
+ private:
+  void ReadEvents(std::vector<FilePath>* changed, bool* error) {
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    for (;;) {
+      ssize_t length = HANDLE_EINTR(read(inotify_fd_.get(), buffer,
+                                         sizeof(buffer)));
+      if (length <= 0)
+        return;
+      for (char* event = buffer; event < buffer + length;) {
+        const struct inotify_event* inotify_event =
+            reinterpret_cast<const struct inotify_event*>(event);
+        HandleEvent(*inotify_event, changed, error);
+        event += sizeof(struct inotify_event) + inotify_event->len;
+      }
+    }
+  }
+
+  void HandleEvent(const struct inotify_event& event,
+                   std::vector<FilePath>* changed,
+                   bool* error) {
+    if (event.mask & IN_Q_OVERFLOW) {
+      *error = true;
+      return;
+    }
+
+    FilePath path;
+    if (event.wd == parent_watch_) {
+      // The parent itself going away leaves nothing to watch.
+      if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+        *error = true;
+        return;
+      }
+      if (!event.len || FilePath(event.name) != path_.BaseName())
+        return;
+      path = path_;
+    } else {
+      auto it = paths_by_watch_.find(event.wd);
+      if (it == paths_by_watch_.end())
+        return;
+      if (event.mask & IN_IGNORED) {
+        // The path may be watched anew by now.
+        auto watch = watches_by_path_.find(it->second);
+        if (watch != watches_by_path_.end() && watch->second == event.wd)
+          watches_by_path_.erase(watch);
+        paths_by_watch_.erase(it);
+        return;
+      }
+      path = event.len ? it->second.Append(event.name) : it->second;
+    }
+    changed->push_back(path);
+
+    if (!(event.mask & IN_ISDIR))
+      return;
+    // Directories moved away must no longer be reported under their old
+    // path, and those moved in must be watched too.
+    if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+      RemoveWatches(path);
+    if ((event.mask & (IN_CREATE | IN_MOVED_TO)) &&
+        (path == path_ || recursive_) && !AddWatches(path, changed)) {
+      *error = true;
+    }
+  }
+
+  // Watches |directory| and, if |recursive_|, every directory below it.
+  // Appends the entries found below it to |found| if it is not NULL, since
+  // those created before the watches were added would otherwise go unseen.
+  // Returns false if out of watches.
+  bool AddWatches(const FilePath& directory, std::vector<FilePath>* found) {
+    if (!AddWatch(directory))
+      return false;
+    if (!recursive_ && !found)
+      return true;
+    FileEnumerator enumerator(directory, recursive_,
+                              FileEnumerator::FILES |
+                                  FileEnumerator::DIRECTORIES |
+                                  FileEnumerator::SHOW_SYM_LINKS);
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      if (recursive_ && enumerator.GetInfo().IsDirectory() &&
+          !AddWatch(path)) {
+        return false;
+      }
+      if (found)
+        found->push_back(path);
+    }
+    return true;
+  }
+
+  bool AddWatch(const FilePath& directory) {
+    int watch = inotify_add_watch(inotify_fd_.get(),
+                                  directory.value().c_str(), kWatchMask);
+    if (watch < 0) {
+      // A directory already gone is reported by its parent's watch.
+      if (errno == ENOENT || errno == ENOTDIR)
+        return true;
+      DPLOG(ERROR) << "inotify_add_watch " << directory.value();
+      return false;
+    }
+    paths_by_watch_[watch] = directory;
+    watches_by_path_[directory] = watch;
+    return true;
+  }
+
+  void RemoveWatches(const FilePath& directory) {
+    for (auto it = watches_by_path_.begin(); it != watches_by_path_.end();) {
+      if (it->first == directory || directory.IsParent(it->first)) {
+        inotify_rm_watch(inotify_fd_.get(), it->second);
+        paths_by_watch_.erase(it->second);
+        it = watches_by_path_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  const FilePath path_;
+  const bool recursive_;
+
+  ScopedFD inotify_fd_;
+  // Written to by Cancel().
+  ScopedFD wakeup_fd_;
+
+  int parent_watch_;
+  std::unordered_map<int, FilePath> paths_by_watch_;
+  std::map<FilePath, int> watches_by_path_;
+
+  DISALLOW_COPY_AND_ASSIGN(InotifyBackend);
+};
+
+}  // namespace
+
+namespace internal {
+
+std::unique_ptr<FilePathWatcherBackend> CreateInotifyBackend(
+    const FilePath& path,
+    bool recursive) {
+  std::unique_ptr<InotifyBackend> backend(new InotifyBackend(path, recursive));
+  if (!backend->Init())
+    return NULL;
+  return backend;
+}
+
+}  // namespace internal
+
+}  // namespace base
@@ -7,9 +7,14 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <stdint.h>
+#include <limits.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <vector>
+
 #include "base/logging.h"
 #include "base/posix/eintr_wrapper.h"
 #include "base/strings/utf_string_conversions.h"
@@ -79,6 +84,122 @@ File::Error CallFcntlFlock(PlatformFile file, bool do_lock) {
     return File::OSErrorToFileError(errno);
   return File::FILE_OK;
 }
+
+#if defined(OS_LINUX) && defined(__GLIBC_PREREQ)
+#if __GLIBC_PREREQ(2, 26)
+#define HAS_PREADV2
+#endif
+#endif
+
+#if defined(HAS_PREADV2)
+int ToRWFlags(int flags) {
+  return ((flags & File::IO_NOWAIT) ? RWF_NOWAIT : 0) |
+         ((flags & File::IO_DSYNC) ? RWF_DSYNC : 0);
+}
+#endif
+
+// Transfers at the current position if |offset| is -1.
+ssize_t CallPreadv(PlatformFile file,
+                   const struct iovec* iov,
+                   int count,
+                   int64_t offset,
+                   int flags) {
+#if defined(HAS_PREADV2)
+  return HANDLE_EINTR(preadv2(file, iov, count, offset, ToRWFlags(flags)));
+#else
+  if (flags & File::IO_NOWAIT) {
+    errno = EOPNOTSUPP;
+    return -1;
+  }
+  return HANDLE_EINTR(offset == -1 ? readv(file, iov, count)
+                                   : preadv(file, iov, count, offset));
+#endif
+}
+
+ssize_t CallPwritev(PlatformFile file,
+                    const struct iovec* iov,
+                    int count,
+                    int64_t offset,
+                    int flags) {
+#if defined(HAS_PREADV2)
+  return HANDLE_EINTR(pwritev2(file, iov, count, offset, ToRWFlags(flags)));
+#else
+  ssize_t rv = HANDLE_EINTR(offset == -1 ? writev(file, iov, count)
+                                         : pwritev(file, iov, count, offset));
+  if (rv > 0 && (flags & File::IO_DSYNC) && HANDLE_EINTR(fsync(file)))
+    return -1;
+  return rv;
+#endif
+}
+
+bool CallFallocate(PlatformFile file,
+                   int64_t offset,
+                   int64_t length,
+                   bool keep_size) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  return !HANDLE_EINTR(
+      fallocate(file, keep_size ? FALLOC_FL_KEEP_SIZE : 0, offset, length));
+#elif defined(OS_MACOSX)
+  if (keep_size)
+    return false;
+  // Space can only be reserved past the end of the file.
+  struct stat stat_buf;
+  if (fstat(file, &stat_buf))
+    return false;
+  int64_t end = offset + length;
+  if (end <= stat_buf.st_size)
+    return true;
+  fstore_t store = {F_ALLOCATEALL, F_PEOFPOSMODE, 0, end - stat_buf.st_size,
+                    0};
+  if (HANDLE_EINTR(fcntl(file, F_PREALLOCATE, &store)) == -1)
+    return false;
+  return !HANDLE_EINTR(ftruncate(file, end));
+#else
+  if (keep_size)
+    return false;
+  return !posix_fallocate(file, offset, length);
+#endif
+}
+
+bool CallFadvise(PlatformFile file,
+                 int64_t offset,
+                 int64_t length,
+                 File::Advice advice) {
+#if defined(OS_MACOSX)
+  if (advice != File::ADVICE_WILL_NEED)
+    return false;
+  struct stat stat_buf;
+  if (!length) {
+    if (fstat(file, &stat_buf))
+      return false;
+    length = std::max<int64_t>(stat_buf.st_size - offset, 0);
+  }
+  struct radvisory radvisory = {
+      offset, static_cast<int>(std::min<int64_t>(length, INT_MAX))};
+  return HANDLE_EINTR(fcntl(file, F_RDADVISE, &radvisory)) != -1;
+#else
+  int posix_advice = POSIX_FADV_NORMAL;
+  switch (advice) {
+    case File::ADVICE_NORMAL:
+      posix_advice = POSIX_FADV_NORMAL;
+      break;
+    case File::ADVICE_SEQUENTIAL:
+      posix_advice = POSIX_FADV_SEQUENTIAL;
+      break;
+    case File::ADVICE_RANDOM:
+      posix_advice = POSIX_FADV_RANDOM;
+      break;
+    case File::ADVICE_WILL_NEED:
+      posix_advice = POSIX_FADV_WILLNEED;
+      break;
+    case File::ADVICE_DONT_NEED:
+      posix_advice = POSIX_FADV_DONTNEED;
+      break;
+  }
+  // Returns the error rather than setting errno.
+  return !posix_fadvise(file, offset, length, posix_advice);
+#endif
+}
 #else  // defined(OS_NACL)
 
 bool IsOpenAppend(PlatformFile file) {
@@ -102,8 +223,80 @@ File::Error CallFcntlFlock(PlatformFile file, bool do_lock) {
   NOTIMPLEMENTED();  // NaCl doesn't implement flock struct.
   return File::FILE_ERROR_INVALID_OPERATION;
 }
+
+ssize_t CallPreadv(PlatformFile file,
+                   const struct iovec* iov,
+                   int count,
+                   int64_t offset,
+                   int flags) {
+  NOTIMPLEMENTED();  // NaCl doesn't implement preadv.
+  errno = ENOSYS;
+  return -1;
+}
+
+ssize_t CallPwritev(PlatformFile file,
+                    const struct iovec* iov,
+                    int count,
+                    int64_t offset,
+                    int flags) {
+  NOTIMPLEMENTED();  // NaCl doesn't implement pwritev.
+  errno = ENOSYS;
+  return -1;
+}
+
+bool CallFallocate(PlatformFile file,
+                   int64_t offset,
+                   int64_t length,
+                   bool keep_size) {
+  return false;
+}
+
+bool CallFadvise(PlatformFile file,
+                 int64_t offset,
+                 int64_t length,
+                 File::Advice advice) {
+  return false;
+}
 #endif  // defined(OS_NACL)
 
+// Transfers the buffers of |iov| until all are done, the end of the file or
+// an error, or, with IO_NOWAIT, any short transfer. An |offset| of -1 uses
+// the current position.
+int64_t TransferV(PlatformFile file,
+                  bool write,
+                  int64_t offset,
+                  const struct iovec* iov,
+                  int count,
+                  int flags) {
+  // Holds what is left of |iov| after a short transfer.
+  std::vector<struct iovec> remaining;
+  int64_t total = 0;
+  for (;;) {
+    int batch = std::min(count, IOV_MAX);
+    int64_t position = offset == -1 ? -1 : offset + total;
+    ssize_t rv = write ? CallPwritev(file, iov, batch, position, flags)
+                       : CallPreadv(file, iov, batch, position, flags);
+    if (rv <= 0)
+      return total ? total : rv;
+    total += rv;
+
+    size_t done = rv;
+    while (count && done >= iov->iov_len) {
+      done -= iov->iov_len;
+      ++iov;
+      --count;
+    }
+    if (!count || (flags & File::IO_NOWAIT))
+      return total;
+    if (done) {
+      remaining = std::vector<struct iovec>(iov, iov + count);
+      remaining[0].iov_base = static_cast<char*>(remaining[0].iov_base) + done;
+      remaining[0].iov_len -= done;
+      iov = remaining.data();
+    }
+  }
+}
+
 }  // namespace
 
 void File::Info::FromStat(const stat_wrapper_t& stat_info) {
@@ -313,6 +506,51 @@ int File::WriteAtCurrentPosNoBestEffort(const char* data, int size) {
   return HANDLE_EINTR(write(file_.get(), data, size));
 }
 
+int64_t File::ReadV(int64_t offset,
+                    const struct iovec* iov,
+                    int count,
+                    int flags) {
+  ThreadRestrictions::AssertIOAllowed();
+  DCHECK(IsValid());
+  DCHECK(!(flags & IO_DSYNC));
+  if (count < 0 || offset < 0)
+    return -1;
+
+  SCOPED_FILE_TRACE("ReadV");
+  return TransferV(file_.get(), false, offset, iov, count, flags);
+}
+
+int64_t File::WriteV(int64_t offset,
+                     const struct iovec* iov,
+                     int count,
+                     int flags) {
+  ThreadRestrictions::AssertIOAllowed();
+  DCHECK(IsValid());
+  DCHECK(!(flags & IO_NOWAIT));
+  if (count < 0 || offset < 0)
+    return -1;
+
+  SCOPED_FILE_TRACE("WriteV");
+  if (IsOpenAppend(file_.get()))
+    offset = -1;
+  return TransferV(file_.get(), true, offset, iov, count, flags);
+}
+
+bool File::Preallocate(int64_t offset, int64_t length, bool keep_size) {
+  ThreadRestrictions::AssertIOAllowed();
+  DCHECK(IsValid());
+
+  SCOPED_FILE_TRACE_WITH_SIZE("Preallocate", length);
+  return CallFallocate(file_.get(), offset, length, keep_size);
+}
+
+bool File::Advise(int64_t offset, int64_t length, Advice advice) {
+  DCHECK(IsValid());
+
+  SCOPED_FILE_TRACE_WITH_SIZE("Advise", length);
+  return CallFadvise(file_.get(), offset, length, advice);
+}
+
 int64_t File::GetLength() {
   DCHECK(IsValid());
 
@@ -467,6 +705,11 @@ void File::DoInitialize(const FilePath& path, uint32_t flags) {
   if (flags & FLAG_TERMINAL_DEVICE)
     open_flags |= O_NOCTTY | O_NDELAY;
 
+#if defined(O_DIRECT)
+  if (flags & FLAG_DIRECT)
+    open_flags |= O_DIRECT;
+#endif
+
   if (flags & FLAG_APPEND && flags & FLAG_READ)
     open_flags |= O_APPEND | O_RDWR;
   else if (flags & FLAG_APPEND)
@@ -504,6 +747,11 @@ void File::DoInitialize(const FilePath& path, uint32_t flags) {
   if (flags & FLAG_DELETE_ON_CLOSE)
     unlink(path.value().c_str());
 
+#if defined(OS_MACOSX)
+  if (flags & FLAG_DIRECT)
+    fcntl(descriptor, F_NOCACHE, 1);
+#endif
+
   async_ = ((flags & FLAG_ASYNC) == FLAG_ASYNC);
   error_details_ = FILE_OK;
   file_.reset(descriptor);
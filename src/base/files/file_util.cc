@@ -9,18 +9,25 @@
 #endif
 #include <stdio.h>
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
+#include <memory>
 
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "build/build_config.h"
 
+#if defined(OS_LINUX)
+#include "base/files/parallel_file_enumerator.h"
+#endif
+
 namespace base {
 
 #if !defined(OS_NACL_NONSFI)
@@ -37,7 +44,15 @@ static const int kMaxUniqueFiles = 100;
 
 int64_t ComputeDirectorySize(const FilePath& root_path) {
   int64_t running_size = 0;
+#if defined(OS_LINUX)
+  // Reads the directories on several threads and fetches only the sizes.
+  ParallelFileEnumerator::Options options;
+  options.stat_fields = ParallelFileEnumerator::STAT_SIZE;
+  ParallelFileEnumerator file_iter(root_path, true, FileEnumerator::FILES,
+                                   options);
+#else
   FileEnumerator file_iter(root_path, true, FileEnumerator::FILES);
+#endif
   while (!file_iter.Next().empty())
     running_size += file_iter.GetInfo().GetSize();
   return running_size;
@@ -126,6 +141,64 @@ bool TextContentsEqual(const FilePath& filename1, const FilePath& filename2) {
 #endif  // !defined(OS_WIN)
 #endif  // !defined(OS_NACL_NONSFI)
 
+namespace {
+
+char* WritableData(std::string* buffer) {
+  return &(*buffer)[0];
+}
+
+char* WritableData(std::vector<unsigned char>* buffer) {
+  return reinterpret_cast<char*>(buffer->data());
+}
+
+// Reads |file| into |buffer|, a std::string or a std::vector<unsigned char>,
+// as ReadFileToString() describes.
+template <typename Buffer>
+bool ReadFileToBufferWithMaxSize(File* file, Buffer* buffer, size_t max_size) {
+  // Reading max_size + 1 bytes tells whether the file is larger.
+  const size_t read_limit = max_size == std::numeric_limits<size_t>::max()
+                                ? max_size
+                                : max_size + 1;
+  const size_t kMaxReadSize = std::numeric_limits<int>::max();
+
+  // The size is only a guess: files in procfs and sysfs report 0, and files
+  // may grow or shrink while being read. With a correct size the contents
+  // arrive in a single read, the one extra byte confirming the end.
+  int64_t length = file->GetLength();
+  size_t capacity = 4096;
+  if (length > 0 && static_cast<uint64_t>(length) < read_limit)
+    capacity = static_cast<size_t>(length) + 1;
+  capacity = std::min(capacity, read_limit);
+
+  size_t size = 0;
+  bool read_status = true;
+  for (;;) {
+    buffer->resize(capacity);
+    int request = static_cast<int>(std::min(capacity - size, kMaxReadSize));
+    // ReadAtCurrentPos() only returns less than |request| at the end of the
+    // file or on an error.
+    int bytes_read = file->ReadAtCurrentPos(WritableData(buffer) + size,
+                                            request);
+    if (bytes_read < 0) {
+      read_status = false;
+      break;
+    }
+    size += bytes_read;
+    if (bytes_read < request)
+      break;
+    if (size == read_limit) {
+      read_status = size <= max_size;
+      break;
+    }
+    if (size == capacity)
+      capacity = capacity > read_limit / 2 ? read_limit : capacity * 2;
+  }
+  buffer->resize(std::min(size, max_size));
+  return read_status;
+}
+
+}  // namespace
+
 bool ReadFileToString(const FilePath& path,
                       std::string* contents,
                       size_t max_size) {
@@ -133,40 +206,46 @@ bool ReadFileToString(const FilePath& path,
     contents->clear();
   if (path.ReferencesParent())
     return false;
-  FILE* file = OpenFile(path, "rb");
-  if (!file) {
+  File file(path, File::FLAG_OPEN | File::FLAG_READ);
+  if (!file.IsValid())
     return false;
-  }
-
-  const size_t kBufferSize = 1 << 16;
-  scoped_ptr<char[]> buf(new char[kBufferSize]);
-  size_t len;
-  size_t size = 0;
-  bool read_status = true;
 
-  // Many files supplied in |path| have incorrect size (proc files etc).
-  // Hence, the file is read sequentially as opposed to a one-shot read.
-  while ((len = fread(buf.get(), 1, kBufferSize, file)) > 0) {
-    if (contents)
-      contents->append(buf.get(), std::min(len, max_size - size));
-
-    if ((max_size - size) < len) {
-      read_status = false;
-      break;
-    }
+  if (contents)
+    return ReadFileToBufferWithMaxSize(&file, contents, max_size);
 
+  // Only priming the disk cache, so the contents need not be kept.
+  const int kBufferSize = 1 << 16;
+  std::unique_ptr<char[]> buf(new char[kBufferSize]);
+  size_t size = 0;
+  int len;
+  while ((len = file.ReadAtCurrentPos(buf.get(), kBufferSize)) > 0) {
+    if (max_size - size < static_cast<size_t>(len))
+      return false;
     size += len;
   }
-  read_status = read_status && !ferror(file);
-  CloseFile(file);
-
-  return read_status;
+  return len == 0;
 }
 
 bool ReadFileToString(const FilePath& path, std::string* contents) {
   return ReadFileToString(path, contents, std::numeric_limits<size_t>::max());
 }
 
+bool ReadFileToBuffer(const FilePath& path,
+                      RefCountedBytes* buffer,
+                      size_t max_size) {
+  buffer->data().clear();
+  if (path.ReferencesParent())
+    return false;
+  File file(path, File::FLAG_OPEN | File::FLAG_READ);
+  if (!file.IsValid())
+    return false;
+  return ReadFileToBufferWithMaxSize(&file, &buffer->data(), max_size);
+}
+
+bool ReadFileToBuffer(const FilePath& path, RefCountedBytes* buffer) {
+  return ReadFileToBuffer(path, buffer, std::numeric_limits<size_t>::max());
+}
+
 #if !defined(OS_NACL_NONSFI)
 bool IsDirectoryEmpty(const FilePath& dir_path) {
   FileEnumerator files(dir_path, false,
@@ -38,6 +38,7 @@
 
 namespace base {
 
+class RefCountedBytes;
 class Time;
 
 //-----------------------------------------------------------------------------
@@ -51,8 +52,9 @@ BASE_EXPORT FilePath MakeAbsoluteFilePath(const FilePath& input);
 // Returns the total number of bytes used by all the files under |root_path|.
 // If the path does not exist the function returns 0.
 //
-// This function is implemented using the FileEnumerator class so it is not
-// particularly speedy in any platform.
+// On Linux this reads directories in parallel and stats only file sizes;
+// elsewhere it uses FileEnumerator and is not particularly speedy. Symbolic
+// links to directories are not followed on Linux.
 BASE_EXPORT int64_t ComputeDirectorySize(const FilePath& root_path);
 
 // Deletes the given path, whether it's a file or a directory.
@@ -116,6 +118,16 @@ BASE_EXPORT bool CopyDirectory(const FilePath& from_path,
                                const FilePath& to_path,
                                bool recursive);
 
+#if defined(OS_POSIX)
+// Same as CopyDirectory, but copies up to |max_parallel_copies| files at a
+// time. CopyDirectory picks a count from the number of processors; a count of
+// 1 copies every file on the calling thread.
+BASE_EXPORT bool CopyDirectoryWithParallelism(const FilePath& from_path,
+                                              const FilePath& to_path,
+                                              bool recursive,
+                                              int max_parallel_copies);
+#endif  // defined(OS_POSIX)
+
 // Returns true if the given path exists on the local filesystem,
 // false otherwise.
 BASE_EXPORT bool PathExists(const FilePath& path);
@@ -158,6 +170,15 @@ BASE_EXPORT bool ReadFileToString(const FilePath& path,
                                   std::string* contents,
                                   size_t max_size);
 
+// Same as ReadFileToString, but reads into |buffer|'s data(), which ends up
+// the size of the contents. The result can then be shared as RefCountedMemory
+// without a copy.
+BASE_EXPORT bool ReadFileToBuffer(const FilePath& path,
+                                  RefCountedBytes* buffer);
+BASE_EXPORT bool ReadFileToBuffer(const FilePath& path,
+                                  RefCountedBytes* buffer,
+                                  size_t max_size);
+
 #if defined(OS_POSIX)
 
 // Read exactly |bytes| bytes from file descriptor |fd|, storing the result
@@ -426,6 +447,17 @@ namespace internal {
 BASE_EXPORT bool MoveUnsafe(const FilePath& from_path,
                             const FilePath& to_path);
 
+#if defined(OS_LINUX)
+// Copies the rest of |infile| to |outfile| without passing the data through
+// user space: with copy_file_range(), a FICLONE reflink, or sendfile(),
+// whichever the file systems support. Returns false on an I/O error.
+// Otherwise sets |*copied_all| if the copy reached the end of |infile|, and
+// leaves both file positions after the bytes copied so far.
+BASE_EXPORT bool CopyFileContentsInKernel(File* infile,
+                                          File* outfile,
+                                          bool* copied_all);
+#endif  // defined(OS_LINUX)
+
 #if defined(OS_WIN)
 // Copy from_path to to_path recursively and then delete from_path recursively.
 // Returns true if all operations succeed.
@@ -5,10 +5,17 @@
 #include "base/files/file_util.h"
 
 #include <errno.h>
+#include <linux/fs.h>
 #include <linux/magic.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/vfs.h>
+#include <unistd.h>
 
 #include "base/files/file_path.h"
+#include "base/posix/eintr_wrapper.h"
 
 namespace base {
 
@@ -60,4 +67,87 @@ bool GetFileSystemType(const FilePath& path, FileSystemType* type) {
   return true;
 }
 
+namespace internal {
+
+namespace {
+
+// The most either system call moves at once.
+const size_t kMaxKernelCopySize = 0x7ffff000;
+
+ssize_t CopyFileRange(int in_fd, int out_fd, size_t size) {
+#if defined(__NR_copy_file_range)
+  return syscall(__NR_copy_file_range, in_fd, NULL, out_fd, NULL, size, 0);
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+// Whether |error| means the mechanism does not apply to these files, e.g.
+// because they are on different file systems or the kernel is too old,
+// rather than that the copy failed.
+bool IsUnsupportedCopy(int error) {
+  return error == ENOSYS || error == EXDEV || error == EINVAL ||
+         error == EOPNOTSUPP;
+}
+
+}  // namespace
+
+bool CopyFileContentsInKernel(File* infile, File* outfile, bool* copied_all) {
+  *copied_all = false;
+  int in_fd = infile->GetPlatformFile();
+  int out_fd = outfile->GetPlatformFile();
+
+  // Files in procfs and sysfs claim a size of zero and may copy as empty in
+  // the kernel, so those are left to a read() loop.
+  struct stat in_stat;
+  if (fstat(in_fd, &in_stat) != 0 || !S_ISREG(in_stat.st_mode) ||
+      in_stat.st_size == 0) {
+    return true;
+  }
+
+  // copy_file_range() lets the file system share extents or copy on the
+  // server, and otherwise copies within the page cache.
+  int64_t copied = 0;
+  for (;;) {
+    ssize_t result =
+        HANDLE_EINTR(CopyFileRange(in_fd, out_fd, kMaxKernelCopySize));
+    if (result > 0) {
+      copied += result;
+      continue;
+    }
+    if (result == 0 && copied > 0) {
+      *copied_all = true;
+      return true;
+    }
+    if (result < 0 && !IsUnsupportedCopy(errno))
+      return false;
+    break;
+  }
+
+#if defined(FICLONE)
+  // A reflink clones the whole file, so it only applies before anything was
+  // copied and from the start.
+  if (copied == 0 && lseek(in_fd, 0, SEEK_CUR) == 0 &&
+      lseek(out_fd, 0, SEEK_CUR) == 0 && ioctl(out_fd, FICLONE, in_fd) == 0) {
+    *copied_all = true;
+    return true;
+  }
+#endif
+
+  for (;;) {
+    ssize_t result =
+        HANDLE_EINTR(sendfile(out_fd, in_fd, NULL, kMaxKernelCopySize));
+    if (result > 0)
+      continue;
+    if (result == 0) {
+      *copied_all = true;
+      return true;
+    }
+    return IsUnsupportedCopy(errno);
+  }
+}
+
+}  // namespace internal
+
 }  // namespace base
@@ -22,11 +22,17 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <utility>
+
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/scoped_file.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/aligned_memory.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/singleton.h"
 #include "base/path_service.h"
@@ -36,7 +42,9 @@
 #include "base/strings/stringprintf.h"
 #include "base/strings/sys_string_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
@@ -183,6 +191,72 @@ bool DetermineDevShmExecutable() {
   return result;
 }
 #endif  // defined(OS_LINUX)
+
+// Copies the files CopyDirectory() finds on a DelegateSimpleThreadPool, which
+// it starts with the first file. Each AddWork() of this delegate copies one
+// queued file.
+class ParallelFileCopier : public DelegateSimpleThread::Delegate {
+ public:
+  explicit ParallelFileCopier(int num_threads)
+      : pool_("CopyDirectory", num_threads), started_(false), failed_(false) {}
+
+  ~ParallelFileCopier() override { DCHECK(!started_); }
+
+  void Copy(const FilePath& from_path, const FilePath& to_path) {
+    {
+      AutoLock lock(lock_);
+      copies_.push(std::make_pair(from_path, to_path));
+    }
+    pool_.AddWork(this);
+    if (!started_) {
+      pool_.Start();
+      started_ = true;
+    }
+  }
+
+  // Waits for the queued copies. Returns false if any failed.
+  bool Finish() {
+    if (started_) {
+      pool_.JoinAll();
+      started_ = false;
+    }
+    return !failed();
+  }
+
+  bool failed() {
+    AutoLock lock(lock_);
+    return failed_;
+  }
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override {
+    std::pair<FilePath, FilePath> copy;
+    {
+      AutoLock lock(lock_);
+      // Once a copy failed the rest are skipped; CopyDirectory() fails.
+      if (failed_)
+        return;
+      copy = copies_.front();
+      copies_.pop();
+    }
+    if (!CopyFile(copy.first, copy.second)) {
+      DLOG(ERROR) << "CopyDirectory() couldn't create file: "
+                  << copy.second.value();
+      AutoLock lock(lock_);
+      failed_ = true;
+    }
+  }
+
+ private:
+  DelegateSimpleThreadPool pool_;
+  bool started_;
+
+  Lock lock_;
+  std::queue<std::pair<FilePath, FilePath>> copies_;
+  bool failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelFileCopier);
+};
 #endif  // !defined(OS_NACL_NONSFI)
 
 }  // namespace
@@ -251,7 +325,19 @@ bool ReplaceFile(const FilePath& from_path,
 bool CopyDirectory(const FilePath& from_path,
                    const FilePath& to_path,
                    bool recursive) {
+  // Copies mostly wait on the disk, but too many at once compete for it.
+  const int kMaxParallelCopies = 8;
+  return CopyDirectoryWithParallelism(
+      from_path, to_path, recursive,
+      std::min(SysInfo::NumberOfProcessors(), kMaxParallelCopies));
+}
+
+bool CopyDirectoryWithParallelism(const FilePath& from_path,
+                                  const FilePath& to_path,
+                                  bool recursive,
+                                  int max_parallel_copies) {
   ThreadRestrictions::AssertIOAllowed();
+  DCHECK_GT(max_parallel_copies, 0);
   // Some old callers of CopyDirectory want it to support wildcards.
   // After some discussion, we decided to fix those callers.
   // Break loudly here if anyone tries to do this.
@@ -310,6 +396,12 @@ bool CopyDirectory(const FilePath& from_path,
   // TODO(maruel): This is not necessary anymore.
   DCHECK(recursive || S_ISDIR(from_stat.st_mode));
 
+  // Directories are created on this thread in the order the traversal finds
+  // them, so each exists before the files in it are copied.
+  std::unique_ptr<ParallelFileCopier> copier;
+  if (max_parallel_copies > 1)
+    copier.reset(new ParallelFileCopier(max_parallel_copies));
+
   bool success = true;
   while (success && !current.empty()) {
     // current is the source path, including from_path, so append
@@ -332,7 +424,10 @@ bool CopyDirectory(const FilePath& from_path,
         success = false;
       }
     } else if (S_ISREG(from_stat.st_mode)) {
-      if (!CopyFile(current, target_path)) {
+      if (copier) {
+        copier->Copy(current, target_path);
+        success = !copier->failed();
+      } else if (!CopyFile(current, target_path)) {
         DLOG(ERROR) << "CopyDirectory() couldn't create file: "
                     << target_path.value();
         success = false;
@@ -347,6 +442,8 @@ bool CopyDirectory(const FilePath& from_path,
       from_stat = traversal.GetInfo().stat();
   }
 
+  if (copier && !copier->Finish())
+    success = false;
   return success;
 }
 #endif  // !defined(OS_NACL_NONSFI)
@@ -873,32 +970,29 @@ bool CopyFile(const FilePath& from_path, const FilePath& to_path) {
   if (!outfile.IsValid())
     return false;
 
-  const size_t kBufferSize = 32768;
-  std::vector<char> buffer(kBufferSize);
-  bool result = true;
+#if defined(OS_LINUX)
+  bool copied_all = false;
+  if (!internal::CopyFileContentsInKernel(&infile, &outfile, &copied_all))
+    return false;
+  if (copied_all)
+    return true;
+#endif
 
-  while (result) {
-    ssize_t bytes_read = infile.ReadAtCurrentPos(&buffer[0], buffer.size());
-    if (bytes_read < 0) {
-      result = false;
-      break;
-    }
+  // Large transfers keep the number of system calls down; page alignment
+  // lets the kernel copy whole pages.
+  const size_t kBufferSize = 1024 * 1024;
+  std::unique_ptr<char, AlignedFreeDeleter> buffer(
+      static_cast<char*>(AlignedAlloc(kBufferSize, 4096)));
+  for (;;) {
+    int bytes_read = infile.ReadAtCurrentPos(buffer.get(), kBufferSize);
+    if (bytes_read < 0)
+      return false;
     if (bytes_read == 0)
-      break;
-    // Allow for partial writes
-    ssize_t bytes_written_per_read = 0;
-    do {
-      ssize_t bytes_written_partial = outfile.WriteAtCurrentPos(
-          &buffer[bytes_written_per_read], bytes_read - bytes_written_per_read);
-      if (bytes_written_partial < 0) {
-        result = false;
-        break;
-      }
-      bytes_written_per_read += bytes_written_partial;
-    } while (bytes_written_per_read < bytes_read);
+      return true;
+    // WriteAtCurrentPos() retries partial writes.
+    if (outfile.WriteAtCurrentPos(buffer.get(), bytes_read) != bytes_read)
+      return false;
   }
-
-  return result;
 }
 #endif  // !defined(OS_MACOSX)
 
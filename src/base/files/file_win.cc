@@ -379,6 +379,8 @@ void File::DoInitialize(const FilePath& path, uint32_t flags) {
     create_flags |= FILE_FLAG_BACKUP_SEMANTICS;
   if (flags & FLAG_SEQUENTIAL_SCAN)
     create_flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+  if (flags & FLAG_DIRECT)
+    create_flags |= FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH;
 
   file_.Set(CreateFile(path.value().c_str(), access, sharing, NULL,
                        disposition, create_flags, NULL));
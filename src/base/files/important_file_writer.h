@@ -0,0 +1,131 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_IMPORTANT_FILE_WRITER_H_
+#define BASE_FILES_IMPORTANT_FILE_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// Writes files so that a crash or power loss leaves each one with either its
+// old or its new contents, never a mix. The contents go to a temporary file
+// in the same directory, which is synced to disk and then renamed over the
+// target; the directory is synced last so the rename itself survives. A
+// replaced file keeps its permissions, and a new one gets those open() would
+// give it.
+//
+// WriteFileAtomically() does all of this for one file, at the cost of two
+// disk flushes. Programs saving many small files should instead schedule the
+// writes on an ImportantFileWriter, which commits them in batches: each
+// batch writes every temporary file, flushes them together, renames them
+// all, and then syncs each directory involved once.
+//
+//   ImportantFileWriter writer;
+//   writer.ScheduleWrite(state_path, SerializeState(), callback);
+//   ...
+//   writer.CommitPendingWrites();  // Everything above is now on disk.
+//
+// Only available on POSIX.
+class BASE_EXPORT ImportantFileWriter
+    : public DelegateSimpleThread::Delegate {
+ public:
+  // Receives whether the write is known to have reached the disk.
+  typedef std::function<void(bool success)> WriteCallback;
+
+  struct BASE_EXPORT Options {
+    Options();
+
+    // How long a scheduled write may wait for others to join its batch.
+    TimeDelta commit_interval;
+
+    // A batch is committed early once this many files are pending.
+    size_t max_batch_size;
+
+    // On Linux, flushes each batch with one syncfs() per file system rather
+    // than an fdatasync() per file. syncfs() also flushes data other
+    // programs have written to the same file system.
+    bool sync_file_system;
+  };
+
+  // Writes |data| to |path| and waits until both the contents and the new
+  // directory entry are on disk. Returns false if any step fails, in which
+  // case |path| is left as it was or, if only the final directory sync
+  // failed, holds |data| without the guarantee of surviving a crash.
+  static bool WriteFileAtomically(const FilePath& path, StringPiece data);
+
+  ImportantFileWriter();
+  explicit ImportantFileWriter(const Options& options);
+
+  // Commits the writes still pending.
+  ~ImportantFileWriter() override;
+
+  // Schedules |data| to be written to |path| in an upcoming batch. A later
+  // write to the same path replaces a pending one; the callbacks of both
+  // then receive the result of the later write. |callback|, which may be
+  // null, runs on the writer's thread. May be called from any thread.
+  void ScheduleWrite(const FilePath& path,
+                     std::string data,
+                     const WriteCallback& callback);
+
+  // Commits the pending writes now and waits until every write scheduled
+  // before the call has been committed.
+  void CommitPendingWrites();
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override;
+
+ private:
+  struct PendingWrite {
+    std::string data;
+    std::vector<WriteCallback> callbacks;
+  };
+  typedef std::map<FilePath, PendingWrite> Batch;
+
+  void CommitBatch(Batch* batch);
+
+  const Options options_;
+
+  Lock lock_;
+  // Signaled when writes are scheduled, a commit is requested or the writer
+  // shuts down.
+  ConditionVariable work_available_;
+  // Broadcast when a batch has been committed.
+  ConditionVariable batch_committed_;
+
+  Batch pending_;
+  // When the oldest pending write was scheduled.
+  TimeTicks first_pending_time_;
+  // Writes are numbered as they are scheduled. Every write up to
+  // |committed_| has been committed, and CommitPendingWrites() is waiting
+  // for those up to |commit_requested_|.
+  uint64_t scheduled_;
+  uint64_t committed_;
+  uint64_t commit_requested_;
+  bool shutting_down_;
+
+  std::unique_ptr<DelegateSimpleThread> thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImportantFileWriter);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_IMPORTANT_FILE_WRITER_H_
@@ -0,0 +1,295 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/important_file_writer.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/thread_restrictions.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace {
+
+// Of fixed length, so that any name that fits the directory can be written.
+const char kTempFileName[] = ".important_file.XXXXXX";
+
+// Returns the process's file mode creation mask.
+mode_t GetUmask() {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Linux 4.7 and later report it without it having to be changed.
+  std::string status;
+  if (ReadFileToString(FilePath("/proc/self/status"), &status)) {
+    size_t pos = status.find("\nUmask:\t");
+    if (pos != std::string::npos)
+      return static_cast<mode_t>(strtol(&status[pos + 8], NULL, 8));
+  }
+#endif
+  // Reading the mask means setting it, so files another thread creates
+  // meanwhile get 022 instead.
+  mode_t mask = umask(022);
+  umask(mask);
+  return mask;
+}
+
+// Creates a temporary file next to |path| holding |data|. The file is left
+// open as |fd| so it can be synced.
+bool WriteTempFile(const FilePath& path,
+                   StringPiece data,
+                   FilePath* temp_path,
+                   ScopedFD* fd) {
+  if (data.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return false;
+  std::string name = path.DirName().Append(kTempFileName).value();
+  // Other threads may fork and exec meanwhile.
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  fd->reset(HANDLE_EINTR(mkostemp(&name[0], O_CLOEXEC)));
+#else
+  fd->reset(HANDLE_EINTR(mkstemp(&name[0])));
+  if (fd->is_valid())
+    fcntl(fd->get(), F_SETFD, FD_CLOEXEC);
+#endif
+  if (!fd->is_valid()) {
+    DPLOG(ERROR) << "mkstemp " << name;
+    return false;
+  }
+  *temp_path = FilePath(name);
+
+  // The file is created 0600. Give it the mode of the file it replaces, or
+  // that of a newly created file.
+  struct stat stat_buf;
+  mode_t mode = stat(path.value().c_str(), &stat_buf) == 0
+                    ? stat_buf.st_mode & 07777
+                    : 0666 & ~GetUmask();
+  if ((mode != 0600 && HANDLE_EINTR(fchmod(fd->get(), mode)) != 0) ||
+      !WriteFileDescriptor(fd->get(), data.data(),
+                           static_cast<int>(data.size()))) {
+    DPLOG(ERROR) << "write " << name;
+    fd->reset();
+    DeleteFile(*temp_path, false);
+    return false;
+  }
+  return true;
+}
+
+// Flushes the contents of |fd|. Its size is flushed too, but not times that
+// a crash could not make inconsistent.
+bool SyncData(int fd) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  return !HANDLE_EINTR(fdatasync(fd));
+#else
+  return !HANDLE_EINTR(fsync(fd));
+#endif
+}
+
+// Flushes the entries of |directory|, making renames into it durable.
+bool SyncDirectory(const FilePath& directory) {
+  ScopedFD fd(HANDLE_EINTR(
+      open(directory.value().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)));
+  return fd.is_valid() && !HANDLE_EINTR(fsync(fd.get()));
+}
+
+#if defined(OS_LINUX)
+// Flushes the file system holding |fd| unless |synced| shows it has already
+// been flushed, and returns whether the flush succeeded.
+bool SyncFileSystemOnce(int fd, std::map<dev_t, bool>* synced) {
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) != 0)
+    return false;
+  auto it = synced->find(stat_buf.st_dev);
+  if (it == synced->end()) {
+    bool success = !HANDLE_EINTR(syncfs(fd));
+    DPLOG_IF(ERROR, !success) << "syncfs";
+    it = synced->insert(std::make_pair(stat_buf.st_dev, success)).first;
+  }
+  return it->second;
+}
+#endif
+
+}  // namespace
+
+ImportantFileWriter::Options::Options()
+    : commit_interval(TimeDelta::FromMilliseconds(100)),
+      max_batch_size(256),
+      sync_file_system(true) {}
+
+// static
+bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
+                                              StringPiece data) {
+  ThreadRestrictions::AssertIOAllowed();
+  FilePath temp_path;
+  ScopedFD fd;
+  if (!WriteTempFile(path, data, &temp_path, &fd))
+    return false;
+  if (!SyncData(fd.get())) {
+    DPLOG(ERROR) << "fdatasync " << temp_path.value();
+    fd.reset();
+    DeleteFile(temp_path, false);
+    return false;
+  }
+  fd.reset();
+  if (!ReplaceFile(temp_path, path, NULL)) {
+    DPLOG(ERROR) << "rename " << path.value();
+    DeleteFile(temp_path, false);
+    return false;
+  }
+  return SyncDirectory(path.DirName());
+}
+
+ImportantFileWriter::ImportantFileWriter()
+    : ImportantFileWriter(Options()) {}
+
+ImportantFileWriter::ImportantFileWriter(const Options& options)
+    : options_(options),
+      work_available_(&lock_),
+      batch_committed_(&lock_),
+      scheduled_(0),
+      committed_(0),
+      commit_requested_(0),
+      shutting_down_(false) {
+  DCHECK_GT(options.max_batch_size, 0u);
+  thread_.reset(new DelegateSimpleThread(this, "ImportantFileWriter"));
+  thread_->Start();
+}
+
+ImportantFileWriter::~ImportantFileWriter() {
+  {
+    AutoLock lock(lock_);
+    shutting_down_ = true;
+    work_available_.Signal();
+  }
+  thread_->Join();
+}
+
+void ImportantFileWriter::ScheduleWrite(const FilePath& path,
+                                        std::string data,
+                                        const WriteCallback& callback) {
+  AutoLock lock(lock_);
+  DCHECK(!shutting_down_);
+  if (pending_.empty())
+    first_pending_time_ = TimeTicks::Now();
+  PendingWrite& write = pending_[path];
+  write.data = std::move(data);
+  if (callback)
+    write.callbacks.push_back(callback);
+  ++scheduled_;
+  if (pending_.size() == 1 || pending_.size() >= options_.max_batch_size)
+    work_available_.Signal();
+}
+
+void ImportantFileWriter::CommitPendingWrites() {
+  AutoLock lock(lock_);
+  const uint64_t target = scheduled_;
+  if (committed_ >= target)
+    return;
+  commit_requested_ = std::max(commit_requested_, target);
+  work_available_.Signal();
+  while (committed_ < target)
+    batch_committed_.Wait();
+}
+
+void ImportantFileWriter::Run() {
+  AutoLock lock(lock_);
+  for (;;) {
+    while (pending_.empty() && !shutting_down_)
+      work_available_.Wait();
+    if (pending_.empty())
+      return;
+
+    // Give other writes a chance to join the batch.
+    const TimeTicks deadline = first_pending_time_ + options_.commit_interval;
+    while (!shutting_down_ && commit_requested_ <= committed_ &&
+           pending_.size() < options_.max_batch_size) {
+      TimeTicks now = TimeTicks::Now();
+      if (now >= deadline)
+        break;
+      work_available_.TimedWait(deadline - now);
+    }
+
+    Batch batch;
+    batch.swap(pending_);
+    const uint64_t last_write = scheduled_;
+    {
+      AutoUnlock unlock(lock_);
+      CommitBatch(&batch);
+    }
+    committed_ = last_write;
+    batch_committed_.Broadcast();
+  }
+}
+
+void ImportantFileWriter::CommitBatch(Batch* batch) {
+  struct Commit {
+    Commit() : path(NULL), write(NULL), success(false) {}
+
+    const FilePath* path;
+    PendingWrite* write;
+    FilePath temp_path;
+    ScopedFD fd;
+    bool success;
+  };
+  std::vector<Commit> commits(batch->size());
+  size_t i = 0;
+  for (auto& entry : *batch) {
+    Commit& commit = commits[i++];
+    commit.path = &entry.first;
+    commit.write = &entry.second;
+    commit.success = WriteTempFile(entry.first, entry.second.data,
+                                   &commit.temp_path, &commit.fd);
+  }
+
+  // Flush every temporary file before any of them replaces its target.
+#if defined(OS_LINUX)
+  std::map<dev_t, bool> synced_file_systems;
+#endif
+  for (Commit& commit : commits) {
+    if (!commit.success)
+      continue;
+#if defined(OS_LINUX)
+    if (options_.sync_file_system) {
+      commit.success =
+          SyncFileSystemOnce(commit.fd.get(), &synced_file_systems);
+      continue;
+    }
+#endif
+    commit.success = SyncData(commit.fd.get());
+  }
+
+  std::map<FilePath, bool> directories;
+  for (Commit& commit : commits) {
+    commit.fd.reset();
+    if (commit.success) {
+      commit.success = ReplaceFile(commit.temp_path, *commit.path, NULL);
+      if (commit.success)
+        directories[commit.path->DirName()] = false;
+    }
+    if (!commit.success && !commit.temp_path.empty())
+      DeleteFile(commit.temp_path, false);
+  }
+
+  // One sync per directory makes all of its renames durable.
+  for (auto& directory : directories)
+    directory.second = SyncDirectory(directory.first);
+
+  for (Commit& commit : commits) {
+    if (commit.success)
+      commit.success = directories[commit.path->DirName()];
+    for (const WriteCallback& callback : commit.write->callbacks)
+      callback(commit.success);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,176 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/line_reader.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "build/build_config.h"
+
+namespace base {
+
+LineReader::Options::Options()
+    : buffer_size(256 * 1024), max_line_length(64 * 1024), read_ahead(false) {}
+
+LineReader::LineReader(File* file) : LineReader(file, Options()) {}
+
+LineReader::LineReader(File* file, const Options& options)
+    : options_(options),
+      file_(file),
+      // A "\r\n" may follow a line of the greatest length.
+      carry_space_(options.max_line_length + 2),
+      position_(NULL),
+      end_(NULL),
+      end_of_file_(false),
+      partial_(false),
+      error_(false),
+      current_(1),
+      state_changed_(&lock_),
+      fill_index_(0),
+      shutting_down_(false) {
+  DCHECK(file->IsValid());
+  DCHECK_GT(options.buffer_size, 0u);
+  DCHECK_GT(options.max_line_length, 0u);
+  CHECK_LE(options.buffer_size,
+           static_cast<size_t>(std::numeric_limits<int>::max()));
+  for (Buffer& buffer : buffers_) {
+    buffer.data.reset(new char[carry_space_ + options.buffer_size]);
+    buffer.result = 0;
+  }
+  buffers_[0].state = Buffer::FILLING;
+  buffers_[1].state = Buffer::READING;
+
+#if defined(OS_POSIX)
+  file->Advise(0, 0, File::ADVICE_SEQUENTIAL);
+#endif
+  if (options.read_ahead) {
+    thread_.reset(new DelegateSimpleThread(this, "LineReader"));
+    thread_->Start();
+  }
+}
+
+LineReader::LineReader(const MemoryMappedFile* mapped_file)
+    : file_(NULL),
+      carry_space_(0),
+      position_(reinterpret_cast<const char*>(mapped_file->data())),
+      end_(position_ + mapped_file->length()),
+      end_of_file_(true),
+      partial_(false),
+      error_(false),
+      current_(0),
+      state_changed_(&lock_),
+      fill_index_(0),
+      shutting_down_(false) {}
+
+LineReader::~LineReader() {
+  if (!thread_)
+    return;
+  {
+    AutoLock lock(lock_);
+    shutting_down_ = true;
+    state_changed_.Broadcast();
+  }
+  thread_->Join();
+}
+
+bool LineReader::ReadLine(StringPiece* line) {
+  partial_ = false;
+  for (;;) {
+    size_t available = end_ - position_;
+    // memchr() is vectorized in every C library that matters.
+    size_t search_length =
+        file_ ? std::min(available, carry_space_) : available;
+    const char* newline = static_cast<const char*>(
+        search_length ? memchr(position_, '\n', search_length) : NULL);
+    size_t length = newline ? newline - position_ : 0;
+    if (newline && length && newline[-1] == '\r')
+      --length;
+    if (newline && (!file_ || length <= options_.max_line_length)) {
+      *line = StringPiece(position_, length);
+      position_ = newline + 1;
+      return true;
+    }
+    // An unterminated last line is split the same way.
+    if (file_ && (newline || available >= carry_space_ ||
+                  (end_of_file_ && available > options_.max_line_length))) {
+      *line = StringPiece(position_, options_.max_line_length);
+      position_ += options_.max_line_length;
+      partial_ = true;
+      return true;
+    }
+    if (end_of_file_) {
+      if (!available)
+        return false;
+      *line = StringPiece(position_, available);
+      position_ = end_;
+      return true;
+    }
+    NextBuffer();
+  }
+}
+
+void LineReader::Run() {
+  AutoLock lock(lock_);
+  for (;;) {
+    Buffer& buffer = buffers_[fill_index_];
+    while (buffer.state != Buffer::FILLING && !shutting_down_)
+      state_changed_.Wait();
+    if (shutting_down_)
+      return;
+    {
+      AutoUnlock unlock(lock_);
+      Fill(&buffer);
+    }
+    buffer.state = Buffer::READY;
+    fill_index_ ^= 1;
+    state_changed_.Broadcast();
+    // Nothing follows the end of the file or an error.
+    if (buffer.result <= 0)
+      return;
+  }
+}
+
+void LineReader::Fill(Buffer* buffer) {
+  buffer->result = file_->ReadAtCurrentPos(buffer->data.get() + carry_space_,
+                                           options_.buffer_size);
+}
+
+void LineReader::NextBuffer() {
+  Buffer& next = buffers_[current_ ^ 1];
+  if (thread_) {
+    AutoLock lock(lock_);
+    while (next.state != Buffer::READY)
+      state_changed_.Wait();
+    next.state = Buffer::READING;
+  } else {
+    Fill(&next);
+  }
+
+  char* data = next.data.get() + carry_space_;
+  size_t carry = end_ - position_;
+  DCHECK_LT(carry, carry_space_);
+  if (carry)
+    memcpy(data - carry, position_, carry);
+  position_ = data - carry;
+  end_ = data + std::max(next.result, 0);
+  if (next.result <= 0) {
+    end_of_file_ = true;
+    error_ = next.result < 0;
+  }
+
+  if (thread_) {
+    AutoLock lock(lock_);
+    buffers_[current_].state = Buffer::FILLING;
+    state_changed_.Broadcast();
+  }
+  current_ ^= 1;
+}
+
+}  // namespace base
@@ -0,0 +1,132 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_LINE_READER_H_
+#define BASE_FILES_LINE_READER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+
+namespace base {
+
+class File;
+class MemoryMappedFile;
+
+// Reads a text file a line at a time without holding all of it in memory:
+//
+//   File file(path, File::FLAG_OPEN | File::FLAG_READ);
+//   LineReader reader(&file);
+//   StringPiece line;
+//   while (reader.ReadLine(&line))
+//     ...
+//   if (reader.error())
+//     ...
+//
+// Lines end with "\n" or "\r\n", which is left out of the lines returned;
+// the last line need not end with either. A File is read through two
+// buffers, the next optionally filled on a background thread while lines
+// are taken from the current one. Lines longer than a buffer allows are
+// returned in pieces. A MemoryMappedFile is read in place, with every line
+// whole.
+class BASE_EXPORT LineReader : public DelegateSimpleThread::Delegate {
+ public:
+  struct BASE_EXPORT Options {
+    Options();
+
+    // The size of each read from the file.
+    size_t buffer_size;
+
+    // Lines longer than this are returned in pieces of this length, with
+    // partial() set for all but the last.
+    size_t max_line_length;
+
+    // Reads the next buffer on a background thread.
+    bool read_ahead;
+  };
+
+  // Reads |file| from its current position. |file| must outlive this
+  // object and not be used by anything else meanwhile.
+  explicit LineReader(File* file);
+  LineReader(File* file, const Options& options);
+
+  // Reads all of |mapped_file|, which must outlive this object.
+  explicit LineReader(const MemoryMappedFile* mapped_file);
+
+  ~LineReader() override;
+
+  // Sets |line| to the next line and returns true, or returns false at the
+  // end of the file or on a read error. |line| stays valid until the next
+  // call, or for a MemoryMappedFile, as long as the mapping.
+  bool ReadLine(StringPiece* line);
+
+  // Whether the line last read was cut short at Options::max_line_length,
+  // with the rest to follow.
+  bool partial() const { return partial_; }
+
+  // Whether reading stopped because of an error.
+  bool error() const { return error_; }
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override;
+
+ private:
+  struct Buffer {
+    enum State {
+      // Owned by the thread filling buffers.
+      FILLING,
+      // Filled and waiting for the reader.
+      READY,
+      // Owned by the reader.
+      READING,
+    };
+
+    std::unique_ptr<char[]> data;
+    // What reading into it returned.
+    int result;
+    State state;
+  };
+
+  // Reads into |buffer|, after room for what is left of the current one.
+  void Fill(Buffer* buffer);
+
+  // Moves on to the other buffer, carrying over the start of a line not yet
+  // returned.
+  void NextBuffer();
+
+  const Options options_;
+  File* const file_;
+  // Room at the start of each buffer for the rest of the previous one.
+  const size_t carry_space_;
+
+  // The data not yet returned.
+  const char* position_;
+  const char* end_;
+  bool end_of_file_;
+  bool partial_;
+  bool error_;
+
+  Buffer buffers_[2];
+  int current_;
+
+  // For Options::read_ahead.
+  Lock lock_;
+  ConditionVariable state_changed_;
+  int fill_index_;
+  bool shutting_down_;
+  std::unique_ptr<DelegateSimpleThread> thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(LineReader);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_LINE_READER_H_
@@ -25,16 +25,31 @@ bool MemoryMappedFile::Region::operator!=(
   return other.offset != offset || other.size != size;
 }
 
+MemoryMappedFile::Options::Options()
+    : access(READ_ONLY),
+      hint(ACCESS_NORMAL),
+      populate(false),
+      huge_page_aligned(false) {}
+
 MemoryMappedFile::~MemoryMappedFile() {
   CloseHandles();
 }
 
 #if !defined(OS_NACL)
 bool MemoryMappedFile::Initialize(const FilePath& file_name) {
+  return Initialize(file_name, Options());
+}
+
+bool MemoryMappedFile::Initialize(const FilePath& file_name,
+                                  const Options& options) {
   if (IsValid())
     return false;
 
-  file_.Initialize(file_name, File::FLAG_OPEN | File::FLAG_READ);
+  uint32_t flags = File::FLAG_OPEN | File::FLAG_READ;
+  if (options.access == READ_WRITE)
+    flags |= File::FLAG_WRITE;
+  file_.Initialize(file_name, flags);
+  options_ = options;
 
   if (!file_.IsValid()) {
     DLOG(ERROR) << "Couldn't open " << file_name.AsUTF8Unsafe();
@@ -54,6 +69,12 @@ bool MemoryMappedFile::Initialize(File file) {
 }
 
 bool MemoryMappedFile::Initialize(File file, const Region& region) {
+  return Initialize(std::move(file), region, Options());
+}
+
+bool MemoryMappedFile::Initialize(File file,
+                                  const Region& region,
+                                  const Options& options) {
   if (IsValid())
     return false;
 
@@ -63,6 +84,7 @@ bool MemoryMappedFile::Initialize(File file, const Region& region) {
   }
 
   file_ = std::move(file);
+  options_ = options;
 
   if (!MapFileRegionToMemory(region)) {
     CloseHandles();
@@ -10,6 +10,7 @@
 
 #include "base/base_export.h"
 #include "base/files/file.h"
+#include "base/logging.h"
 #include "base/macros.h"
 #include "build/build_config.h"
 
@@ -41,6 +42,46 @@ class BASE_EXPORT MemoryMappedFile {
     int64_t size;
   };
 
+  // What may be done with the mapped memory.
+  enum Access {
+    // The pages can only be read.
+    READ_ONLY,
+    // Writes go to the file, visible to every other mapping of it. Flush()
+    // forces them out.
+    READ_WRITE,
+    // Writes stay private to this mapping (copy-on-write). The file is never
+    // modified.
+    READ_WRITE_COPY,
+  };
+
+  // How the mapped data will be read, passed to the kernel as a hint.
+  enum AccessHint {
+    ACCESS_NORMAL,
+    // Reads ahead aggressively, and pages read may be dropped soon after.
+    ACCESS_SEQUENTIAL,
+    // Does not read ahead.
+    ACCESS_RANDOM,
+    // Starts reading the pages in now.
+    ACCESS_WILL_NEED,
+  };
+
+  struct BASE_EXPORT Options {
+    Options();
+
+    Access access;
+
+    // Applied to the whole mapping when it is made. POSIX only.
+    AccessHint hint;
+
+    // Reads the whole mapping in before Initialize() returns, so touching it
+    // later never faults. Linux only.
+    bool populate;
+
+    // Places the mapping at an address the kernel can back with huge pages
+    // where the file system supports them, and asks it to. Linux only.
+    bool huge_page_aligned;
+  };
+
   // Opens an existing file and maps it into memory. Access is restricted to
   // read only. If this object already points to a valid memory mapped file
   // then this method will fail and return false. If it cannot open the file,
@@ -55,6 +96,11 @@ class BASE_EXPORT MemoryMappedFile {
   // As above, but works with a region of an already-opened file.
   bool Initialize(File file, const Region& region);
 
+  // As above, with the access and placement in |options|. A READ_WRITE
+  // mapping needs |file| to be open for writing; opening by name does that.
+  bool Initialize(const FilePath& file_name, const Options& options);
+  bool Initialize(File file, const Region& region, const Options& options);
+
 #if defined(OS_WIN)
   // Opens an existing file and maps it as an image section. Please refer to
   // the Initialize function above for additional information.
@@ -67,6 +113,33 @@ class BASE_EXPORT MemoryMappedFile {
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
+#if defined(OS_POSIX)
+  // Writable data(), for READ_WRITE and READ_WRITE_COPY mappings.
+  uint8_t* writable_data() {
+    DCHECK_NE(READ_ONLY, options_.access);
+    return data_;
+  }
+
+  // Passes |hint| for the |size| bytes at |offset| in data(). Returns false
+  // if the kernel rejects it.
+  bool Advise(AccessHint hint, size_t offset, size_t size);
+
+  // Reads the |size| bytes at |offset| in data() in on a background thread,
+  // so that touching them later does not wait for the disk. Stops a prefetch
+  // still running. Resize() and closing the mapping stop it too.
+  void PrefetchInBackground(size_t offset, size_t size);
+
+  // Writes the modified pages of a READ_WRITE mapping back to the file. If
+  // |wait|, returns once they are written; otherwise only schedules them.
+  bool Flush(bool wait);
+
+  // Changes the length of a whole-file mapping to |length|. A READ_WRITE
+  // mapping sets the file's length first; others need the file to be at
+  // least that long already, e.g. after another writer appended to it.
+  // data() may move. Returns false for a mapping of a region.
+  bool Resize(size_t length);
+#endif  // defined(OS_POSIX)
+
  private:
   // Given the arbitrarily aligned memory region [start, size], returns the
   // boundaries of the region aligned to the granularity specified by the OS,
@@ -90,6 +163,22 @@ class BASE_EXPORT MemoryMappedFile {
   File file_;
   uint8_t* data_;
   size_t length_;
+  Options options_;
+
+#if defined(OS_POSIX)
+  class Prefetcher;
+
+  // Stops the background prefetch, if any.
+  void StopPrefetch();
+
+  // The page-aligned mapping, which starts at or before data_.
+  uint8_t* map_start_;
+  size_t map_size_;
+  bool whole_file_;
+
+  // Owned; deleted by StopPrefetch().
+  Prefetcher* prefetcher_;
+#endif
 
 #if defined(OS_WIN)
   win::ScopedHandle file_mapping_;
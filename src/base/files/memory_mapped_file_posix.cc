@@ -10,15 +10,139 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
+
+#include "base/atomicops.h"
 #include "base/logging.h"
+#include "base/threading/simple_thread.h"
 #include "base/threading/thread_restrictions.h"
 #include "build/build_config.h"
 
 namespace base {
 
-MemoryMappedFile::MemoryMappedFile() : data_(NULL), length_(0) {
+namespace {
+
+#if defined(OS_LINUX)
+// The size, and alignment, of a transparent huge page on x86-64 and arm64.
+const size_t kHugePageSize = 2 * 1024 * 1024;
+#endif
+
+size_t PageSize() {
+  return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+int ToMadviseAdvice(MemoryMappedFile::AccessHint hint) {
+  switch (hint) {
+    case MemoryMappedFile::ACCESS_NORMAL:
+      return MADV_NORMAL;
+    case MemoryMappedFile::ACCESS_SEQUENTIAL:
+      return MADV_SEQUENTIAL;
+    case MemoryMappedFile::ACCESS_RANDOM:
+      return MADV_RANDOM;
+    case MemoryMappedFile::ACCESS_WILL_NEED:
+      return MADV_WILLNEED;
+  }
+  NOTREACHED();
+  return MADV_NORMAL;
 }
 
+// Maps |size| bytes of |fd| from |offset|. With |huge_page_aligned|, the
+// address is congruent to |offset| modulo the huge page size, which the
+// kernel needs to back a file mapping with huge pages.
+void* MapAligned(size_t size,
+                 int prot,
+                 int flags,
+                 int fd,
+                 off_t offset,
+                 bool huge_page_aligned) {
+#if defined(OS_LINUX)
+  if (huge_page_aligned && size >= kHugePageSize) {
+    // Reserves enough address space to slide the mapping into place, then
+    // gives back what it does not use.
+    size_t reserved_size = size + kHugePageSize;
+    void* reserved = mmap(NULL, reserved_size, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (reserved == MAP_FAILED)
+      return MAP_FAILED;
+    uintptr_t reserved_start = reinterpret_cast<uintptr_t>(reserved);
+    uintptr_t start =
+        reserved_start +
+        (static_cast<uintptr_t>(offset) - reserved_start) % kHugePageSize;
+    void* memory = mmap(reinterpret_cast<void*>(start), size, prot,
+                        flags | MAP_FIXED, fd, offset);
+    if (memory == MAP_FAILED) {
+      munmap(reserved, reserved_size);
+      return MAP_FAILED;
+    }
+    if (start > reserved_start)
+      munmap(reserved, start - reserved_start);
+    uintptr_t end = start + size;
+    uintptr_t reserved_end = reserved_start + reserved_size;
+    if (reserved_end > end)
+      munmap(reinterpret_cast<void*>(end), reserved_end - end);
+    // Not every kernel or file system can; the mapping works regardless.
+    madvise(memory, size, MADV_HUGEPAGE);
+    return memory;
+  }
+#endif
+  return mmap(NULL, size, prot, flags, fd, offset);
+}
+
+}  // namespace
+
+// Touches every page of a range of the mapping on its own thread.
+class MemoryMappedFile::Prefetcher : public DelegateSimpleThread::Delegate {
+ public:
+  Prefetcher(const uint8_t* start, size_t size)
+      : start_(start),
+        size_(size),
+        stopped_(0),
+        thread_(this, "MappedFilePrefetch") {
+    thread_.Start();
+  }
+
+  ~Prefetcher() override {
+    subtle::NoBarrier_Store(&stopped_, 1);
+    thread_.Join();
+  }
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override {
+    // Reading ahead in chunks lets the disk work on the next chunk while
+    // this thread maps the pages of the last one.
+    const size_t kChunkSize = 2 * 1024 * 1024;
+    const size_t page_size = PageSize();
+    uint8_t sum = 0;
+    for (size_t done = 0; done < size_; done += kChunkSize) {
+      if (subtle::NoBarrier_Load(&stopped_))
+        return;
+      size_t chunk_size = std::min(kChunkSize, size_ - done);
+      const uint8_t* chunk = start_ + done;
+      madvise(const_cast<uint8_t*>(chunk), chunk_size, MADV_WILLNEED);
+      for (size_t offset = 0; offset < chunk_size; offset += page_size)
+        sum += *static_cast<const volatile uint8_t*>(chunk + offset);
+    }
+    ignore_result(sum);
+  }
+
+ private:
+  // Page aligned.
+  const uint8_t* const start_;
+  const size_t size_;
+  subtle::Atomic32 stopped_;
+  DelegateSimpleThread thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(Prefetcher);
+};
+
+MemoryMappedFile::MemoryMappedFile()
+    : data_(NULL),
+      length_(0),
+      map_start_(NULL),
+      map_size_(0),
+      whole_file_(false),
+      prefetcher_(NULL) {}
+
 #if !defined(OS_NACL)
 bool MemoryMappedFile::MapFileRegionToMemory(
     const MemoryMappedFile::Region& region) {
@@ -36,6 +160,7 @@ bool MemoryMappedFile::MapFileRegionToMemory(
     }
     map_size = static_cast<size_t>(file_len);
     length_ = map_size;
+    whole_file_ = true;
   } else {
     // The region can be arbitrarily aligned. mmap, instead, requires both the
     // start and size to be page-aligned. Hence, we map here the page-aligned
@@ -65,27 +190,121 @@ bool MemoryMappedFile::MapFileRegionToMemory(
     length_ = static_cast<size_t>(region.size);
   }
 
-  data_ = static_cast<uint8_t*>(mmap(NULL, map_size, PROT_READ, MAP_SHARED,
-                                     file_.GetPlatformFile(), map_start));
-  if (data_ == MAP_FAILED) {
+  int prot = PROT_READ;
+  int flags = MAP_SHARED;
+  if (options_.access != READ_ONLY)
+    prot |= PROT_WRITE;
+  if (options_.access == READ_WRITE_COPY)
+    flags = MAP_PRIVATE;
+#if defined(OS_LINUX)
+  if (options_.populate)
+    flags |= MAP_POPULATE;
+#endif
+
+  void* memory = MapAligned(map_size, prot, flags, file_.GetPlatformFile(),
+                            map_start, options_.huge_page_aligned);
+  if (memory == MAP_FAILED) {
+    DPLOG(ERROR) << "mmap " << file_.GetPlatformFile();
+    return false;
+  }
+
+  map_start_ = static_cast<uint8_t*>(memory);
+  map_size_ = map_size;
+  data_ = map_start_ + data_offset;
+  if (options_.hint != ACCESS_NORMAL)
+    madvise(map_start_, map_size_, ToMadviseAdvice(options_.hint));
+  return true;
+}
+
+bool MemoryMappedFile::Advise(AccessHint hint, size_t offset, size_t size) {
+  DCHECK(IsValid());
+  DCHECK_LE(offset, length_);
+  DCHECK_LE(size, length_ - offset);
+  // madvise() wants a page-aligned start.
+  uint8_t* start = data_ + offset;
+  size_t misalignment = reinterpret_cast<uintptr_t>(start) % PageSize();
+  return madvise(start - misalignment, size + misalignment,
+                 ToMadviseAdvice(hint)) == 0;
+}
+
+void MemoryMappedFile::PrefetchInBackground(size_t offset, size_t size) {
+  DCHECK(IsValid());
+  DCHECK_LE(offset, length_);
+  DCHECK_LE(size, length_ - offset);
+  StopPrefetch();
+  if (!size)
+    return;
+  const uint8_t* start = data_ + offset;
+  size_t misalignment = reinterpret_cast<uintptr_t>(start) % PageSize();
+  prefetcher_ = new Prefetcher(start - misalignment, size + misalignment);
+}
+
+bool MemoryMappedFile::Flush(bool wait) {
+  DCHECK(IsValid());
+  if (options_.access != READ_WRITE)
+    return true;
+  ThreadRestrictions::AssertIOAllowed();
+  return msync(map_start_, map_size_, wait ? MS_SYNC : MS_ASYNC) == 0;
+}
+
+bool MemoryMappedFile::Resize(size_t length) {
+  DCHECK(IsValid());
+  DCHECK_GT(length, 0u);
+  // A region mapping starts at an offset that is not kept.
+  if (!whole_file_)
+    return false;
+  ThreadRestrictions::AssertIOAllowed();
+  StopPrefetch();
+
+  if (options_.access == READ_WRITE &&
+      !file_.SetLength(static_cast<int64_t>(length))) {
+    return false;
+  }
+
+#if defined(OS_LINUX)
+  void* memory = mremap(map_start_, map_size_, length, MREMAP_MAYMOVE);
+  if (memory == MAP_FAILED) {
+    DPLOG(ERROR) << "mremap " << file_.GetPlatformFile();
+    return false;
+  }
+#else
+  int prot = options_.access == READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+  int flags = options_.access == READ_WRITE_COPY ? MAP_PRIVATE : MAP_SHARED;
+  void* memory =
+      mmap(NULL, length, prot, flags, file_.GetPlatformFile(), 0);
+  if (memory == MAP_FAILED) {
     DPLOG(ERROR) << "mmap " << file_.GetPlatformFile();
     return false;
   }
+  munmap(map_start_, map_size_);
+#endif
 
-  data_ += data_offset;
+  map_start_ = static_cast<uint8_t*>(memory);
+  map_size_ = length;
+  data_ = map_start_;
+  length_ = length;
   return true;
 }
 #endif
 
+void MemoryMappedFile::StopPrefetch() {
+  delete prefetcher_;
+  prefetcher_ = NULL;
+}
+
 void MemoryMappedFile::CloseHandles() {
   ThreadRestrictions::AssertIOAllowed();
 
-  if (data_ != NULL)
-    munmap(data_, length_);
+  StopPrefetch();
+  if (map_start_ != NULL)
+    munmap(map_start_, map_size_);
   file_.Close();
 
   data_ = NULL;
   length_ = 0;
+  map_start_ = NULL;
+  map_size_ = 0;
+  whole_file_ = false;
 }
 
 }  // namespace base
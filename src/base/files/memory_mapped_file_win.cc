@@ -30,7 +30,17 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   if (!file_.IsValid())
     return false;
 
-  int flags = image_ ? SEC_IMAGE | PAGE_READONLY : PAGE_READONLY;
+  int flags = PAGE_READONLY;
+  DWORD view_access = FILE_MAP_READ;
+  if (options_.access == READ_WRITE) {
+    flags = PAGE_READWRITE;
+    view_access = FILE_MAP_WRITE;
+  } else if (options_.access == READ_WRITE_COPY) {
+    flags = PAGE_WRITECOPY;
+    view_access = FILE_MAP_COPY;
+  }
+  if (image_)
+    flags |= SEC_IMAGE;
 
   file_mapping_.Set(::CreateFileMapping(file_.GetPlatformFile(), NULL,
                                         flags, 0, 0, NULL));
@@ -72,7 +82,7 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   }
 
   data_ = static_cast<uint8_t*>(
-      ::MapViewOfFile(file_mapping_.Get(), FILE_MAP_READ, map_start.HighPart,
+      ::MapViewOfFile(file_mapping_.Get(), view_access, map_start.HighPart,
                       map_start.LowPart, map_size));
   if (data_ == NULL)
     return false;
@@ -0,0 +1,144 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_PARALLEL_FILE_ENUMERATOR_H_
+#define BASE_FILES_PARALLEL_FILE_ENUMERATOR_H_
+
+#include <stddef.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+
+namespace base {
+
+// Enumerates a directory tree like FileEnumerator, with its Next() and
+// GetInfo() interface, but reads the directories on a pool of threads. File
+// types come from the directory entries themselves, so nothing is stat()ed
+// unless Options::stat_fields asks for more than the type.
+//
+// Only available on Linux.
+//
+// Example:
+//
+//   ParallelFileEnumerator::Options options;
+//   options.stat_fields = ParallelFileEnumerator::STAT_SIZE;
+//   ParallelFileEnumerator enumerator(root, true, FileEnumerator::FILES,
+//                                     options);
+//   for (FilePath path = enumerator.Next(); !path.empty();
+//        path = enumerator.Next()) {
+//     total_size += enumerator.GetInfo().GetSize();
+//   }
+//
+// Symbolic links to directories are reported but never descended into, so
+// link cycles cannot make the walk endless. Unlike FileEnumerator there is
+// no pattern matching and INCLUDE_DOT_DOT is not supported.
+class BASE_EXPORT ParallelFileEnumerator
+    : public DelegateSimpleThread::Delegate {
+ public:
+  enum Order {
+    // Results come as soon as any directory has been read.
+    UNORDERED,
+    // Results come in a fixed, depth-first order: the entries of a directory
+    // in the order the file system lists them, then the results of each of
+    // its subdirectories in turn. Directories read ahead of their turn are
+    // held in memory.
+    ORDERED,
+  };
+
+  // The parts of FileInfo::stat() filled in beyond the file type. Each
+  // field asked for costs a statx() per entry.
+  enum StatField {
+    STAT_NONE = 0,
+    STAT_SIZE = 1 << 0,
+    STAT_LAST_MODIFIED = 1 << 1,
+    // Every field, as FileEnumerator provides.
+    STAT_ALL = 1 << 2,
+  };
+
+  struct BASE_EXPORT Options {
+    Options();
+
+    // Threads reading directories. Defaults to the number of processors,
+    // up to 8.
+    int num_threads;
+
+    Order order;
+
+    // A bit mask of StatField.
+    int stat_fields;
+  };
+
+  // |recursive| and |file_type| are as for FileEnumerator.
+  ParallelFileEnumerator(const FilePath& root_path,
+                         bool recursive,
+                         int file_type);
+  ParallelFileEnumerator(const FilePath& root_path,
+                         bool recursive,
+                         int file_type,
+                         const Options& options);
+
+  // Stops the threads once they finish the directories they are reading.
+  ~ParallelFileEnumerator() override;
+
+  // Returns the next file or an empty path if there are no more results.
+  // Blocks while the directory holding the next result is being read.
+  FilePath Next();
+
+  // Returns the current entry, with the fields of stat() requested by
+  // Options::stat_fields.
+  FileEnumerator::FileInfo GetInfo() const;
+
+  // DelegateSimpleThread::Delegate:
+  void Run() override;
+
+ private:
+  struct Directory;
+
+  // Reads |directory| into its entries and subdirectories.
+  void ReadDirectory(Directory* directory);
+
+  // Returns the next directory to take results from, or NULL at the end.
+  // Called with |lock_| held.
+  Directory* TakeNextDirectory();
+
+  const bool recursive_;
+  const int file_type_;
+  const Options options_;
+
+  Lock lock_;
+  ConditionVariable work_available_;
+  ConditionVariable directory_read_;
+
+  // Directories waiting for a thread to read them.
+  std::deque<Directory*> unread_;
+  // The number of directories threads are reading.
+  int reading_;
+  // UNORDERED: directories read and not yet handed out.
+  std::deque<Directory*> read_;
+  // ORDERED: the directories to hand out next, the last one first. Those
+  // already read own the subdirectories they found.
+  std::vector<Directory*> pending_;
+  bool shutting_down_;
+
+  std::vector<std::unique_ptr<DelegateSimpleThread>> threads_;
+
+  // The directory whose entries Next() is returning.
+  std::unique_ptr<Directory> current_;
+  size_t current_entry_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelFileEnumerator);
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_PARALLEL_FILE_ENUMERATOR_H_
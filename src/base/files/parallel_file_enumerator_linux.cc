@@ -0,0 +1,264 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/parallel_file_enumerator.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/files/dir_reader_linux.h"
+#include "base/logging.h"
+#include "base/sys_info.h"
+#include "base/threading/thread_restrictions.h"
+
+namespace base {
+
+namespace {
+
+bool IsDotOrDotDot(const char* name) {
+  return name[0] == '.' &&
+         (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// Fills in |stat_buf| for the entry |name| of the directory open as
+// |directory_fd|. Where statx() is available and not every field is wanted,
+// asks only for the type and |stat_fields|, which spares network file
+// systems from fetching the rest.
+bool StatEntry(int directory_fd,
+               const char* name,
+               bool follow_links,
+               int stat_fields,
+               struct stat* stat_buf) {
+  int flags = follow_links ? 0 : AT_SYMLINK_NOFOLLOW;
+#if defined(STATX_TYPE)
+  if (!(stat_fields & ParallelFileEnumerator::STAT_ALL)) {
+    unsigned int mask = STATX_TYPE;
+    if (stat_fields & ParallelFileEnumerator::STAT_SIZE)
+      mask |= STATX_SIZE;
+    if (stat_fields & ParallelFileEnumerator::STAT_LAST_MODIFIED)
+      mask |= STATX_MTIME;
+    struct statx statx_buf;
+    if (statx(directory_fd, name, flags, mask, &statx_buf) == 0) {
+      stat_buf->st_mode = statx_buf.stx_mode & S_IFMT;
+      if (mask & STATX_SIZE)
+        stat_buf->st_size = statx_buf.stx_size;
+      if (mask & STATX_MTIME) {
+        stat_buf->st_mtim.tv_sec = statx_buf.stx_mtime.tv_sec;
+        stat_buf->st_mtim.tv_nsec = statx_buf.stx_mtime.tv_nsec;
+      }
+      return true;
+    }
+    // Kernels before 4.11 have no statx().
+    if (errno != ENOSYS)
+      return false;
+  }
+#endif
+  return fstatat(directory_fd, name, stat_buf, flags) == 0;
+}
+
+}  // namespace
+
+struct ParallelFileEnumerator::Directory {
+  explicit Directory(const FilePath& path) : path(path), read(false) {}
+
+  const FilePath path;
+  std::vector<FileEnumerator::FileInfo> entries;
+  // ORDERED: the subdirectories found, in the order they were listed.
+  std::vector<std::unique_ptr<Directory>> subdirectories;
+  bool read;
+};
+
+ParallelFileEnumerator::Options::Options()
+    : num_threads(std::min(SysInfo::NumberOfProcessors(), 8)),
+      order(UNORDERED),
+      stat_fields(STAT_NONE) {}
+
+ParallelFileEnumerator::ParallelFileEnumerator(const FilePath& root_path,
+                                               bool recursive,
+                                               int file_type)
+    : ParallelFileEnumerator(root_path, recursive, file_type, Options()) {}
+
+ParallelFileEnumerator::ParallelFileEnumerator(const FilePath& root_path,
+                                               bool recursive,
+                                               int file_type,
+                                               const Options& options)
+    : recursive_(recursive),
+      file_type_(file_type),
+      options_(options),
+      work_available_(&lock_),
+      directory_read_(&lock_),
+      reading_(0),
+      shutting_down_(false),
+      current_entry_(0) {
+  DCHECK(!(file_type & FileEnumerator::INCLUDE_DOT_DOT));
+  DCHECK_GT(options.num_threads, 0);
+
+  Directory* root = new Directory(root_path.StripTrailingSeparators());
+  unread_.push_back(root);
+  if (options_.order == ORDERED)
+    pending_.push_back(root);
+
+  for (int i = 0; i < options.num_threads; ++i) {
+    threads_.push_back(std::unique_ptr<DelegateSimpleThread>(
+        new DelegateSimpleThread(this, "FileEnumerator")));
+    threads_.back()->Start();
+  }
+}
+
+ParallelFileEnumerator::~ParallelFileEnumerator() {
+  {
+    AutoLock lock(lock_);
+    shutting_down_ = true;
+    work_available_.Broadcast();
+  }
+  for (const std::unique_ptr<DelegateSimpleThread>& thread : threads_)
+    thread->Join();
+
+  if (options_.order == ORDERED) {
+    // Every directory not handed out is reachable from |pending_|.
+    for (Directory* directory : pending_)
+      delete directory;
+  } else {
+    for (Directory* directory : unread_)
+      delete directory;
+    for (Directory* directory : read_)
+      delete directory;
+  }
+}
+
+FilePath ParallelFileEnumerator::Next() {
+  ThreadRestrictions::AssertIOAllowed();
+  ++current_entry_;
+  while (!current_ || current_entry_ >= current_->entries.size()) {
+    {
+      AutoLock lock(lock_);
+      current_.reset(TakeNextDirectory());
+    }
+    current_entry_ = 0;
+    if (!current_)
+      return FilePath();
+  }
+  return current_->path.Append(current_->entries[current_entry_].filename_);
+}
+
+FileEnumerator::FileInfo ParallelFileEnumerator::GetInfo() const {
+  return current_->entries[current_entry_];
+}
+
+void ParallelFileEnumerator::Run() {
+  AutoLock lock(lock_);
+  for (;;) {
+    while (unread_.empty() && !shutting_down_)
+      work_available_.Wait();
+    if (shutting_down_)
+      return;
+    Directory* directory = unread_.front();
+    unread_.pop_front();
+    ++reading_;
+
+    {
+      AutoUnlock unlock(lock_);
+      ReadDirectory(directory);
+    }
+
+    --reading_;
+    directory->read = true;
+    if (options_.order == ORDERED) {
+      for (const std::unique_ptr<Directory>& subdirectory :
+           directory->subdirectories) {
+        unread_.push_back(subdirectory.get());
+      }
+    } else {
+      // The subdirectories are handed out on their own.
+      for (std::unique_ptr<Directory>& subdirectory :
+           directory->subdirectories) {
+        unread_.push_back(subdirectory.release());
+      }
+      directory->subdirectories.clear();
+      read_.push_back(directory);
+    }
+    if (!unread_.empty())
+      work_available_.Broadcast();
+    directory_read_.Signal();
+  }
+}
+
+void ParallelFileEnumerator::ReadDirectory(Directory* directory) {
+  LargeDirReaderLinux reader(directory->path.value().c_str());
+  if (!reader.IsValid())
+    return;
+
+  const bool follow_links = !(file_type_ & FileEnumerator::SHOW_SYM_LINKS);
+  while (reader.Next()) {
+    const char* name = reader.name();
+    if (IsDotOrDotDot(name))
+      continue;
+
+    FileEnumerator::FileInfo info;
+    info.filename_ = FilePath(name);
+    unsigned char type = reader.type();
+    if (type == DT_UNKNOWN) {
+      // Some file systems, e.g. older XFS and some network file systems, do
+      // not record types in directory entries.
+      if (StatEntry(reader.fd(), name, false, STAT_NONE, &info.stat_))
+        type = IFTODT(info.stat_.st_mode);
+    }
+
+    // Whether a link is reported as a directory depends on its target.
+    if (options_.stat_fields || (type == DT_LNK && follow_links)) {
+      if (!StatEntry(reader.fd(), name, follow_links, options_.stat_fields,
+                     &info.stat_)) {
+        memset(&info.stat_, 0, sizeof(info.stat_));
+      }
+    } else {
+      info.stat_.st_mode = DTTOIF(type);
+    }
+
+    if (recursive_ && type == DT_DIR) {
+      directory->subdirectories.push_back(std::unique_ptr<Directory>(
+          new Directory(directory->path.Append(info.filename_))));
+    }
+    bool is_directory = info.IsDirectory();
+    if ((is_directory && (file_type_ & FileEnumerator::DIRECTORIES)) ||
+        (!is_directory && (file_type_ & FileEnumerator::FILES))) {
+      directory->entries.push_back(std::move(info));
+    }
+  }
+}
+
+ParallelFileEnumerator::Directory*
+ParallelFileEnumerator::TakeNextDirectory() {
+  lock_.AssertAcquired();
+  if (options_.order == ORDERED) {
+    if (pending_.empty())
+      return NULL;
+    Directory* directory = pending_.back();
+    while (!directory->read)
+      directory_read_.Wait();
+    pending_.pop_back();
+    // The first subdirectory is handed out next.
+    for (auto it = directory->subdirectories.rbegin();
+         it != directory->subdirectories.rend(); ++it) {
+      pending_.push_back(it->release());
+    }
+    directory->subdirectories.clear();
+    return directory;
+  }
+
+  while (read_.empty() && (!unread_.empty() || reading_))
+    directory_read_.Wait();
+  if (read_.empty())
+    return NULL;
+  Directory* directory = read_.front();
+  read_.pop_front();
+  return directory;
+}
+
+}  // namespace base
@@ -6,27 +6,123 @@
 
 #include <stddef.h>
 
-#include "base/strings/string_util.h"
+#include "base/rand_util.h"
+#include "base/time/time.h"
 
 namespace base {
 
-bool IsValidGUID(const std::string& guid) {
-  const size_t kGUIDLength = 36U;
-  if (guid.length() != kGUIDLength)
-    return false;
+namespace {
 
-  for (size_t i = 0; i < guid.length(); ++i) {
-    char current = guid[i];
-    if (i == 8 || i == 13 || i == 18 || i == 23) {
-      if (current != '-')
-        return false;
-    } else {
-      if (!IsHexDigit(current))
-        return false;
+// Offsets of the hex digit pairs for each byte in the 36-character form.
+const size_t kByteOffsets[16] = {0,  2,  4,  6,  9,  11, 14, 16,
+                                 19, 21, 24, 26, 28, 30, 32, 34};
+
+// Maps a character to its hex digit value, or to 0x80 if it is not one.
+struct HexDigitTable {
+  constexpr HexDigitTable() : values() {
+    for (int i = 0; i < 256; ++i)
+      values[i] = 0x80;
+    for (int i = 0; i < 10; ++i)
+      values['0' + i] = static_cast<uint8_t>(i);
+    for (int i = 0; i < 6; ++i) {
+      values['a' + i] = static_cast<uint8_t>(10 + i);
+      values['A' + i] = static_cast<uint8_t>(10 + i);
     }
   }
+  uint8_t values[256];
+};
+
+constexpr HexDigitTable kHexDigits;
+
+// Decodes the 36-character form into |bytes|. The whole input is checked
+// without early exits, which is faster than branching on every character.
+bool ParseGUIDString(const StringPiece& input, uint8_t bytes[16]) {
+  if (input.size() != Guid::kStringLength)
+    return false;
+  const char* p = input.data();
+  if (p[8] != '-' || p[13] != '-' || p[18] != '-' || p[23] != '-')
+    return false;
+  uint8_t invalid = 0;
+  for (size_t i = 0; i < 16; ++i) {
+    const uint8_t high = kHexDigits.values[static_cast<uint8_t>(
+        p[kByteOffsets[i]])];
+    const uint8_t low = kHexDigits.values[static_cast<uint8_t>(
+        p[kByteOffsets[i] + 1])];
+    invalid |= high | low;
+    bytes[i] = static_cast<uint8_t>((high << 4) | (low & 0x0f));
+  }
+  return !(invalid & 0x80);
+}
+
+}  // namespace
+
+// static
+const size_t Guid::kStringLength;
+
+bool IsValidGUID(const std::string& guid) {
+  uint8_t bytes[16];
+  return ParseGUIDString(guid, bytes);
+}
+
+// static
+Guid Guid::GenerateRandomV4() {
+  Guid guid;
+  RandBytes(guid.bytes_, sizeof(guid.bytes_));
+  guid.SetVersion(4);
+  return guid;
+}
+
+// static
+Guid Guid::GenerateTimeOrderedV7() {
+  Guid guid;
+  RandBytes(guid.bytes_ + 6, sizeof(guid.bytes_) - 6);
+  const uint64_t unix_ms = static_cast<uint64_t>(Time::Now().ToJavaTime());
+  for (int i = 0; i < 6; ++i)
+    guid.bytes_[i] = static_cast<uint8_t>(unix_ms >> (40 - 8 * i));
+  guid.SetVersion(7);
+  return guid;
+}
+
+// static
+Guid Guid::FromBytes(const uint8_t bytes[16]) {
+  Guid guid;
+  memcpy(guid.bytes_, bytes, sizeof(guid.bytes_));
+  return guid;
+}
 
+// static
+bool Guid::Parse(const StringPiece& input, Guid* guid) {
+  uint8_t bytes[16];
+  if (!ParseGUIDString(input, bytes))
+    return false;
+  memcpy(guid->bytes_, bytes, sizeof(bytes));
   return true;
 }
 
+void Guid::FormatTo(char* buffer) const {
+  static const char kHexChars[] = "0123456789ABCDEF";
+  for (size_t i = 0; i < 16; ++i) {
+    buffer[kByteOffsets[i]] = kHexChars[bytes_[i] >> 4];
+    buffer[kByteOffsets[i] + 1] = kHexChars[bytes_[i] & 0x0f];
+  }
+  buffer[8] = buffer[13] = buffer[18] = buffer[23] = '-';
+}
+
+std::string Guid::ToString() const {
+  char buffer[kStringLength];
+  FormatTo(buffer);
+  return std::string(buffer, kStringLength);
+}
+
+bool Guid::is_nil() const {
+  return *this == Guid();
+}
+
+void Guid::SetVersion(int version) {
+  bytes_[6] = static_cast<uint8_t>((bytes_[6] & 0x0f) | (version << 4));
+  // Set the two most significant bits of clock_seq_hi_and_reserved to one and
+  // zero, respectively, so that the variant is RFC 4122.
+  bytes_[8] = static_cast<uint8_t>((bytes_[8] & 0x3f) | 0x80);
+}
+
 }  // namespace base
@@ -39,6 +39,7 @@
 
 #include "base/atomicops.h"
 #include "base/base_export.h"
+#include "base/compiler_specific.h"
 #include "base/debug/leak_annotations.h"
 #include "base/logging.h"
 #include "base/memory/aligned_memory.h"
@@ -148,23 +149,17 @@ class LazyInstance {
     static const subtle::AtomicWord kLazyInstanceCreatedMask =
         ~internal::kLazyInstanceStateCreating;
 
-    // We will hopefully have fast access when the instance is already created.
-    // Since a thread sees private_instance_ == 0 or kLazyInstanceStateCreating
-    // at most once, the load is taken out of NeedsInstance() as a fast-path.
+    // Once the instance exists this is the whole of Pointer(): one load and
+    // a branch, with no atomic read-modify-write. The creation path lives
+    // out of line so that it does not bloat every caller.
     // The load has acquire memory ordering as a thread which sees
     // private_instance_ > creating needs to acquire visibility over
     // the associated data (private_buf_). Pairing Release_Store is in
     // CompleteLazyInstance().
     subtle::AtomicWord value = subtle::Acquire_Load(&private_instance_);
-    if (!(value & kLazyInstanceCreatedMask) &&
-        internal::NeedsLazyInstance(&private_instance_)) {
-      // Create the instance in the space provided by |private_buf_|.
-      value = reinterpret_cast<subtle::AtomicWord>(
-          Traits::New(private_buf_.void_data()));
-      internal::CompleteLazyInstance(&private_instance_, value, this,
-                                     Traits::kRegisterOnExit ? OnExit : NULL);
-    }
-    return instance();
+    if (UNLIKELY(!(value & kLazyInstanceCreatedMask)))
+      return CreateInstance();
+    return reinterpret_cast<Type*>(value);
   }
 
   bool operator==(Type* p) {
@@ -191,6 +186,19 @@ class LazyInstance {
     return reinterpret_cast<Type*>(subtle::NoBarrier_Load(&private_instance_));
   }
 
+  NOINLINE Type* CreateInstance() {
+    // Since a thread sees private_instance_ == 0 or kLazyInstanceStateCreating
+    // at most once, this runs at most once per thread.
+    if (internal::NeedsLazyInstance(&private_instance_)) {
+      // Create the instance in the space provided by |private_buf_|.
+      subtle::AtomicWord value = reinterpret_cast<subtle::AtomicWord>(
+          Traits::New(private_buf_.void_data()));
+      internal::CompleteLazyInstance(&private_instance_, value, this,
+                                     Traits::kRegisterOnExit ? OnExit : NULL);
+    }
+    return instance();
+  }
+
   // Adapter function for use with AtExit.  This should be called single
   // threaded, so don't synchronize across threads.
   // Calling OnExit while the instance is in use by other threads is a mistake.
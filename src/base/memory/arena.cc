@@ -0,0 +1,166 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/arena.h"
+
+#include <stdlib.h>
+
+#include "base/bits.h"
+
+namespace base {
+
+struct Arena::Block {
+  Block* next;
+  // The usable size, not counting this header.
+  size_t size;
+
+  char* data() {
+    return reinterpret_cast<char*>(this) +
+           bits::Align(sizeof(Block), kDefaultAlignment);
+  }
+};
+
+struct Arena::DestructorNode {
+  void (*destroy)(void*);
+  void* object;
+  DestructorNode* next;
+};
+
+const size_t Arena::kDefaultBlockSize = 4096 - 64;
+
+Arena::Arena() : Arena(kDefaultBlockSize) {}
+
+Arena::Arena(size_t block_size)
+    : block_size_(block_size),
+      ptr_(NULL),
+      end_(NULL),
+      blocks_(NULL),
+      large_blocks_(NULL),
+      spare_block_(NULL),
+      destructors_(NULL),
+      bytes_reserved_(0) {
+  DCHECK_GE(block_size_, 256u);
+}
+
+Arena::~Arena() {
+  Reset();
+  if (blocks_)
+    FreeBlock(blocks_);
+  if (spare_block_)
+    FreeBlock(spare_block_);
+}
+
+void Arena::RegisterDestructor(void* object, void (*destroy)(void*)) {
+  DestructorNode* node = static_cast<DestructorNode*>(
+      Allocate(sizeof(DestructorNode), ALIGNOF(DestructorNode)));
+  node->destroy = destroy;
+  node->object = object;
+  node->next = destructors_;
+  destructors_ = node;
+}
+
+Arena::Mark Arena::GetMark() const {
+  Mark mark;
+  mark.block = blocks_;
+  mark.ptr = ptr_;
+  mark.large_blocks = large_blocks_;
+  mark.destructors = destructors_;
+  return mark;
+}
+
+void Arena::RewindTo(const Mark& mark) {
+  // Destructors first: the objects may live in the blocks freed below.
+  while (destructors_ != mark.destructors) {
+    DCHECK(destructors_);
+    DestructorNode* node = destructors_;
+    destructors_ = node->next;
+    node->destroy(node->object);
+  }
+
+  while (large_blocks_ != mark.large_blocks) {
+    DCHECK(large_blocks_);
+    Block* block = large_blocks_;
+    large_blocks_ = block->next;
+    FreeBlock(block);
+  }
+
+  while (blocks_ != mark.block) {
+    DCHECK(blocks_);
+    Block* block = blocks_;
+    blocks_ = block->next;
+    if (!spare_block_) {
+      spare_block_ = block;
+      spare_block_->next = NULL;
+    } else {
+      FreeBlock(block);
+    }
+  }
+
+  ptr_ = mark.ptr;
+  end_ = blocks_ ? blocks_->data() + blocks_->size : NULL;
+}
+
+void Arena::Reset() {
+  // Rewind to the start of the oldest block rather than to an empty arena, so
+  // that the block is reused.
+  Block* oldest = blocks_;
+  while (oldest && oldest->next)
+    oldest = oldest->next;
+
+  Mark mark;
+  mark.block = oldest;
+  mark.ptr = oldest ? oldest->data() : NULL;
+  mark.large_blocks = NULL;
+  mark.destructors = NULL;
+
+  // Everything allocated from |oldest| needs its destructors run too, which
+  // RewindTo() does since it unwinds to an empty destructor list.
+  RewindTo(mark);
+}
+
+void* Arena::AllocateSlow(size_t size, size_t alignment) {
+  // Big allocations get a block of their own, so that at most a quarter of a
+  // regular block is ever wasted at its end.
+  if (size > block_size_ / 4 || alignment > block_size_ / 4) {
+    CHECK_LE(size, std::numeric_limits<size_t>::max() - alignment);
+    Block* block = NewBlock(size + alignment);
+    block->next = large_blocks_;
+    large_blocks_ = block;
+    return reinterpret_cast<void*>(
+        bits::Align(reinterpret_cast<uintptr_t>(block->data()), alignment));
+  }
+
+  Block* block = spare_block_;
+  if (block) {
+    spare_block_ = NULL;
+  } else {
+    block = NewBlock(block_size_);
+  }
+  block->next = blocks_;
+  blocks_ = block;
+  ptr_ = block->data();
+  end_ = ptr_ + block->size;
+
+  void* result = Allocate(size, alignment);
+  DCHECK(result);
+  return result;
+}
+
+Arena::Block* Arena::NewBlock(size_t size) {
+  const size_t header = bits::Align(sizeof(Block), kDefaultAlignment);
+  CHECK_LE(size, std::numeric_limits<size_t>::max() - header);
+  Block* block = static_cast<Block*>(malloc(header + size));
+  CHECK(block);
+  block->next = NULL;
+  block->size = size;
+  bytes_reserved_ += size;
+  return block;
+}
+
+void Arena::FreeBlock(Block* block) {
+  bytes_reserved_ -= block->size;
+  free(block);
+}
+
+}  // namespace base
@@ -0,0 +1,194 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_ARENA_H_
+#define BASE_MEMORY_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/macros.h"
+
+namespace base {
+
+// Arena is a region allocator: it hands out memory by bumping a pointer
+// through a chain of blocks, and gives all of it back at once, when the arena
+// is destroyed, Reset() or rewound by a ScopedArenaReset. Individual
+// allocations are never freed. This makes allocation a few instructions and
+// deallocation free, which suits the many short-lived objects of a parse or
+// a request that all die together.
+//
+// Objects created with New() have their destructors run, in reverse order of
+// creation, when the memory they live in is released. Memory from Allocate()
+// is raw; nothing is run for it.
+//
+// Arena is not thread-safe.
+//
+// Example:
+//   Arena arena;
+//   Node* root = arena.New<Node>("root");
+//   std::vector<Node*, ArenaAllocator<Node*>> children(
+//       ArenaAllocator<Node*>(&arena));
+class BASE_EXPORT Arena {
+ private:
+  struct Block;
+  struct DestructorNode;
+
+ public:
+  // The default amount of memory each block provides.
+  static const size_t kDefaultBlockSize;
+  // The alignment Allocate() uses when none is given.
+  static const size_t kDefaultAlignment = 16;
+
+  // A position in the arena to rewind to; see RewindTo().
+  class Mark {
+   private:
+    friend class Arena;
+    Block* block;
+    char* ptr;
+    Block* large_blocks;
+    DestructorNode* destructors;
+  };
+
+  Arena();
+  explicit Arena(size_t block_size);
+  ~Arena();
+
+  // Returns |size| bytes aligned to |alignment|, which must be a power of two.
+  void* Allocate(size_t size, size_t alignment = kDefaultAlignment) {
+    DCHECK_EQ(0u, alignment & (alignment - 1));
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(ptr_) + alignment - 1) &
+                        ~(alignment - 1);
+    if (UNLIKELY(aligned > reinterpret_cast<uintptr_t>(end_) ||
+                 size > reinterpret_cast<uintptr_t>(end_) - aligned)) {
+      return AllocateSlow(size, alignment);
+    }
+    ptr_ = reinterpret_cast<char*>(aligned + size);
+    return reinterpret_cast<void*>(aligned);
+  }
+
+  // Returns uninitialized storage for |count| objects of type T.
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    CHECK_LE(count, std::numeric_limits<size_t>::max() / sizeof(T));
+    return static_cast<T*>(Allocate(count * sizeof(T), ALIGNOF(T)));
+  }
+
+  // Constructs a T in the arena. Unless T is trivially destructible, its
+  // destructor runs when the arena releases the memory.
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    T* object = new (Allocate(sizeof(T), ALIGNOF(T)))
+        T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value)
+      RegisterDestructor(object, &DestroyObject<T>);
+    return object;
+  }
+
+  // Arranges for |destroy(object)| to be called when the memory allocated so
+  // far is released.
+  void RegisterDestructor(void* object, void (*destroy)(void*));
+
+  // Records the current position, and releases everything allocated since a
+  // mark was taken. Marks must be rewound to in LIFO order.
+  Mark GetMark() const;
+  void RewindTo(const Mark& mark);
+
+  // Releases everything. The first block is kept for reuse.
+  void Reset();
+
+  // The number of bytes of block memory the arena currently holds.
+  size_t bytes_reserved() const { return bytes_reserved_; }
+
+ private:
+  template <typename T>
+  static void DestroyObject(void* object) {
+    static_cast<T*>(object)->~T();
+  }
+
+  void* AllocateSlow(size_t size, size_t alignment);
+  Block* NewBlock(size_t size);
+  void FreeBlock(Block* block);
+
+  const size_t block_size_;
+  // The free space in the current block.
+  char* ptr_;
+  char* end_;
+  // Chain of blocks, newest first. Allocations too big to share a block get
+  // their own, kept in a separate chain so that they do not end the current
+  // one.
+  Block* blocks_;
+  Block* large_blocks_;
+  // A block released by RewindTo(), kept so that a loop of rewinds does not
+  // malloc and free a block per iteration.
+  Block* spare_block_;
+  // Destructors to run, newest first.
+  DestructorNode* destructors_;
+  size_t bytes_reserved_;
+
+  DISALLOW_COPY_AND_ASSIGN(Arena);
+};
+
+// Releases everything allocated from |arena| during its lifetime.
+class ScopedArenaReset {
+ public:
+  explicit ScopedArenaReset(Arena* arena)
+      : arena_(arena), mark_(arena->GetMark()) {}
+  ~ScopedArenaReset() { arena_->RewindTo(mark_); }
+
+ private:
+  Arena* arena_;
+  Arena::Mark mark_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedArenaReset);
+};
+
+// An STL allocator that allocates from an Arena, in the spirit of
+// StackAllocator. deallocate() is a no-op: the memory comes back when the
+// arena releases it, so containers using this allocator must not outlive
+// that. Copies of the allocator share the arena.
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind {
+    typedef ArenaAllocator<U> other;
+  };
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) { return arena_->AllocateArray<T>(n); }
+  void deallocate(T*, size_t) {}
+
+  Arena* arena() const { return arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.arena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.arena();
+  }
+
+ private:
+  Arena* arena_;
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_ARENA_H_
@@ -0,0 +1,342 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/object_pool.h"
+
+#include <algorithm>
+
+#include "base/bits.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/memory/aligned_memory.h"
+#include "base/threading/thread_local_storage.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+const size_t kCacheLineSize = 64;
+const size_t kSlabSize = 64 * 1024;
+// Aim for batches of about this many bytes, within the bounds below.
+const size_t kBatchBytes = 16 * 1024;
+const size_t kMinBatchSize = 8;
+const size_t kMaxBatchSize = 64;
+
+// Holds each thread's ObjectPoolBase::ThreadCaches. Slots are never reused
+// once freed, so a slot per pool would run out.
+ThreadLocalStorage::StaticSlot g_thread_caches = TLS_INITIALIZER;
+
+struct PoolIds {
+  PoolIds() : next_serial(1) {}
+
+  Lock lock;
+  // The serial number of the pool holding each id, or 0 if the id is free.
+  std::vector<uint64_t> serials;
+  std::vector<size_t> free;
+  uint64_t next_serial;
+};
+
+LazyInstance<PoolIds>::Leaky g_pool_ids = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// A free slot. Only the first node of a batch uses |count| and |next_batch|.
+struct ObjectPoolBase::FreeNode {
+  FreeNode* next;
+  size_t count;
+  FreeNode* next_batch;
+};
+
+// The calling thread's magazines. |previous| is either NULL or a full batch.
+struct ObjectPoolBase::ThreadCache {
+  ObjectPoolBase* pool;
+  uint64_t serial;
+  FreeNode* loaded;
+  size_t loaded_count;
+  FreeNode* previous;
+};
+
+namespace {
+
+size_t SlotSizeFor(size_t object_size, size_t alignment, size_t min_size) {
+  DCHECK_LE(alignment, kCacheLineSize);
+  const size_t size = bits::Align(std::max(object_size, min_size), alignment);
+  if (size >= kCacheLineSize)
+    return bits::Align(size, kCacheLineSize);
+  size_t slot = alignment;
+  while (slot < size)
+    slot *= 2;
+  return slot;
+}
+
+}  // namespace
+
+ObjectPoolBase::ObjectPoolBase(size_t object_size, size_t alignment)
+    : slot_size_(SlotSizeFor(object_size, alignment, sizeof(FreeNode))),
+      batch_size_(std::max(kMinBatchSize,
+                           std::min(kMaxBatchSize, kBatchBytes / slot_size_))),
+      id_(AcquireId()),
+      serial_(SerialOf(id_)),
+      overflow_count_(0),
+      batches_to_depot_(0),
+      batches_from_depot_(0),
+      overflow_batches_(0),
+      overflow_(NULL),
+      slab_cursor_(NULL),
+      slab_end_(NULL),
+      slab_bytes_(0) {
+  for (size_t i = 0; i < kDepotSize; ++i)
+    depot_[i] = 0;
+}
+
+ObjectPoolBase::~ObjectPoolBase() {
+  // From here on, exiting threads leave the pool alone. The caches other
+  // threads hold are dropped when they next use the id or exit.
+  ReleaseId(id_);
+  ThreadCaches* caches = static_cast<ThreadCaches*>(g_thread_caches.Get());
+  if (caches && id_ < caches->size()) {
+    delete (*caches)[id_];
+    (*caches)[id_] = NULL;
+  }
+  for (void* slab : slabs_)
+    AlignedFree(slab);
+}
+
+void* ObjectPoolBase::Allocate() {
+  ThreadCache* cache = FindThreadCache();
+  if (UNLIKELY(!cache || !cache->loaded_count))
+    return AllocateSlow(cache);
+  FreeNode* node = cache->loaded;
+  cache->loaded = node->next;
+  --cache->loaded_count;
+  return node;
+}
+
+void ObjectPoolBase::Free(void* object) {
+  DCHECK(object);
+  ThreadCache* cache = FindThreadCache();
+  FreeNode* node = static_cast<FreeNode*>(object);
+  if (UNLIKELY(!cache || cache->loaded_count == batch_size_)) {
+    FreeSlow(cache, node);
+    return;
+  }
+  node->next = cache->loaded;
+  cache->loaded = node;
+  ++cache->loaded_count;
+}
+
+ObjectPoolStats ObjectPoolBase::GetStats() const {
+  ObjectPoolStats stats;
+  {
+    AutoLock lock(lock_);
+    stats.slab_bytes = slab_bytes_;
+  }
+  stats.batches_to_depot = subtle::NoBarrier_Load(&batches_to_depot_);
+  stats.batches_from_depot = subtle::NoBarrier_Load(&batches_from_depot_);
+  stats.overflow_batches = subtle::NoBarrier_Load(&overflow_batches_);
+  return stats;
+}
+
+// static
+size_t ObjectPoolBase::AcquireId() {
+  PoolIds& ids = g_pool_ids.Get();
+  AutoLock lock(ids.lock);
+  if (!g_thread_caches.initialized())
+    g_thread_caches.Initialize(&ObjectPoolBase::OnThreadExit);
+  size_t id;
+  if (ids.free.empty()) {
+    id = ids.serials.size();
+    ids.serials.push_back(0);
+  } else {
+    id = ids.free.back();
+    ids.free.pop_back();
+  }
+  ids.serials[id] = ids.next_serial++;
+  return id;
+}
+
+// static
+uint64_t ObjectPoolBase::SerialOf(size_t id) {
+  PoolIds& ids = g_pool_ids.Get();
+  AutoLock lock(ids.lock);
+  return ids.serials[id];
+}
+
+// static
+void ObjectPoolBase::ReleaseId(size_t id) {
+  PoolIds& ids = g_pool_ids.Get();
+  AutoLock lock(ids.lock);
+  ids.serials[id] = 0;
+  ids.free.push_back(id);
+}
+
+ObjectPoolBase::ThreadCache* ObjectPoolBase::FindThreadCache() const {
+  ThreadCaches* caches = static_cast<ThreadCaches*>(g_thread_caches.Get());
+  if (!caches || id_ >= caches->size())
+    return NULL;
+  ThreadCache* cache = (*caches)[id_];
+  // A cache of an earlier pool with the same id holds its freed memory.
+  return cache && cache->serial == serial_ ? cache : NULL;
+}
+
+ObjectPoolBase::ThreadCache* ObjectPoolBase::GetThreadCache() {
+  ThreadCaches* caches = static_cast<ThreadCaches*>(g_thread_caches.Get());
+  if (!caches) {
+    caches = new ThreadCaches;
+    g_thread_caches.Set(caches);
+  }
+  if (caches->size() <= id_)
+    caches->resize(id_ + 1);
+  ThreadCache*& cache = (*caches)[id_];
+  if (cache && cache->serial != serial_) {
+    delete cache;
+    cache = NULL;
+  }
+  if (!cache) {
+    cache = new ThreadCache;
+    cache->pool = this;
+    cache->serial = serial_;
+    cache->loaded = NULL;
+    cache->loaded_count = 0;
+    cache->previous = NULL;
+  }
+  return cache;
+}
+
+void* ObjectPoolBase::AllocateSlow(ThreadCache* cache) {
+  if (!cache)
+    cache = GetThreadCache();
+
+  if (cache->previous) {
+    cache->loaded = cache->previous;
+    cache->loaded_count = batch_size_;
+    cache->previous = NULL;
+  } else {
+    FreeNode* batch = PopBatch();
+    if (!batch)
+      batch = CarveBatch();
+    cache->loaded = batch;
+    cache->loaded_count = batch->count;
+  }
+
+  DCHECK_GT(cache->loaded_count, 0u);
+  FreeNode* node = cache->loaded;
+  cache->loaded = node->next;
+  --cache->loaded_count;
+  return node;
+}
+
+void ObjectPoolBase::FreeSlow(ThreadCache* cache, FreeNode* node) {
+  if (!cache)
+    cache = GetThreadCache();
+
+  if (cache->loaded_count == batch_size_) {
+    if (cache->previous) {
+      cache->previous->count = batch_size_;
+      PushBatch(cache->previous);
+    }
+    cache->previous = cache->loaded;
+    cache->loaded = NULL;
+    cache->loaded_count = 0;
+  }
+
+  node->next = cache->loaded;
+  cache->loaded = node;
+  ++cache->loaded_count;
+}
+
+// static
+void ObjectPoolBase::OnThreadExit(void* value) {
+  ThreadCaches* caches = static_cast<ThreadCaches*>(value);
+  PoolIds& ids = g_pool_ids.Get();
+  // Holding the lock keeps the pools that are still alive from being
+  // destroyed while their batches are returned.
+  AutoLock lock(ids.lock);
+  for (size_t id = 0; id < caches->size(); ++id) {
+    ThreadCache* cache = (*caches)[id];
+    if (!cache)
+      continue;
+    if (ids.serials[id] == cache->serial) {
+      ObjectPoolBase* pool = cache->pool;
+      if (cache->loaded_count) {
+        cache->loaded->count = cache->loaded_count;
+        pool->PushBatch(cache->loaded);
+      }
+      if (cache->previous) {
+        cache->previous->count = pool->batch_size_;
+        pool->PushBatch(cache->previous);
+      }
+    }
+    delete cache;
+  }
+  delete caches;
+}
+
+void ObjectPoolBase::PushBatch(FreeNode* batch) {
+  const subtle::AtomicWord value = reinterpret_cast<subtle::AtomicWord>(batch);
+  for (size_t i = 0; i < kDepotSize; ++i) {
+    // Release pairs with the acquire in PopBatch(), publishing the batch's
+    // links to the thread that takes it.
+    if (subtle::NoBarrier_Load(&depot_[i]) == 0 &&
+        subtle::Release_CompareAndSwap(&depot_[i], 0, value) == 0) {
+      subtle::NoBarrier_AtomicIncrement(&batches_to_depot_, 1);
+      return;
+    }
+  }
+
+  AutoLock lock(lock_);
+  batch->next_batch = overflow_;
+  overflow_ = batch;
+  subtle::NoBarrier_AtomicIncrement(&overflow_count_, 1);
+  subtle::NoBarrier_AtomicIncrement(&overflow_batches_, 1);
+}
+
+ObjectPoolBase::FreeNode* ObjectPoolBase::PopBatch() {
+  for (size_t i = 0; i < kDepotSize; ++i) {
+    // Taking the whole batch with one compare-and-swap means a stale read
+    // can at worst fail the swap; it can never hand out a batch twice.
+    const subtle::AtomicWord value = subtle::NoBarrier_Load(&depot_[i]);
+    if (value && subtle::Acquire_CompareAndSwap(&depot_[i], value, 0) == value) {
+      subtle::NoBarrier_AtomicIncrement(&batches_from_depot_, 1);
+      return reinterpret_cast<FreeNode*>(value);
+    }
+  }
+
+  if (!subtle::Acquire_Load(&overflow_count_))
+    return NULL;
+  AutoLock lock(lock_);
+  FreeNode* batch = overflow_;
+  if (batch) {
+    overflow_ = batch->next_batch;
+    subtle::NoBarrier_AtomicIncrement(&overflow_count_, -1);
+  }
+  return batch;
+}
+
+ObjectPoolBase::FreeNode* ObjectPoolBase::CarveBatch() {
+  const size_t bytes = slot_size_ * batch_size_;
+  AutoLock lock(lock_);
+  if (static_cast<size_t>(slab_end_ - slab_cursor_) < bytes) {
+    const size_t slab_size = std::max(kSlabSize, bytes);
+    char* slab = static_cast<char*>(AlignedAlloc(slab_size, kCacheLineSize));
+    slabs_.push_back(slab);
+    slab_cursor_ = slab;
+    slab_end_ = slab + slab_size;
+    slab_bytes_ += slab_size;
+  }
+
+  FreeNode* head = NULL;
+  for (size_t i = batch_size_; i-- > 0;) {
+    FreeNode* node = reinterpret_cast<FreeNode*>(slab_cursor_ + i * slot_size_);
+    node->next = head;
+    head = node;
+  }
+  slab_cursor_ += bytes;
+  head->count = batch_size_;
+  return head;
+}
+
+}  // namespace internal
+}  // namespace base
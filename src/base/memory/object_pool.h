@@ -0,0 +1,201 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_OBJECT_POOL_H_
+#define BASE_MEMORY_OBJECT_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+
+// Counters describing an ObjectPool. Only the slow paths update them, so they
+// cost nothing on the common allocate and free.
+struct ObjectPoolStats {
+  // Bytes of slab memory the pool has allocated. It is never given back.
+  size_t slab_bytes;
+  // Batches of free objects that thread caches handed to, or took from, the
+  // shared depot.
+  size_t batches_to_depot;
+  size_t batches_from_depot;
+  // Batches that found the lock-free depot full, or empty, and went to the
+  // locked overflow list instead.
+  size_t overflow_batches;
+};
+
+namespace internal {
+
+// The type-erased part of ObjectPool: fixed-size slots carved from
+// cache-line-aligned slabs, per-thread caches, and a shared depot.
+//
+// Each thread caches up to two batches of free slots ("magazines"), so most
+// allocations and frees touch only thread-local memory. When both are full a
+// free hands one batch to the depot, and an allocation that finds both empty
+// takes a batch from it. The depot is a small array of batch pointers updated
+// with single-word compare-and-swap, so there is no ABA hazard; only when it
+// is full or empty does a thread take |lock_|.
+//
+// All pools share one thread-local storage slot, which holds each thread's
+// caches indexed by pool id, so that any number of pools may be created and
+// destroyed. Ids of destroyed pools are reused; each cache also records the
+// serial number of its pool, which is never reused, so that a cache left
+// behind by a destroyed pool is recognized and dropped.
+class BASE_EXPORT ObjectPoolBase {
+ public:
+  ObjectPoolBase(size_t object_size, size_t alignment);
+
+  // Threads that used the pool may outlive it. Objects still allocated from
+  // it become invalid.
+  ~ObjectPoolBase();
+
+  void* Allocate();
+  void Free(void* object);
+
+  ObjectPoolStats GetStats() const;
+
+  // The size of the slot each object occupies. Slots never straddle a cache
+  // line boundary more than they must: small slots are a power of two that
+  // divides the line size, and larger slots are whole lines.
+  size_t slot_size() const { return slot_size_; }
+
+ private:
+  struct FreeNode;
+  struct ThreadCache;
+  // A thread's caches, indexed by pool id.
+  typedef std::vector<ThreadCache*> ThreadCaches;
+
+  enum { kDepotSize = 32 };
+
+  // Assigns a pool id and serial number, and frees them again.
+  static size_t AcquireId();
+  static uint64_t SerialOf(size_t id);
+  static void ReleaseId(size_t id);
+
+  // Returns the calling thread's cache, or NULL if it has none yet.
+  ThreadCache* FindThreadCache() const;
+  ThreadCache* GetThreadCache();
+  void* AllocateSlow(ThreadCache* cache);
+  void FreeSlow(ThreadCache* cache, FreeNode* node);
+  static void OnThreadExit(void* cache);
+
+  void PushBatch(FreeNode* batch);
+  FreeNode* PopBatch();
+  FreeNode* CarveBatch();
+
+  const size_t slot_size_;
+  const size_t batch_size_;
+  const size_t id_;
+  const uint64_t serial_;
+
+  volatile subtle::AtomicWord depot_[kDepotSize];
+  // Non-zero while |overflow_| holds batches, so that an allocation that
+  // finds the depot empty only takes the lock when there is something to get.
+  volatile subtle::AtomicWord overflow_count_;
+
+  volatile subtle::AtomicWord batches_to_depot_;
+  volatile subtle::AtomicWord batches_from_depot_;
+  volatile subtle::AtomicWord overflow_batches_;
+
+  // Guards everything below.
+  mutable Lock lock_;
+  FreeNode* overflow_;
+  std::vector<void*> slabs_;
+  char* slab_cursor_;
+  char* slab_end_;
+  size_t slab_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectPoolBase);
+};
+
+}  // namespace internal
+
+// ObjectPool recycles the memory of fixed-size objects of type T that are
+// allocated and freed at a high rate, possibly on different threads. It keeps
+// freed objects in per-thread caches and only rarely synchronizes with other
+// threads. Memory is kept by the pool for reuse and never returned to the
+// system.
+//
+//   ObjectPool<Task>* pool = ObjectPool<Task>::GetDefault();
+//   Task* task = pool->New(closure);
+//   ...
+//   pool->Delete(task);  // On any thread.
+template <typename T>
+class ObjectPool {
+ public:
+  ObjectPool() : base_(sizeof(T), ALIGNOF(T)) {}
+
+  // The process-wide pool for T. It is created on first use and leaked.
+  static ObjectPool* GetDefault() {
+    static ObjectPool* pool = new ObjectPool;
+    return pool;
+  }
+
+  template <typename... Args>
+  T* New(Args&&... args) {
+    return new (base_.Allocate()) T(std::forward<Args>(args)...);
+  }
+
+  void Delete(const T* object) {
+    if (!object)
+      return;
+    object->~T();
+    FreeStorage(const_cast<T*>(object));
+  }
+
+  // Raw storage for one T, for callers that construct and destroy the object
+  // themselves, such as PooledRefCountedThreadSafeTraits.
+  void* AllocateStorage() { return base_.Allocate(); }
+  void FreeStorage(void* storage) { base_.Free(storage); }
+
+  ObjectPoolStats GetStats() const { return base_.GetStats(); }
+
+ private:
+  internal::ObjectPoolBase base_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectPool);
+};
+
+// Traits for RefCountedThreadSafe<T> that return the object's memory to
+// ObjectPool<T>::GetDefault() instead of the heap. Create such objects with
+// MakePooledRefCounted():
+//
+//   class Kernel
+//       : public RefCountedThreadSafe<Kernel,
+//                                     PooledRefCountedThreadSafeTraits<Kernel>> {
+//    private:
+//     friend class RefCountedThreadSafe<
+//         Kernel, PooledRefCountedThreadSafeTraits<Kernel>>;
+//     ~Kernel();
+//   };
+//
+//   scoped_refptr<Kernel> kernel = MakePooledRefCounted<Kernel>();
+template <typename T>
+struct PooledRefCountedThreadSafeTraits {
+  static void Destruct(const T* x) {
+    RefCountedThreadSafe<T, PooledRefCountedThreadSafeTraits>::DestroyInternal(
+        x);
+    ObjectPool<T>::GetDefault()->FreeStorage(const_cast<T*>(x));
+  }
+};
+
+template <typename T, typename... Args>
+scoped_refptr<T> MakePooledRefCounted(Args&&... args) {
+  return scoped_refptr<T>(
+      ObjectPool<T>::GetDefault()->New(std::forward<Args>(args)...));
+}
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_OBJECT_POOL_H_
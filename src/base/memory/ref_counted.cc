@@ -3,7 +3,12 @@
 // found in the LICENSE file.
 
 #include "base/memory/ref_counted.h"
+
+#include <vector>
+
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_collision_warner.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 
@@ -48,6 +53,192 @@ bool RefCountedThreadSafeBase::Release() const {
   return false;
 }
 
+
+namespace {
+
+// The low bit of BiasedRefCountedBase::shared_ is the "merged" flag; the
+// count is kept above it.
+const Atomic32 kMerged = 1;
+const Atomic32 kSharedOne = 2;
+
+ThreadLocalStorage::Slot* GetOwnerSlot(
+    ThreadLocalStorage::TLSDestructorFunc on_thread_exit) {
+  static ThreadLocalStorage::Slot* slot =
+      new ThreadLocalStorage::Slot(on_thread_exit);
+  return slot;
+}
+
+}  // namespace
+
+// Per-thread state for the biased objects a thread created: the releases
+// other threads queued to it. Referenced by the thread and by each object, so
+// that it outlives both.
+struct BiasedRefCountOwner {
+  BiasedRefCountOwner() : refs(1), pending(0), exited(false) {}
+
+  void AddRef() { NoBarrier_AtomicIncrement(&refs, 1); }
+  void Release() {
+    if (!Barrier_AtomicIncrement(&refs, -1))
+      delete this;
+  }
+
+  volatile Atomic32 refs;
+  // Non-zero while |queue| may be non-empty; read without the lock.
+  volatile Atomic32 pending;
+
+  Lock lock;
+  // Guarded by |lock|. An object is listed once per queued release.
+  std::vector<const BiasedRefCountedBase*> queue;
+  bool exited;
+};
+
+BiasedRefCountedBase::BiasedRefCountedBase(DestroyFunction destroy)
+    : destroy_(destroy),
+      owner_(GetOrCreateOwner()),
+      biased_(0),
+      merged_(false),
+      shared_(0) {
+#ifndef NDEBUG
+  in_dtor_ = false;
+#endif
+  owner_->AddRef();
+}
+
+BiasedRefCountedBase::~BiasedRefCountedBase() {
+#ifndef NDEBUG
+  DCHECK(in_dtor_) << "BiasedRefCounted object deleted without "
+                      "calling Release()";
+#endif
+  owner_->Release();
+}
+
+bool BiasedRefCountedBase::HasOneRef() const {
+  const Atomic32 shared = Acquire_Load(&shared_);
+  if (owner_ == CurrentOwner() && !merged_)
+    return biased_ + shared / kSharedOne == 1;
+  return shared == (kMerged | kSharedOne);
+}
+
+// static
+void BiasedRefCountedBase::ProcessPendingReleases() {
+  BiasedRefCountOwner* owner = CurrentOwner();
+  if (owner && NoBarrier_Load(&owner->pending))
+    DrainQueue(owner);
+}
+
+// static
+BiasedRefCountOwner* BiasedRefCountedBase::CurrentOwner() {
+  return static_cast<BiasedRefCountOwner*>(GetOwnerSlot(&OnThreadExit)->Get());
+}
+
+// static
+BiasedRefCountOwner* BiasedRefCountedBase::GetOrCreateOwner() {
+  BiasedRefCountOwner* owner = CurrentOwner();
+  if (!owner) {
+    owner = new BiasedRefCountOwner;
+    GetOwnerSlot(&OnThreadExit)->Set(owner);
+  }
+  return owner;
+}
+
+// static
+void BiasedRefCountedBase::DrainQueue(BiasedRefCountOwner* owner) {
+  std::vector<const BiasedRefCountedBase*> entries;
+  {
+    AutoLock lock(owner->lock);
+    entries.swap(owner->queue);
+    NoBarrier_Store(&owner->pending, 0);
+  }
+  // An object cannot reach zero while it still has entries in |entries|,
+  // since each of them stands for a reference not yet subtracted.
+  for (const BiasedRefCountedBase* object : entries) {
+    if (object->MergeQueuedRelease())
+      object->Destroy();
+  }
+}
+
+// static
+void BiasedRefCountedBase::OnThreadExit(void* value) {
+  BiasedRefCountOwner* owner = static_cast<BiasedRefCountOwner*>(value);
+  for (;;) {
+    {
+      AutoLock lock(owner->lock);
+      if (owner->queue.empty()) {
+        // From now on releasing threads merge the counts themselves.
+        owner->exited = true;
+        break;
+      }
+    }
+    DrainQueue(owner);
+  }
+  owner->Release();
+}
+
+void BiasedRefCountedBase::AddRefShared() const {
+  // The caller already holds a reference, so no ordering is needed.
+  NoBarrier_AtomicIncrement(&shared_, kSharedOne);
+}
+
+bool BiasedRefCountedBase::ReleaseShared() const {
+  for (;;) {
+    const Atomic32 shared = NoBarrier_Load(&shared_);
+    if (shared & kMerged)
+      return Barrier_AtomicIncrement(&shared_, -kSharedOne) == kMerged;
+    // Not merged, so the owner still holds a biased reference and this
+    // cannot be the last one.
+    if (shared >= kSharedOne) {
+      if (Release_CompareAndSwap(&shared_, shared, shared - kSharedOne) ==
+          shared) {
+        return false;
+      }
+      continue;
+    }
+    // The reference being dropped was counted in |biased_|.
+    return QueueRelease();
+  }
+}
+
+bool BiasedRefCountedBase::MergeBiased() const {
+  BiasedRefCountOwner* owner = owner_;
+  // No release of ours can be queued: each would have been one of the
+  // references that |biased_| still counted.
+  merged_ = true;
+  const bool last = Barrier_AtomicIncrement(&shared_, kMerged) == kMerged;
+  if (NoBarrier_Load(&owner->pending))
+    DrainQueue(owner);
+  return last;
+}
+
+bool BiasedRefCountedBase::QueueRelease() const {
+  BiasedRefCountOwner* owner = owner_;
+  AutoLock lock(owner->lock);
+  if (!owner->exited) {
+    owner->queue.push_back(this);
+    Release_Store(&owner->pending, 1);
+    return false;
+  }
+  // The owner thread is gone, so |biased_| no longer changes and, under
+  // |lock|, can be merged here.
+  return MergeQueuedRelease();
+}
+
+bool BiasedRefCountedBase::MergeQueuedRelease() const {
+  Atomic32 delta = -kSharedOne;
+  if (!merged_) {
+    delta += biased_ * kSharedOne + kMerged;
+    biased_ = 0;
+    merged_ = true;
+  }
+  return Barrier_AtomicIncrement(&shared_, delta) == kMerged;
+}
+
+void BiasedRefCountedBase::Destroy() const {
+#ifndef NDEBUG
+  in_dtor_ = true;
+#endif
+  destroy_(this);
+}
+
 }  // namespace subtle
 
 }  // namespace base
@@ -104,6 +104,99 @@ class BASE_EXPORT RefCountedThreadSafeBase {
   DISALLOW_COPY_AND_ASSIGN(RefCountedThreadSafeBase);
 };
 
+struct BiasedRefCountOwner;
+
+// The count behind BiasedRefCounted<T>. The thread that creates the object
+// owns it: its AddRef() and Release() calls update |biased_| without atomic
+// instructions. Other threads update the atomic |shared_| count. When the
+// owner's count drops to zero the two are merged, and from then on every
+// thread uses |shared_|.
+//
+// A thread may drop a reference that the owner took, leaving |shared_| with
+// nothing to subtract from. Such releases are queued to the owner, which
+// merges them the next time one of its biased counts reaches zero, when it
+// calls ProcessPendingReleases(), or when it exits. After the owner exits,
+// they are merged by the releasing thread.
+class BASE_EXPORT BiasedRefCountedBase {
+ public:
+  // Exact on the owner thread, and on any thread once the counts are merged;
+  // otherwise returns false.
+  bool HasOneRef() const;
+
+  // Merges the releases other threads queued to the calling thread. Threads
+  // that keep biased objects alive for a long time without releasing any can
+  // call this from their idle loop so those objects are not held longer than
+  // needed.
+  static void ProcessPendingReleases();
+
+ protected:
+  typedef void (*DestroyFunction)(const BiasedRefCountedBase* object);
+
+  explicit BiasedRefCountedBase(DestroyFunction destroy);
+  ~BiasedRefCountedBase();
+
+  void AddRef() const {
+  #ifndef NDEBUG
+    DCHECK(!in_dtor_);
+  #endif
+    if (owner_ == CurrentOwner() && !merged_) {
+      ++biased_;
+      return;
+    }
+    AddRefShared();
+  }
+
+  // Returns true if the object should self-delete.
+  bool Release() const {
+  #ifndef NDEBUG
+    DCHECK(!in_dtor_);
+  #endif
+    bool last;
+    if (owner_ == CurrentOwner() && !merged_) {
+  #ifndef NDEBUG
+      DCHECK_GT(biased_, 0);
+  #endif
+      if (--biased_ != 0)
+        return false;
+      last = MergeBiased();
+    } else {
+      last = ReleaseShared();
+    }
+  #ifndef NDEBUG
+    if (last)
+      in_dtor_ = true;
+  #endif
+    return last;
+  }
+
+ private:
+  static BiasedRefCountOwner* CurrentOwner();
+  static BiasedRefCountOwner* GetOrCreateOwner();
+  static void DrainQueue(BiasedRefCountOwner* owner);
+  static void OnThreadExit(void* owner);
+
+  void AddRefShared() const;
+  bool ReleaseShared() const;
+  bool MergeBiased() const;
+  bool QueueRelease() const;
+  bool MergeQueuedRelease() const;
+  void Destroy() const;
+
+  const DestroyFunction destroy_;
+  BiasedRefCountOwner* const owner_;
+  // Only touched by the owner thread, or by others after it has exited.
+  mutable int biased_;
+  mutable bool merged_;
+  // Bit 0 is set once |biased_| has been merged in; the count is kept in the
+  // remaining bits.
+  mutable volatile subtle::Atomic32 shared_;
+#ifndef NDEBUG
+  mutable bool in_dtor_;
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(BiasedRefCountedBase);
+};
+
 }  // namespace subtle
 
 //
@@ -142,8 +235,9 @@ class RefCounted : public subtle::RefCountedBase {
   DISALLOW_COPY_AND_ASSIGN(RefCounted<T>);
 };
 
-// Forward declaration.
+// Forward declarations.
 template <class T, typename Traits> class RefCountedThreadSafe;
+template <typename T> struct PooledRefCountedThreadSafeTraits;
 
 // Default traits for RefCountedThreadSafe<T>.  Deletes the object when its ref
 // count reaches 0.  Overload to delete it on a different thread etc.
@@ -190,11 +284,72 @@ class RefCountedThreadSafe : public subtle::RefCountedThreadSafeBase {
 
  private:
   friend struct DefaultRefCountedThreadSafeTraits<T>;
+  friend struct PooledRefCountedThreadSafeTraits<T>;
   static void DeleteInternal(const T* x) { delete x; }
+  // Runs the destructor without freeing; see base/memory/object_pool.h.
+  static void DestroyInternal(const T* x) { x->~T(); }
 
   DISALLOW_COPY_AND_ASSIGN(RefCountedThreadSafe);
 };
 
+template <class T, typename Traits> class BiasedRefCounted;
+
+// Default traits for BiasedRefCounted<T>. Deletes the object when its ref
+// count reaches 0.
+template <typename T>
+struct DefaultBiasedRefCountedTraits {
+  static void Destruct(const T* x) {
+    BiasedRefCounted<T, DefaultBiasedRefCountedTraits>::DeleteInternal(x);
+  }
+};
+
+//
+// A thread-safe variant of RefCounted<T> for objects that are mostly
+// referenced from the thread that created them. On that thread AddRef() and
+// Release() cost about as much as RefCounted<T>'s; on other threads they cost
+// a little more than RefCountedThreadSafe<T>'s, and a release may be handed
+// back to the creating thread before it takes effect. Prefer
+// RefCountedThreadSafe<T> for objects that are routinely passed around.
+//
+//   class MyFoo : public base::BiasedRefCounted<MyFoo> {
+//    ...
+//    private:
+//     friend class base::BiasedRefCounted<MyFoo>;
+//     ~MyFoo();
+//   };
+template <class T, typename Traits = DefaultBiasedRefCountedTraits<T> >
+class BiasedRefCounted : public subtle::BiasedRefCountedBase {
+ public:
+  BiasedRefCounted()
+      : subtle::BiasedRefCountedBase(&BiasedRefCounted::DestroyBase) {}
+
+  void AddRef() const {
+    subtle::BiasedRefCountedBase::AddRef();
+  }
+
+  void Release() const {
+    if (subtle::BiasedRefCountedBase::Release()) {
+      Traits::Destruct(static_cast<const T*>(this));
+    }
+  }
+
+ protected:
+  ~BiasedRefCounted() {}
+
+ private:
+  friend struct DefaultBiasedRefCountedTraits<T>;
+  static void DeleteInternal(const T* x) { delete x; }
+
+  // Called when a release queued to the owner thread turns out to be the
+  // last one.
+  static void DestroyBase(const subtle::BiasedRefCountedBase* x) {
+    Traits::Destruct(
+        static_cast<const T*>(static_cast<const BiasedRefCounted*>(x)));
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(BiasedRefCounted);
+};
+
 //
 // A thread-safe wrapper for some piece of data so we can place other
 // things in scoped_refptrs<>.
@@ -291,11 +446,15 @@ class scoped_refptr {
 
   // Move constructor. This is required in addition to the conversion
   // constructor below in order for clang to warn about pessimizing moves.
-  scoped_refptr(scoped_refptr&& r) : ptr_(r.get()) { r.ptr_ = nullptr; }
+  // Moves never touch the reference count. They are noexcept so that
+  // containers move, rather than copy, their elements when they grow.
+  scoped_refptr(scoped_refptr&& r) noexcept : ptr_(r.get()) {
+    r.ptr_ = nullptr;
+  }
 
   // Move conversion constructor.
   template <typename U>
-  scoped_refptr(scoped_refptr<U>&& r) : ptr_(r.get()) {
+  scoped_refptr(scoped_refptr<U>&& r) noexcept : ptr_(r.get()) {
     r.ptr_ = nullptr;
   }
 
@@ -336,24 +495,24 @@ class scoped_refptr {
     return *this = r.get();
   }
 
-  scoped_refptr<T>& operator=(scoped_refptr<T>&& r) {
+  scoped_refptr<T>& operator=(scoped_refptr<T>&& r) noexcept {
     scoped_refptr<T>(std::move(r)).swap(*this);
     return *this;
   }
 
   template <typename U>
-  scoped_refptr<T>& operator=(scoped_refptr<U>&& r) {
+  scoped_refptr<T>& operator=(scoped_refptr<U>&& r) noexcept {
     scoped_refptr<T>(std::move(r)).swap(*this);
     return *this;
   }
 
-  void swap(T** pp) {
+  void swap(T** pp) noexcept {
     T* p = ptr_;
     ptr_ = *pp;
     *pp = p;
   }
 
-  void swap(scoped_refptr<T>& r) {
+  void swap(scoped_refptr<T>& r) noexcept {
     swap(&r.ptr_);
   }
 
@@ -6,10 +6,20 @@
 
 #include <string.h>
 
+#include <algorithm>
+
+#include "base/atomicops.h"
 #include "base/logging.h"
 
 namespace base {
 
+namespace {
+
+// Only read for diagnostics, so no barriers.
+subtle::AtomicWord g_live_count = 0;
+
+}  // namespace
+
 bool RefCountedMemory::Equals(
     const scoped_refptr<RefCountedMemory>& other) const {
   return other.get() &&
@@ -17,9 +27,18 @@ bool RefCountedMemory::Equals(
          (memcmp(front(), other->front(), size()) == 0);
 }
 
-RefCountedMemory::RefCountedMemory() {}
+RefCountedMemory::RefCountedMemory() {
+  subtle::NoBarrier_AtomicIncrement(&g_live_count, 1);
+}
 
-RefCountedMemory::~RefCountedMemory() {}
+RefCountedMemory::~RefCountedMemory() {
+  subtle::NoBarrier_AtomicIncrement(&g_live_count, -1);
+}
+
+// static
+size_t RefCountedMemory::GetLiveCount() {
+  return static_cast<size_t>(subtle::NoBarrier_Load(&g_live_count));
+}
 
 const unsigned char* RefCountedStaticMemory::front() const {
   return data_;
@@ -80,4 +99,121 @@ size_t RefCountedString::size() const {
   return data_.size();
 }
 
+RefCountedMemoryChain::RefCountedMemoryChain() : size_(0) {}
+
+RefCountedMemoryChain::~RefCountedMemoryChain() {}
+
+void RefCountedMemoryChain::Append(
+    const scoped_refptr<RefCountedMemory>& memory) {
+  Append(memory, 0, memory->size());
+}
+
+void RefCountedMemoryChain::Append(
+    const scoped_refptr<RefCountedMemory>& memory,
+    size_t offset,
+    size_t length) {
+  DCHECK(memory.get());
+  DCHECK_LE(offset, memory->size());
+  DCHECK_LE(length, memory->size() - offset);
+  if (!length)
+    return;
+  Piece piece;
+  piece.memory = memory;
+  piece.offset = offset;
+  piece.length = length;
+  piece.start = size_;
+  slices_.push_back(piece);
+  size_ += length;
+
+  AutoLock lock(flatten_lock_);
+  std::vector<unsigned char>().swap(flattened_);
+}
+
+void RefCountedMemoryChain::AppendChain(const RefCountedMemoryChain& chain) {
+  DCHECK_NE(&chain, this);
+  for (const Piece& piece : chain.slices_)
+    Append(piece.memory, piece.offset, piece.length);
+}
+
+scoped_refptr<RefCountedMemoryChain> RefCountedMemoryChain::Slice(
+    size_t offset,
+    size_t length) const {
+  DCHECK_LE(offset, size_);
+  DCHECK_LE(length, size_ - offset);
+  scoped_refptr<RefCountedMemoryChain> result(new RefCountedMemoryChain);
+  if (!length)
+    return result;
+  for (size_t i = FindSlice(offset); length; ++i) {
+    const Piece& piece = slices_[i];
+    const size_t skip = offset - piece.start;
+    const size_t take = std::min(length, piece.length - skip);
+    result->Append(piece.memory, piece.offset + skip, take);
+    offset += take;
+    length -= take;
+  }
+  return result;
+}
+
+void RefCountedMemoryChain::CopyTo(size_t offset,
+                                   size_t length,
+                                   void* dest) const {
+  DCHECK_LE(offset, size_);
+  DCHECK_LE(length, size_ - offset);
+  if (!length)
+    return;
+  unsigned char* out = static_cast<unsigned char*>(dest);
+  for (size_t i = FindSlice(offset); length; ++i) {
+    const Piece& piece = slices_[i];
+    const size_t skip = offset - piece.start;
+    const size_t take = std::min(length, piece.length - skip);
+    memcpy(out, slice_data(i) + skip, take);
+    out += take;
+    offset += take;
+    length -= take;
+  }
+}
+
+const unsigned char* RefCountedMemoryChain::slice_data(size_t index) const {
+  const Piece& piece = slices_[index];
+  return piece.memory->front() + piece.offset;
+}
+
+#if defined(OS_POSIX)
+void RefCountedMemoryChain::GetIOVecs(std::vector<struct iovec>* iovecs) const {
+  iovecs->reserve(iovecs->size() + slices_.size());
+  for (size_t i = 0; i < slices_.size(); ++i) {
+    struct iovec iov;
+    iov.iov_base = const_cast<unsigned char*>(slice_data(i));
+    iov.iov_len = slices_[i].length;
+    iovecs->push_back(iov);
+  }
+}
+#endif
+
+const unsigned char* RefCountedMemoryChain::front() const {
+  if (slices_.empty())
+    return NULL;
+  if (slices_.size() == 1)
+    return slice_data(0);
+  AutoLock lock(flatten_lock_);
+  if (flattened_.empty()) {
+    flattened_.resize(size_);
+    CopyTo(0, size_, &flattened_[0]);
+  }
+  return &flattened_[0];
+}
+
+size_t RefCountedMemoryChain::size() const {
+  return size_;
+}
+
+size_t RefCountedMemoryChain::FindSlice(size_t offset) const {
+  DCHECK_LT(offset, size_);
+  // The last piece starting at or before |offset|.
+  std::vector<Piece>::const_iterator it = std::upper_bound(
+      slices_.begin(), slices_.end(), offset,
+      [](size_t value, const Piece& piece) { return value < piece.start; });
+  return static_cast<size_t>(it - slices_.begin()) - 1;
+}
+
 }  //  namespace base
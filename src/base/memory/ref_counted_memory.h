@@ -14,6 +14,12 @@
 #include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "build/build_config.h"
+
+#if defined(OS_POSIX)
+#include <sys/uio.h>
+#endif
 
 namespace base {
 
@@ -38,6 +44,9 @@ class BASE_EXPORT RefCountedMemory
     return reinterpret_cast<const T*>(front());
   }
 
+  // Number of RefCountedMemory objects alive in the process, of any kind.
+  static size_t GetLiveCount();
+
  protected:
   friend class base::RefCountedThreadSafe<RefCountedMemory>;
   RefCountedMemory();
@@ -124,6 +133,74 @@ class BASE_EXPORT RefCountedString : public RefCountedMemory {
   DISALLOW_COPY_AND_ASSIGN(RefCountedString);
 };
 
+// An implementation of RefCountedMemory made of slices of other
+// RefCountedMemory objects, for assembling data, such as a header, a cached
+// body and a trailer, without copying it. The slices are referenced, not
+// copied; front() copies them into one buffer only when there is more than
+// one, and only on the first call after the chain changes. Write the chain
+// out with writev() using GetIOVecs() to avoid that copy altogether.
+//
+// Appending must not race with reading the chain on another thread.
+class BASE_EXPORT RefCountedMemoryChain : public RefCountedMemory {
+ public:
+  RefCountedMemoryChain();
+
+  // Appends all of |memory|, or |length| bytes of it starting at |offset|.
+  // Empty slices are dropped.
+  void Append(const scoped_refptr<RefCountedMemory>& memory);
+  void Append(const scoped_refptr<RefCountedMemory>& memory,
+              size_t offset,
+              size_t length);
+
+  // Appends the slices of |chain|, sharing its memory rather than |chain|
+  // itself.
+  void AppendChain(const RefCountedMemoryChain& chain);
+
+  // Returns a new chain referencing |length| bytes starting at |offset|.
+  scoped_refptr<RefCountedMemoryChain> Slice(size_t offset,
+                                             size_t length) const;
+
+  // Copies |length| bytes starting at |offset| into |dest|.
+  void CopyTo(size_t offset, size_t length, void* dest) const;
+
+  size_t slice_count() const { return slices_.size(); }
+  const unsigned char* slice_data(size_t index) const;
+  size_t slice_size(size_t index) const { return slices_[index].length; }
+
+#if defined(OS_POSIX)
+  // Appends one iovec per slice to |iovecs|, for writev() and friends.
+  void GetIOVecs(std::vector<struct iovec>* iovecs) const;
+#endif
+
+  // Overridden from RefCountedMemory:
+  const unsigned char* front() const override;
+  size_t size() const override;
+
+ private:
+  // One slice of the chain.
+  struct Piece {
+    scoped_refptr<RefCountedMemory> memory;
+    size_t offset;
+    size_t length;
+    // Offset of the slice within the chain.
+    size_t start;
+  };
+
+  ~RefCountedMemoryChain() override;
+
+  // Returns the index of the slice containing chain offset |offset|.
+  size_t FindSlice(size_t offset) const;
+
+  std::vector<Piece> slices_;
+  size_t size_;
+
+  // Guards |flattened_|, which front() fills in on demand.
+  mutable Lock flatten_lock_;
+  mutable std::vector<unsigned char> flattened_;
+
+  DISALLOW_COPY_AND_ASSIGN(RefCountedMemoryChain);
+};
+
 }  // namespace base
 
 #endif  // BASE_MEMORY_REF_COUNTED_MEMORY_H_
@@ -58,6 +58,14 @@ struct BASE_EXPORT SharedMemoryCreateOptions {
 
   // If true, the file can be shared read-only to a process.
   bool share_read_only;
+
+#if defined(OS_LINUX)
+  // If true, back an anonymous object with explicit huge pages
+  // (MFD_HUGETLB). The size is rounded up to the huge page size and the pages
+  // are reserved up front; if the huge page pool cannot hold them, Create()
+  // silently falls back to ordinary pages. See also MAP_FLAG_HUGE_PAGES.
+  bool huge_pages;
+#endif
 };
 
 // Platform abstraction for shared memory.  Provides a C++ wrapper
@@ -192,6 +200,22 @@ class BASE_EXPORT SharedMemory {
   bool MapAt(off_t offset, size_t bytes);
   enum { MAP_MINIMUM_ALIGNMENT = 32 };
 
+#if defined(OS_LINUX)
+  // Flags for MapAtWithFlags(), for segments on latency-critical paths.
+  enum MapFlags {
+    // Faults in every page of the mapping up front (MAP_POPULATE), so the
+    // first touch of each page does not take a page fault.
+    MAP_FLAG_PREFAULT = 1 << 0,
+    // Asks for transparent huge pages (MADV_HUGEPAGE). This is only a hint;
+    // for shmem it takes effect when
+    // /sys/kernel/mm/transparent_hugepage/shmem_enabled is "advise".
+    MAP_FLAG_HUGE_PAGES = 1 << 1,
+  };
+
+  // Same as MapAt(), with a bitmask of MapFlags.
+  bool MapAtWithFlags(off_t offset, size_t bytes, int flags);
+#endif
+
   // Unmaps the shared memory from the caller's address space.
   // Returns true if successful; returns false on error or if the
   // memory is not mapped.
@@ -267,7 +291,7 @@ class BASE_EXPORT SharedMemory {
 
  private:
 #if defined(OS_POSIX) && !defined(OS_NACL) && !defined(OS_ANDROID)
-  bool PrepareMapFile(ScopedFILE fp, ScopedFD readonly);
+  bool PrepareMapFile(ScopedFD fd, ScopedFD readonly);
 #if !(defined(OS_MACOSX) && !defined(OS_IOS))
   bool FilePathForMemoryName(const std::string& mem_name, FilePath* path);
 #endif
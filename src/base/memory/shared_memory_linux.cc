@@ -0,0 +1,513 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/shared_memory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <limits>
+
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_restrictions.h"
+
+// Older C libraries do not know about memfd_create() and file sealing.
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#define MFD_ALLOW_SEALING 0x0002U
+#endif
+#ifndef MFD_HUGETLB
+#define MFD_HUGETLB 0x0004U
+#endif
+#ifndef F_ADD_SEALS
+#define F_ADD_SEALS 1033
+#define F_SEAL_SEAL 0x0001
+#define F_SEAL_SHRINK 0x0002
+#define F_SEAL_GROW 0x0004
+#endif
+
+namespace base {
+
+namespace {
+
+int MemfdCreate(const char* name, unsigned int flags) {
+#if defined(__NR_memfd_create)
+  return static_cast<int>(syscall(__NR_memfd_create, name, flags));
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+// Seals the size of memfd |fd|.
+bool SealSize(int fd) {
+  return HANDLE_EINTR(fcntl(fd, F_ADD_SEALS,
+                            F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)) == 0;
+}
+
+// Creates an anonymous memfd of |size| bytes with its size sealed. Returns an
+// invalid fd if the kernel lacks memfd_create() (before Linux 3.17) or the fd
+// cannot be set up, so that the caller can fall back to /dev/shm.
+ScopedFD CreateMemfd(size_t size, bool huge_pages) {
+  const unsigned int flags = MFD_CLOEXEC | MFD_ALLOW_SEALING;
+  if (huge_pages) {
+    // MFD_HUGETLB files must be sized in whole huge pages, and the pages are
+    // only taken from the pool at fault time. Reserve them now with
+    // fallocate() so that a short pool turns into a fallback here rather than
+    // a SIGBUS later. hugetlbfs only supports sealing from Linux 4.16 on.
+    ScopedFD fd(MemfdCreate("base_shared_memory", flags | MFD_HUGETLB));
+    struct stat st;
+    if (fd.is_valid() && fstat(fd.get(), &st) == 0 && st.st_blksize > 0) {
+      const size_t huge_page_size = static_cast<size_t>(st.st_blksize);
+      const size_t rounded_size =
+          (size + huge_page_size - 1) & ~(huge_page_size - 1);
+      if (HANDLE_EINTR(ftruncate(fd.get(), rounded_size)) == 0 &&
+          HANDLE_EINTR(fallocate(fd.get(), 0, 0, rounded_size)) == 0 &&
+          SealSize(fd.get())) {
+        return fd;
+      }
+    }
+    DPLOG(WARNING) << "Huge pages unavailable, using regular pages";
+  }
+
+  ScopedFD fd(MemfdCreate("base_shared_memory", flags));
+  if (!fd.is_valid())
+    return fd;
+  if (HANDLE_EINTR(ftruncate(fd.get(), size)) != 0) {
+    DPLOG(ERROR) << "ftruncate";
+    return ScopedFD();
+  }
+  if (!SealSize(fd.get())) {
+    DPLOG(ERROR) << "fcntl(F_ADD_SEALS)";
+    return ScopedFD();
+  }
+  return fd;
+}
+
+// Reopens |fd| read-only. Unlike dup(), this yields an open file description
+// without write access, which is what read-only sharing requires.
+ScopedFD ReopenReadOnly(int fd) {
+  std::string path = StringPrintf("/proc/self/fd/%d", fd);
+  return ScopedFD(HANDLE_EINTR(open(path.c_str(), O_RDONLY | O_CLOEXEC)));
+}
+
+}  // namespace
+
+SharedMemoryCreateOptions::SharedMemoryCreateOptions()
+    : name_deprecated(nullptr),
+      open_existing_deprecated(false),
+      size(0),
+      executable(false),
+      share_read_only(false),
+      huge_pages(false) {}
+
+SharedMemory::SharedMemory()
+    : mapped_file_(-1),
+      readonly_mapped_file_(-1),
+      mapped_size_(0),
+      memory_(NULL),
+      read_only_(false),
+      requested_size_(0) {
+}
+
+SharedMemory::SharedMemory(const SharedMemoryHandle& handle, bool read_only)
+    : mapped_file_(handle.fd),
+      readonly_mapped_file_(-1),
+      mapped_size_(0),
+      memory_(NULL),
+      read_only_(read_only),
+      requested_size_(0) {
+}
+
+SharedMemory::~SharedMemory() {
+  Unmap();
+  Close();
+}
+
+// static
+bool SharedMemory::IsHandleValid(const SharedMemoryHandle& handle) {
+  return handle.fd >= 0;
+}
+
+// static
+SharedMemoryHandle SharedMemory::NULLHandle() {
+  return SharedMemoryHandle();
+}
+
+// static
+void SharedMemory::CloseHandle(const SharedMemoryHandle& handle) {
+  DCHECK_GE(handle.fd, 0);
+  if (IGNORE_EINTR(close(handle.fd)) < 0)
+    DPLOG(ERROR) << "close";
+}
+
+// static
+size_t SharedMemory::GetHandleLimit() {
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY)
+    return 256;
+  return static_cast<size_t>(limit.rlim_cur);
+}
+
+// static
+SharedMemoryHandle SharedMemory::DuplicateHandle(
+    const SharedMemoryHandle& handle) {
+  int duped_handle = HANDLE_EINTR(dup(handle.fd));
+  if (duped_handle < 0)
+    return SharedMemory::NULLHandle();
+  return FileDescriptor(duped_handle, true);
+}
+
+// static
+int SharedMemory::GetFdFromSharedMemoryHandle(
+    const SharedMemoryHandle& handle) {
+  return handle.fd;
+}
+
+// static
+bool SharedMemory::GetSizeFromSharedMemoryHandle(
+    const SharedMemoryHandle& handle,
+    size_t* size) {
+  struct stat st;
+  if (fstat(handle.fd, &st) != 0)
+    return false;
+  if (st.st_size < 0)
+    return false;
+  *size = st.st_size;
+  return true;
+}
+
+bool SharedMemory::CreateAndMapAnonymous(size_t size) {
+  return CreateAnonymous(size) && Map(size);
+}
+
+// Anonymous objects are memfds: they never touch a filesystem, need no
+// cleanup if we crash, and are sealed against resizing so that a peer cannot
+// truncate the object under our mapping and make us SIGBUS. Kernels without
+// memfd_create() fall back to an unlinked file in /dev/shm.
+bool SharedMemory::Create(const SharedMemoryCreateOptions& options) {
+  DCHECK_EQ(-1, mapped_file_);
+  if (options.size == 0)
+    return false;
+
+  if (options.size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  // This function theoretically can block on the disk, but realistically
+  // the temporary files we create will just go into the buffer cache
+  // and be deleted before they ever make it out to disk.
+  ThreadRestrictions::ScopedAllowIO allow_io;
+
+  ScopedFD fd;
+  ScopedFD readonly_fd;
+  bool fix_size = true;
+  FilePath path;
+  if (options.name_deprecated == NULL || options.name_deprecated->empty()) {
+    fd = CreateMemfd(options.size, options.huge_pages);
+    if (fd.is_valid()) {
+      fix_size = false;
+      if (options.share_read_only) {
+        readonly_fd = ReopenReadOnly(fd.get());
+        if (!readonly_fd.is_valid()) {
+          DPLOG(ERROR) << "open(\"/proc/self/fd/\") failed";
+          return false;
+        }
+      }
+    } else {
+      DCHECK(!options.open_existing_deprecated);
+      FilePath directory;
+      if (!GetShmemTempDir(options.executable, &directory))
+        return false;
+      ScopedFILE fp(CreateAndOpenTemporaryFileInDir(directory, &path));
+      if (!fp) {
+        PLOG(ERROR) << "Creating shared memory in " << directory.value()
+                    << " failed";
+        return false;
+      }
+      fd.reset(HANDLE_EINTR(dup(fileno(fp.get()))));
+      if (options.share_read_only) {
+        // Also open as readonly so that we can ShareReadOnlyToProcess.
+        readonly_fd.reset(HANDLE_EINTR(open(path.value().c_str(), O_RDONLY)));
+        if (!readonly_fd.is_valid()) {
+          DPLOG(ERROR) << "open(\"" << path.value() << "\", O_RDONLY) failed";
+          fd.reset();
+        }
+      }
+      // Deleting the file prevents anyone else from mapping it in (making it
+      // private), and prevents the need for cleanup (once the last fd is
+      // closed, it is truly freed).
+      if (!DeleteFile(path, false))
+        PLOG(WARNING) << "unlink";
+    }
+  } else {
+    if (!FilePathForMemoryName(*options.name_deprecated, &path))
+      return false;
+
+    // Make sure that the file is opened without any permission
+    // to other users on the system.
+    const mode_t kOwnerOnly = S_IRUSR | S_IWUSR;
+
+    // First, try to create the file.
+    fd.reset(HANDLE_EINTR(
+        open(path.value().c_str(), O_RDWR | O_CREAT | O_EXCL, kOwnerOnly)));
+    if (!fd.is_valid() && options.open_existing_deprecated) {
+      // If this doesn't work, try and open an existing file in append mode.
+      // Opening an existing file in a world writable directory has two main
+      // security implications:
+      // - Attackers could plant a file under their control, so ownership of
+      //   the file is checked below.
+      // - Attackers could plant a symbolic link so that an unexpected file
+      //   is opened, so O_NOFOLLOW is passed to open().
+      fd.reset(HANDLE_EINTR(open(path.value().c_str(), O_RDWR | O_NOFOLLOW)));
+
+      // Check that the current user owns the file.
+      // If uid != euid, then a more complex permission model is used and this
+      // API is not appropriate.
+      const uid_t real_uid = getuid();
+      const uid_t effective_uid = geteuid();
+      struct stat sb;
+      if (fd.is_valid() &&
+          (fstat(fd.get(), &sb) != 0 || sb.st_uid != real_uid ||
+           sb.st_uid != effective_uid)) {
+        LOG(ERROR) << "Invalid owner when opening existing shared memory file.";
+        return false;
+      }
+
+      // An existing file was opened, so its size should not be fixed.
+      fix_size = false;
+    }
+
+    if (options.share_read_only) {
+      // Also open as readonly so that we can ShareReadOnlyToProcess.
+      readonly_fd.reset(HANDLE_EINTR(open(path.value().c_str(), O_RDONLY)));
+      if (!readonly_fd.is_valid()) {
+        DPLOG(ERROR) << "open(\"" << path.value() << "\", O_RDONLY) failed";
+        fd.reset();
+      }
+    }
+  }
+
+  if (fd.is_valid() && fix_size) {
+    // Get current size.
+    struct stat stat;
+    if (fstat(fd.get(), &stat) != 0)
+      return false;
+    const size_t current_size = stat.st_size;
+    if (current_size != options.size) {
+      if (HANDLE_EINTR(ftruncate(fd.get(), options.size)) != 0)
+        return false;
+    }
+  }
+  requested_size_ = options.size;
+
+  if (!fd.is_valid()) {
+    PLOG(ERROR) << "Creating shared memory in " << path.value() << " failed";
+    return false;
+  }
+
+  return PrepareMapFile(std::move(fd), std::move(readonly_fd));
+}
+
+// Our current implementation of shmem is with mmap()ing of files.
+// These files need to be deleted explicitly.
+// In practice this call is only needed for unit tests.
+bool SharedMemory::Delete(const std::string& name) {
+  FilePath path;
+  if (!FilePathForMemoryName(name, &path))
+    return false;
+
+  if (PathExists(path))
+    return DeleteFile(path, false);
+
+  // Doesn't exist, so success.
+  return true;
+}
+
+bool SharedMemory::Open(const std::string& name, bool read_only) {
+  FilePath path;
+  if (!FilePathForMemoryName(name, &path))
+    return false;
+
+  read_only_ = read_only;
+
+  ScopedFD fd(HANDLE_EINTR(
+      open(path.value().c_str(), read_only ? O_RDONLY : O_RDWR)));
+  ScopedFD readonly_fd(HANDLE_EINTR(open(path.value().c_str(), O_RDONLY)));
+  if (!readonly_fd.is_valid()) {
+    DPLOG(ERROR) << "open(\"" << path.value() << "\", O_RDONLY) failed";
+    return false;
+  }
+  return PrepareMapFile(std::move(fd), std::move(readonly_fd));
+}
+
+bool SharedMemory::MapAt(off_t offset, size_t bytes) {
+  return MapAtWithFlags(offset, bytes, 0);
+}
+
+bool SharedMemory::MapAtWithFlags(off_t offset, size_t bytes, int flags) {
+  if (mapped_file_ == -1)
+    return false;
+
+  if (bytes > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return false;
+
+  if (memory_)
+    return false;
+
+  // Mappings of huge page backed objects must cover whole huge pages. The
+  // block size reported for an ordinary memfd or tmpfs file is the base page
+  // size, so this only rounds for MFD_HUGETLB objects.
+  struct stat st;
+  if (fstat(mapped_file_, &st) == 0 && st.st_blksize > getpagesize()) {
+    const size_t huge_page_size = static_cast<size_t>(st.st_blksize);
+    bytes = (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+  }
+
+  int mmap_flags = MAP_SHARED;
+  if (flags & MAP_FLAG_PREFAULT)
+    mmap_flags |= MAP_POPULATE;
+
+  memory_ = mmap(NULL, bytes, PROT_READ | (read_only_ ? 0 : PROT_WRITE),
+                 mmap_flags, mapped_file_, offset);
+
+  bool mmap_succeeded = memory_ != MAP_FAILED && memory_ != NULL;
+  if (mmap_succeeded) {
+    mapped_size_ = bytes;
+    DCHECK_EQ(0U, reinterpret_cast<uintptr_t>(memory_) &
+        (SharedMemory::MAP_MINIMUM_ALIGNMENT - 1));
+#if defined(MADV_HUGEPAGE)
+    // Failure only means the kernel ignores the hint.
+    if (flags & MAP_FLAG_HUGE_PAGES)
+      madvise(memory_, bytes, MADV_HUGEPAGE);
+#endif
+  } else {
+    memory_ = NULL;
+  }
+
+  return mmap_succeeded;
+}
+
+bool SharedMemory::Unmap() {
+  if (memory_ == NULL)
+    return false;
+
+  munmap(memory_, mapped_size_);
+  memory_ = NULL;
+  mapped_size_ = 0;
+  return true;
+}
+
+SharedMemoryHandle SharedMemory::handle() const {
+  return FileDescriptor(mapped_file_, false);
+}
+
+void SharedMemory::Close() {
+  if (mapped_file_ != -1) {
+    if (IGNORE_EINTR(close(mapped_file_)) < 0)
+      PLOG(ERROR) << "close";
+    mapped_file_ = -1;
+  }
+  if (readonly_mapped_file_ != -1) {
+    if (IGNORE_EINTR(close(readonly_mapped_file_)) < 0)
+      PLOG(ERROR) << "close";
+    readonly_mapped_file_ = -1;
+  }
+}
+
+bool SharedMemory::PrepareMapFile(ScopedFD fd, ScopedFD readonly_fd) {
+  DCHECK_EQ(-1, mapped_file_);
+  DCHECK_EQ(-1, readonly_mapped_file_);
+  if (!fd.is_valid())
+    return false;
+
+  // This function theoretically can block on the disk, but realistically
+  // the temporary files we create will just go into the buffer cache
+  // and be deleted before they ever make it out to disk.
+  ThreadRestrictions::ScopedAllowIO allow_io;
+
+  if (readonly_fd.is_valid()) {
+    struct stat st = {};
+    if (fstat(fd.get(), &st))
+      NOTREACHED();
+
+    struct stat readonly_st = {};
+    if (fstat(readonly_fd.get(), &readonly_st))
+      NOTREACHED();
+    if (st.st_dev != readonly_st.st_dev || st.st_ino != readonly_st.st_ino) {
+      LOG(ERROR) << "writable and read-only inodes don't match; bailing";
+      return false;
+    }
+  }
+
+  mapped_file_ = fd.release();
+  readonly_mapped_file_ = readonly_fd.release();
+  return true;
+}
+
+// For the given shmem named |mem_name|, return a filename to mmap()
+// (and possibly create).  Modifies |filename|.  Return false on
+// error, or true of we are happy.
+bool SharedMemory::FilePathForMemoryName(const std::string& mem_name,
+                                         FilePath* path) {
+  // mem_name will be used for a filename; make sure it doesn't
+  // contain anything which will confuse us.
+  DCHECK_EQ(std::string::npos, mem_name.find('/'));
+  DCHECK_EQ(std::string::npos, mem_name.find('\0'));
+
+  FilePath temp_dir;
+  if (!GetShmemTempDir(false, &temp_dir))
+    return false;
+
+  *path = temp_dir.AppendASCII("org.chromium.Chromium.shmem." + mem_name);
+  return true;
+}
+
+bool SharedMemory::ShareToProcessCommon(ProcessHandle process,
+                                        SharedMemoryHandle* new_handle,
+                                        bool close_self,
+                                        ShareMode share_mode) {
+  int handle_to_dup = -1;
+  switch (share_mode) {
+    case SHARE_CURRENT_MODE:
+      handle_to_dup = mapped_file_;
+      break;
+    case SHARE_READONLY:
+      CHECK_GE(readonly_mapped_file_, 0);
+      handle_to_dup = readonly_mapped_file_;
+      break;
+  }
+
+  const int new_fd = HANDLE_EINTR(dup(handle_to_dup));
+  if (new_fd < 0) {
+    if (close_self) {
+      Unmap();
+      Close();
+    }
+    DPLOG(ERROR) << "dup() failed.";
+    return false;
+  }
+
+  new_handle->fd = new_fd;
+  new_handle->auto_close = true;
+
+  if (close_self) {
+    Unmap();
+    Close();
+  }
+
+  return true;
+}
+
+}  // namespace base
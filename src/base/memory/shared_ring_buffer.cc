@@ -0,0 +1,378 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/shared_ring_buffer.h"
+
+#include <limits.h>
+#include <string.h>
+
+#include "base/atomicops.h"
+#include "base/bits.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// The ring is a power-of-two array of records addressed by free-running 32-bit
+// positions. Each record is a RecordHeader followed by the bytes of one Pickle,
+// padded to kRecordAlignment. A writer reserves space by advancing
+// write_position, copies the message in, and then publishes the record by
+// storing its size into the header. The reader consumes records in order
+// from read_position, and zeroes them before handing the space back, so a
+// header of zero always means "not published yet". When a record would run
+// past the end of the array, the writer instead publishes a wrap marker and
+// starts the record at offset zero.
+
+namespace base {
+
+namespace {
+
+const uint32_t kMagic = 0x474e4952;  // "RING"
+const uint32_t kRecordAlignment = 8;
+const uint32_t kMinCapacity = 4096;
+const uint32_t kMaxCapacity = 1u << 30;
+const subtle::Atomic32 kWrapMarker = -1;
+
+// How many times a side yields before it sleeps on the futex. Spinning a
+// little keeps the latency down when the peer is about to catch up.
+const int kSpinCount = 16;
+
+#if defined(OS_LINUX)
+
+// These futexes live in memory shared with other processes, so they must not
+// use FUTEX_PRIVATE_FLAG.
+void FutexWait(volatile subtle::Atomic32* word, subtle::Atomic32 expected) {
+  syscall(SYS_futex, word, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+void FutexWakeAll(volatile subtle::Atomic32* word) {
+  syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+// There is no cross-process futex here, so waiters poll.
+void FutexWait(volatile subtle::Atomic32* word, subtle::Atomic32 expected) {
+  if (subtle::Acquire_Load(word) == expected)
+    PlatformThread::Sleep(TimeDelta::FromMicroseconds(50));
+}
+
+void FutexWakeAll(volatile subtle::Atomic32* word) {}
+
+#endif  // defined(OS_LINUX)
+
+}  // namespace
+
+// The indices each side writes sit on their own cache lines, so a writer and
+// the reader never contend for a line they do not both need.
+struct SharedRingBuffer::Control {
+  // One past the last byte reserved by a writer.
+  ALIGNAS(64) volatile subtle::Atomic32 write_position;
+  // The oldest record the reader has not consumed.
+  ALIGNAS(64) volatile subtle::Atomic32 read_position;
+  // Futex words. A side bumps the other side's sequence after publishing a
+  // record (or freeing space) if the other side registered as waiting.
+  ALIGNAS(64) volatile subtle::Atomic32 data_sequence;
+  volatile subtle::Atomic32 reader_waiting;
+  ALIGNAS(64) volatile subtle::Atomic32 space_sequence;
+  volatile subtle::Atomic32 writers_waiting;
+  ALIGNAS(64) uint32_t magic;
+  uint32_t capacity;
+  uint32_t mode;
+  volatile subtle::Atomic32 shutdown;
+};
+
+struct SharedRingBuffer::RecordHeader {
+  // Total size of the record, including this header. Zero until the record
+  // is published, or kWrapMarker.
+  volatile subtle::Atomic32 size;
+  uint32_t message_size;
+};
+
+// static
+size_t SharedRingBuffer::RequiredMemorySize(size_t capacity) {
+  return sizeof(Control) + capacity;
+}
+
+// static
+bool SharedRingBuffer::Initialize(void* memory, size_t memory_size, Mode mode) {
+  DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(memory) % ALIGNOF(Control));
+  if (memory_size < sizeof(Control))
+    return false;
+  const size_t capacity = memory_size - sizeof(Control);
+  if (capacity < kMinCapacity || capacity > kMaxCapacity ||
+      (capacity & (capacity - 1)) != 0) {
+    return false;
+  }
+
+  memset(memory, 0, memory_size);
+  Control* control = static_cast<Control*>(memory);
+  control->magic = kMagic;
+  control->capacity = static_cast<uint32_t>(capacity);
+  control->mode = mode;
+  return true;
+}
+
+SharedRingBuffer::SharedRingBuffer()
+    : control_(NULL),
+      data_(NULL),
+      capacity_(0),
+      multi_writer_(false),
+      peeked_size_(0) {}
+
+SharedRingBuffer::~SharedRingBuffer() {
+  DCHECK_EQ(0u, peeked_size_);
+}
+
+bool SharedRingBuffer::Attach(void* memory, size_t memory_size) {
+  DCHECK(!control_);
+  if (memory_size < sizeof(Control))
+    return false;
+  Control* control = static_cast<Control*>(memory);
+  // Copy the fields out once; the peer could change them at any time.
+  const uint32_t capacity = control->capacity;
+  const uint32_t mode = control->mode;
+  if (control->magic != kMagic || capacity < kMinCapacity ||
+      capacity > kMaxCapacity || (capacity & (capacity - 1)) != 0 ||
+      memory_size - sizeof(Control) != capacity ||
+      (mode != SINGLE_WRITER && mode != MULTI_WRITER)) {
+    return false;
+  }
+
+  control_ = control;
+  data_ = static_cast<char*>(memory) + sizeof(Control);
+  capacity_ = capacity;
+  multi_writer_ = mode == MULTI_WRITER;
+  return true;
+}
+
+size_t SharedRingBuffer::max_message_size() const {
+  // Records of at most half the ring always fit once the ring drains, even
+  // when they have to wrap.
+  return capacity_ / 2 - sizeof(RecordHeader);
+}
+
+bool SharedRingBuffer::TryWrite(const Pickle& message) {
+  return WriteImpl(message, false);
+}
+
+bool SharedRingBuffer::Write(const Pickle& message) {
+  return WriteImpl(message, true);
+}
+
+bool SharedRingBuffer::TryRead(Pickle* message) {
+  size_t size;
+  const char* data = Peek(&size);
+  if (!data)
+    return false;
+  Pickle view(data, static_cast<int>(size));
+  const bool valid = view.data() != NULL;
+  if (valid)
+    *message = view;
+  Pop();
+  if (!valid) {
+    DLOG(ERROR) << "Malformed Pickle in SharedRingBuffer";
+    Shutdown();
+  }
+  return valid;
+}
+
+bool SharedRingBuffer::Read(Pickle* message) {
+  DCHECK(control_);
+  for (int spins = 0;; ++spins) {
+    if (TryRead(message))
+      return true;
+    if (IsShutdown())
+      return HasRecord() && TryRead(message);
+    if (spins < kSpinCount) {
+      PlatformThread::YieldCurrentThread();
+      continue;
+    }
+
+    const subtle::Atomic32 sequence =
+        subtle::Acquire_Load(&control_->data_sequence);
+    subtle::NoBarrier_Store(&control_->reader_waiting, 1);
+    // Pairs with the barrier in WriteImpl(): either the writer sees
+    // |reader_waiting| or we see its record.
+    subtle::MemoryBarrier();
+    if (!HasRecord() && !IsShutdown())
+      FutexWait(&control_->data_sequence, sequence);
+    subtle::NoBarrier_Store(&control_->reader_waiting, 0);
+  }
+}
+
+const char* SharedRingBuffer::Peek(size_t* size) {
+  DCHECK(control_);
+  DCHECK_EQ(0u, peeked_size_);
+  for (;;) {
+    const uint32_t read =
+        static_cast<uint32_t>(subtle::NoBarrier_Load(&control_->read_position));
+    const uint32_t offset = read & (capacity_ - 1);
+    RecordHeader* header = HeaderAt(read);
+    const subtle::Atomic32 record_size = subtle::Acquire_Load(&header->size);
+    if (record_size == 0)
+      return NULL;
+
+    if (record_size == kWrapMarker) {
+      subtle::NoBarrier_Store(&header->size, 0);
+      Advance(capacity_ - offset);
+      continue;
+    }
+
+    const uint32_t message_size = header->message_size;
+    const uint32_t size_bytes = static_cast<uint32_t>(record_size);
+    if (size_bytes % kRecordAlignment != 0 ||
+        size_bytes > capacity_ - offset ||
+        message_size < sizeof(Pickle::Header) ||
+        message_size > size_bytes - sizeof(RecordHeader)) {
+      DLOG(ERROR) << "Corrupt SharedRingBuffer record";
+      Shutdown();
+      return NULL;
+    }
+
+    peeked_size_ = size_bytes;
+    *size = message_size;
+    return reinterpret_cast<const char*>(header + 1);
+  }
+}
+
+void SharedRingBuffer::Pop() {
+  DCHECK_NE(0u, peeked_size_);
+  const uint32_t read =
+      static_cast<uint32_t>(subtle::NoBarrier_Load(&control_->read_position));
+  // Free space must read as zero; see the comment at the top of the file.
+  memset(HeaderAt(read), 0, peeked_size_);
+  Advance(peeked_size_);
+  peeked_size_ = 0;
+}
+
+void SharedRingBuffer::Shutdown() {
+  DCHECK(control_);
+  subtle::Release_Store(&control_->shutdown, 1);
+  subtle::Barrier_AtomicIncrement(&control_->data_sequence, 1);
+  subtle::Barrier_AtomicIncrement(&control_->space_sequence, 1);
+  FutexWakeAll(&control_->data_sequence);
+  FutexWakeAll(&control_->space_sequence);
+}
+
+bool SharedRingBuffer::IsShutdown() const {
+  return subtle::Acquire_Load(&control_->shutdown) != 0;
+}
+
+SharedRingBuffer::RecordHeader* SharedRingBuffer::HeaderAt(
+    uint32_t position) const {
+  return reinterpret_cast<RecordHeader*>(data_ + (position & (capacity_ - 1)));
+}
+
+bool SharedRingBuffer::Reserve(uint32_t record_size, uint32_t* position) {
+  for (;;) {
+    uint32_t write = static_cast<uint32_t>(
+        subtle::NoBarrier_Load(&control_->write_position));
+    // Acquire pairs with the release in Advance(), so the reader's zeroing
+    // of the freed space happens before we write into it.
+    const uint32_t read =
+        static_cast<uint32_t>(subtle::Acquire_Load(&control_->read_position));
+    const uint32_t contiguous = capacity_ - (write & (capacity_ - 1));
+    const uint32_t needed =
+        record_size <= contiguous ? record_size : contiguous + record_size;
+    if (write - read > capacity_ || capacity_ - (write - read) < needed)
+      return false;
+
+    if (multi_writer_) {
+      if (subtle::NoBarrier_CompareAndSwap(
+              &control_->write_position, static_cast<subtle::Atomic32>(write),
+              static_cast<subtle::Atomic32>(write + needed)) !=
+          static_cast<subtle::Atomic32>(write)) {
+        continue;
+      }
+    } else {
+      subtle::NoBarrier_Store(&control_->write_position,
+                              static_cast<subtle::Atomic32>(write + needed));
+    }
+
+    if (needed != record_size) {
+      RecordHeader* wrap = HeaderAt(write);
+      wrap->message_size = 0;
+      subtle::Release_Store(&wrap->size, kWrapMarker);
+      write += contiguous;
+    }
+    *position = write;
+    return true;
+  }
+}
+
+bool SharedRingBuffer::WriteImpl(const Pickle& message, bool block) {
+  DCHECK(control_);
+  const size_t message_size = message.size();
+  if (message_size > max_message_size())
+    return false;
+  const uint32_t record_size = static_cast<uint32_t>(
+      bits::Align(sizeof(RecordHeader) + message_size, kRecordAlignment));
+
+  uint32_t position;
+  for (int spins = 0;; ++spins) {
+    if (IsShutdown())
+      return false;
+    if (Reserve(record_size, &position))
+      break;
+    if (!block)
+      return false;
+    if (spins < kSpinCount) {
+      PlatformThread::YieldCurrentThread();
+      continue;
+    }
+
+    const subtle::Atomic32 sequence =
+        subtle::Acquire_Load(&control_->space_sequence);
+    // Full barrier: pairs with the one in Advance().
+    subtle::Barrier_AtomicIncrement(&control_->writers_waiting, 1);
+    const bool reserved = Reserve(record_size, &position);
+    if (!reserved && !IsShutdown())
+      FutexWait(&control_->space_sequence, sequence);
+    subtle::Barrier_AtomicIncrement(&control_->writers_waiting, -1);
+    if (reserved)
+      break;
+  }
+
+  RecordHeader* header = HeaderAt(position);
+  header->message_size = static_cast<uint32_t>(message_size);
+  memcpy(header + 1, message.data(), message_size);
+  subtle::Release_Store(&header->size,
+                        static_cast<subtle::Atomic32>(record_size));
+
+  subtle::MemoryBarrier();
+  if (subtle::NoBarrier_Load(&control_->reader_waiting)) {
+    subtle::Barrier_AtomicIncrement(&control_->data_sequence, 1);
+    FutexWakeAll(&control_->data_sequence);
+  }
+  return true;
+}
+
+bool SharedRingBuffer::HasRecord() const {
+  const uint32_t read =
+      static_cast<uint32_t>(subtle::NoBarrier_Load(&control_->read_position));
+  return subtle::Acquire_Load(&HeaderAt(read)->size) != 0;
+}
+
+void SharedRingBuffer::Advance(uint32_t bytes) {
+  const uint32_t read =
+      static_cast<uint32_t>(subtle::NoBarrier_Load(&control_->read_position));
+  subtle::Release_Store(&control_->read_position,
+                        static_cast<subtle::Atomic32>(read + bytes));
+  subtle::MemoryBarrier();
+  if (subtle::NoBarrier_Load(&control_->writers_waiting)) {
+    subtle::Barrier_AtomicIncrement(&control_->space_sequence, 1);
+    FutexWakeAll(&control_->space_sequence);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,124 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_SHARED_RING_BUFFER_H_
+#define BASE_MEMORY_SHARED_RING_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+
+namespace base {
+
+class Pickle;
+
+// A message queue laid out in a block of memory that several processes map,
+// typically a SharedMemory segment. Messages are Pickles, copied into the
+// ring once by the writer and readable in place by the reader, so a message
+// costs no system calls while the reader keeps up. A side only blocks, on a
+// futex, when the ring is empty (reader) or full (writer).
+//
+// There is always exactly one reader. In SINGLE_WRITER mode there must also
+// be exactly one writer; MULTI_WRITER mode lets any number of threads or
+// processes write concurrently, at the cost of a compare-and-swap per
+// message.
+//
+// Usage:
+//   SharedMemory memory;
+//   size_t size = SharedRingBuffer::RequiredMemorySize(1 << 20);
+//   memory.CreateAndMapAnonymous(size);
+//   SharedRingBuffer::Initialize(memory.memory(), memory.mapped_size(),
+//                                SharedRingBuffer::SINGLE_WRITER);
+//   ... share memory.handle() with the peer, which maps it and Attach()es ...
+//   SharedRingBuffer ring;
+//   ring.Attach(memory.memory(), memory.mapped_size());
+//   ring.Write(pickle);
+//
+// The control block is shared with the peer, so a misbehaving peer can
+// corrupt the ring; the reader validates every record and shuts the ring
+// down rather than read out of bounds.
+class BASE_EXPORT SharedRingBuffer {
+ public:
+  enum Mode {
+    SINGLE_WRITER,
+    MULTI_WRITER,
+  };
+
+  // Returns the number of bytes of memory needed for a ring holding up to
+  // |capacity| bytes of messages. |capacity| must be a power of two of at
+  // least 4 KB.
+  static size_t RequiredMemorySize(size_t capacity);
+
+  // Formats |memory_size| bytes at |memory| as an empty ring. This must be
+  // done once, before any other process attaches. |memory_size| must equal
+  // RequiredMemorySize() of some valid capacity.
+  static bool Initialize(void* memory, size_t memory_size, Mode mode);
+
+  SharedRingBuffer();
+  ~SharedRingBuffer();
+
+  // Attaches to a ring formatted by Initialize(). |memory| must stay mapped
+  // for the lifetime of this object. Returns false if the memory does not
+  // hold a valid ring.
+  bool Attach(void* memory, size_t memory_size);
+
+  // The largest Pickle, as reported by Pickle::size(), that fits the ring.
+  size_t max_message_size() const;
+
+  // Writer side. TryWrite() returns false if the ring is full or shut down.
+  // Write() blocks until there is space and returns false only if the ring is
+  // shut down. Both fail if |message| exceeds max_message_size().
+  bool TryWrite(const Pickle& message);
+  bool Write(const Pickle& message);
+
+  // Reader side. TryRead() returns false if the ring is empty.
+  // Read() blocks until a message arrives and returns false once the ring is
+  // shut down and drained. Both copy the message out into |message|.
+  bool TryRead(Pickle* message);
+  bool Read(Pickle* message);
+
+  // Zero-copy reading: returns the next message in place, or NULL if the ring
+  // is empty, and sets |size| to its length. Construct a read-only Pickle
+  // over the data with Pickle(data, size). The data remains valid until
+  // Pop(), which must be called exactly once per non-NULL Peek().
+  const char* Peek(size_t* size);
+  void Pop();
+
+  // Makes every blocked and future Write() fail and lets Read() return false
+  // once the ring is drained. Either side may call this.
+  void Shutdown();
+  bool IsShutdown() const;
+
+ private:
+  struct Control;
+  struct RecordHeader;
+
+  RecordHeader* HeaderAt(uint32_t position) const;
+
+  // Reserves room for a record of |record_size| bytes, returning its position
+  // or false if the ring is full.
+  bool Reserve(uint32_t record_size, uint32_t* position);
+  bool WriteImpl(const Pickle& message, bool block);
+
+  // Reader helpers. HasRecord() checks for a published record (or wrap
+  // marker) without consuming it; Advance() frees |bytes| at the read
+  // position and wakes writers waiting for space.
+  bool HasRecord() const;
+  void Advance(uint32_t bytes);
+
+  Control* control_;
+  char* data_;
+  uint32_t capacity_;
+  bool multi_writer_;
+  // The record returned by the last Peek(), awaiting Pop().
+  uint32_t peeked_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedRingBuffer);
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_SHARED_RING_BUFFER_H_
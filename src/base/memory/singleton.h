@@ -22,6 +22,7 @@
 #include "base/at_exit.h"
 #include "base/atomicops.h"
 #include "base/base_export.h"
+#include "base/compiler_specific.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/threading/thread_restrictions.h"
@@ -206,10 +207,10 @@ subtle::Atomic32 StaticMemorySingletonTraits<Type>::dead_ = 0;
 // the object is allocated may be destroyed by the CRT anyway.
 //
 // Caveats:
-// (a) Every call to get(), operator->() and operator*() incurs some overhead
-//     (16ns on my P4/2.8GHz) to check whether the object has already been
-//     initialized.  You may wish to cache the result of get(); it will not
-//     change.
+// (a) Every call to get() checks whether the object has already been
+//     initialized. Once it has, that is a single acquire load (a plain load
+//     on x86) and a branch. You may still wish to cache the result of get();
+//     it will not change.
 //
 // (b) Your factory function must never throw an exception. This class is not
 //     exception-safe.
@@ -241,10 +242,13 @@ class Singleton {
     // The load has acquire memory ordering as the thread which reads the
     // instance_ pointer must acquire visibility over the singleton data.
     subtle::AtomicWord value = subtle::Acquire_Load(&instance_);
-    if (value != 0 && value != internal::kBeingCreatedMarker) {
-      return reinterpret_cast<Type*>(value);
-    }
+    if (UNLIKELY(value == 0 || value == internal::kBeingCreatedMarker))
+      return CreateInstance();
+    return reinterpret_cast<Type*>(value);
+  }
 
+  // Kept out of line so that get() inlines to a load and a branch.
+  NOINLINE static Type* CreateInstance() {
     // Object isn't created yet, maybe we will get to create it, let's try...
     if (subtle::Acquire_CompareAndSwap(&instance_, 0,
                                        internal::kBeingCreatedMarker) == 0) {
@@ -264,9 +268,7 @@ class Singleton {
     }
 
     // We hit a race. Wait for the other thread to complete it.
-    value = internal::WaitForInstance(&instance_);
-
-    return reinterpret_cast<Type*>(value);
+    return reinterpret_cast<Type*>(internal::WaitForInstance(&instance_));
   }
 
   // Adapter function for use with AtExit().  This should be called single
@@ -4,45 +4,73 @@
 
 #include "base/memory/weak_ptr.h"
 
-namespace base {
-namespace internal {
-
-WeakReference::Flag::Flag() : is_valid_(true) {
-  // Flags only become bound when checked for validity, or invalidated,
-  // so that we can check that later validity/invalidation operations on
-  // the same Flag take place on the same sequenced thread.
-  // sequence_checker_.DetachFromSequence();
-}
-
-void WeakReference::Flag::Invalidate() {
-  // The flag being invalidated with a single ref implies that there are no
-  // weak pointers in existence. Allow deletion on other thread in this case.
-  // DCHECK(sequence_checker_.CalledOnValidSequencedThread() || HasOneRef())
-  //     << "WeakPtrs must be invalidated on the same sequenced thread.";
-  is_valid_ = false;
-}
+#include <limits>
+#include <vector>
 
-bool WeakReference::Flag::IsValid() const {
-  // DCHECK(sequence_checker_.CalledOnValidSequencedThread())
-  //     << "WeakPtrs must be checked on the same sequenced thread.";
-  return is_valid_;
-}
-
-WeakReference::Flag::~Flag() {
-}
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
 
-WeakReference::WeakReference() {
-}
-
-WeakReference::WeakReference(const Flag* flag) : flag_(flag) {
-}
+namespace base {
+namespace internal {
 
-WeakReference::~WeakReference() {
+namespace {
+
+// Slot bookkeeping that only Acquire() and Release() touch.
+struct FreeSlots {
+  FreeSlots() : next_unused(0) {}
+
+  Lock lock;
+  std::vector<uint32_t> free;
+  // Slots at or beyond this index have never been handed out.
+  uint32_t next_unused;
+};
+
+LazyInstance<FreeSlots>::Leaky g_free_slots = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+volatile subtle::Atomic32* WeakSlotTable::chunks_[kMaxChunks];
+
+// static
+uint32_t WeakSlotTable::Acquire(subtle::Atomic32* generation) {
+  FreeSlots* slots = g_free_slots.Pointer();
+  AutoLock lock(slots->lock);
+  uint32_t slot;
+  if (!slots->free.empty()) {
+    slot = slots->free.back();
+    slots->free.pop_back();
+  } else {
+    slot = slots->next_unused++;
+    const uint32_t chunk = slot >> kChunkShift;
+    CHECK_LT(chunk, static_cast<uint32_t>(kMaxChunks))
+        << "Too many live WeakPtr owners";
+    if (!chunks_[chunk]) {
+      volatile subtle::Atomic32* slots_in_chunk =
+          new subtle::Atomic32[kChunkSize];
+      for (int i = 0; i < kChunkSize; ++i)
+        slots_in_chunk[i] = 1;
+      chunks_[chunk] = slots_in_chunk;
+    }
+  }
+  *generation = subtle::NoBarrier_Load(
+      &chunks_[slot >> kChunkShift][slot & (kChunkSize - 1)]);
+  return slot;
 }
 
-bool WeakReference::is_valid() const { return flag_.get() && flag_->IsValid(); }
-
-WeakReferenceOwner::WeakReferenceOwner() {
+// static
+void WeakSlotTable::Release(uint32_t slot) {
+  volatile subtle::Atomic32* generation =
+      &chunks_[slot >> kChunkShift][slot & (kChunkSize - 1)];
+  const subtle::Atomic32 next = subtle::NoBarrier_Load(generation) + 1;
+  subtle::Release_Store(generation, next);
+
+  // A slot whose generation would wrap is retired, so that no stale
+  // reference can ever match it again.
+  if (next == std::numeric_limits<subtle::Atomic32>::max())
+    return;
+  FreeSlots* slots = g_free_slots.Pointer();
+  AutoLock lock(slots->lock);
+  slots->free.push_back(slot);
 }
 
 WeakReferenceOwner::~WeakReferenceOwner() {
@@ -50,28 +78,17 @@ WeakReferenceOwner::~WeakReferenceOwner() {
 }
 
 WeakReference WeakReferenceOwner::GetRef() const {
-  // If we hold the last reference to the Flag then create a new one.
-  if (!HasRefs())
-    flag_ = new WeakReference::Flag();
-
-  return WeakReference(flag_.get());
+  if (!generation_)
+    slot_ = WeakSlotTable::Acquire(&generation_);
+  return WeakReference(slot_, generation_);
 }
 
 void WeakReferenceOwner::Invalidate() {
-  if (flag_.get()) {
-    flag_->Invalidate();
-    flag_ = NULL;
+  if (generation_) {
+    WeakSlotTable::Release(slot_);
+    generation_ = 0;
   }
 }
 
-WeakPtrBase::WeakPtrBase() {
-}
-
-WeakPtrBase::~WeakPtrBase() {
-}
-
-WeakPtrBase::WeakPtrBase(const WeakReference& ref) : ref_(ref) {
-}
-
 }  // namespace internal
 }  // namespace base
@@ -70,10 +70,12 @@
 #ifndef BASE_MEMORY_WEAK_PTR_H_
 #define BASE_MEMORY_WEAK_PTR_H_
 
+#include <stdint.h>
+
+#include "base/atomicops.h"
 #include "base/base_export.h"
 #include "base/logging.h"
 #include "base/macros.h"
-#include "base/memory/ref_counted.h"
 #include "base/template_util.h"
 
 namespace base {
@@ -85,50 +87,76 @@ namespace internal {
 // These classes are part of the WeakPtr implementation.
 // DO NOT USE THESE CLASSES DIRECTLY YOURSELF.
 
-class BASE_EXPORT WeakReference {
+// A process-wide table of generation counters, one per live
+// WeakReferenceOwner. A WeakReference records a slot and the generation the
+// slot had when the reference was issued. It is valid while the two match.
+// Invalidating an owner bumps its slot's generation and returns the slot for
+// reuse. No memory is allocated per owner, and references are plain values
+// that can be copied without atomic read-modify-write instructions.
+class BASE_EXPORT WeakSlotTable {
  public:
-  // Although Flag is bound to a specific SequencedTaskRunner, it may be
-  // deleted from another via base::WeakPtr::~WeakPtr().
-  class BASE_EXPORT Flag : public RefCountedThreadSafe<Flag> {
-   public:
-    Flag();
+  // Takes a free slot and returns its index; |*generation| receives the
+  // slot's current generation, which is never 0.
+  static uint32_t Acquire(subtle::Atomic32* generation);
 
-    void Invalidate();
-    bool IsValid() const;
+  // Invalidates every reference to |slot| and makes it free.
+  static void Release(uint32_t slot);
 
-   private:
-    friend class base::RefCountedThreadSafe<Flag>;
-
-    ~Flag();
+  static subtle::Atomic32 Generation(uint32_t slot) {
+    return subtle::Acquire_Load(&chunks_[slot >> kChunkShift]
+                                        [slot & (kChunkSize - 1)]);
+  }
 
-    bool is_valid_;
+ private:
+  enum {
+    kChunkShift = 12,
+    kChunkSize = 1 << kChunkShift,
+    kMaxChunks = 4096,
   };
 
-  WeakReference();
-  explicit WeakReference(const Flag* flag);
-  ~WeakReference();
+  // Chunks are allocated on demand and never freed, so a slot's address is
+  // stable and reading it needs no lock.
+  static volatile subtle::Atomic32* chunks_[kMaxChunks];
+};
 
-  bool is_valid() const;
+class BASE_EXPORT WeakReference {
+ public:
+  WeakReference() : slot_(0), generation_(0) {}
+  WeakReference(uint32_t slot, subtle::Atomic32 generation)
+      : slot_(slot), generation_(generation) {}
+
+  bool is_valid() const {
+    return generation_ && WeakSlotTable::Generation(slot_) == generation_;
+  }
+
+  bool operator==(const WeakReference& other) const {
+    return slot_ == other.slot_ && generation_ == other.generation_;
+  }
 
  private:
-  scoped_refptr<const Flag> flag_;
+  uint32_t slot_;
+  // 0 for a reference that was never valid.
+  subtle::Atomic32 generation_;
 };
 
 class BASE_EXPORT WeakReferenceOwner {
  public:
-  WeakReferenceOwner();
+  WeakReferenceOwner() : slot_(0), generation_(0) {}
   ~WeakReferenceOwner();
 
   WeakReference GetRef() const;
 
-  bool HasRefs() const {
-    return flag_.get() && !flag_->HasOneRef();
-  }
+  // True if references were handed out since the last Invalidate(). Without
+  // per-reference counting the owner cannot tell whether they still exist.
+  bool HasRefs() const { return generation_ != 0; }
 
   void Invalidate();
 
  private:
-  mutable scoped_refptr<WeakReference::Flag> flag_;
+  mutable uint32_t slot_;
+  mutable subtle::Atomic32 generation_;
+
+  DISALLOW_COPY_AND_ASSIGN(WeakReferenceOwner);
 };
 
 // This class simplifies the implementation of WeakPtr's type conversion
@@ -137,11 +165,10 @@ class BASE_EXPORT WeakReferenceOwner {
 // base class gives us a way to access ref_ in a protected fashion.
 class BASE_EXPORT WeakPtrBase {
  public:
-  WeakPtrBase();
-  ~WeakPtrBase();
+  WeakPtrBase() {}
 
  protected:
-  explicit WeakPtrBase(const WeakReference& ref);
+  explicit WeakPtrBase(const WeakReference& ref) : ref_(ref) {}
 
   WeakReference ref_;
 };
@@ -205,6 +232,7 @@ class WeakPtr : public internal::WeakPtrBase {
   WeakPtr(const WeakPtr<U>& other) : WeakPtrBase(other), ptr_(other.ptr_) {
   }
 
+
   T* get() const { return ref_.is_valid() ? ptr_ : NULL; }
 
   T& operator*() const {
@@ -281,7 +309,8 @@ class WeakPtrFactory {
     weak_reference_owner_.Invalidate();
   }
 
-  // Call this method to determine if any weak pointers exist.
+  // Call this method to determine if any weak pointers may exist: true once
+  // GetWeakPtr() was called, until InvalidateWeakPtrs().
   bool HasWeakPtrs() const {
     DCHECK(ptr_);
     return weak_reference_owner_.HasRefs();
@@ -10,7 +10,10 @@
 
 #include "base/logging.h"
 #include "base/lazy_instance.h"
+#include "base/strings/stringprintf.h"
 #include "base/threading/thread_local.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
 
 namespace base {
 
@@ -34,9 +37,15 @@ MessageLoop::MessageLoop()
   message_loop_proxy_.reset(new MessageLoopProxy,
                             &MessageLoopProxyTraits::Destruct);
   message_loop_proxy_->target_message_loop_ = this;
+
+  trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "MessageLoop");
 }
 
 MessageLoop::~MessageLoop() {
+  // 注销返回后不会再有OnMemoryDump调用
+  trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(this);
+
   bool has_work = false;
 
   // 清理未处理的任务可能导致生成新的任务，
@@ -362,6 +371,29 @@ void MessageLoop::PreDestruct() {
                     WillDestroyCurrentMessageLoop());
 }
 
+bool MessageLoop::OnMemoryDump(trace_event::ProcessMemoryDump* pmd) {
+  size_t task_count;
+  {
+    AutoLock lock(incoming_queue_lock_);
+    task_count = incoming_queue_.size();
+  }
+  if (this == current()) {
+    task_count += work_queue_.size() +
+                  deferred_non_nestable_work_queue_.size() +
+                  delayed_work_queue_.size();
+  }
+
+  trace_event::MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(
+      StringPrintf("message_loop/%p", static_cast<void*>(this)));
+  dump->AddScalar(trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  trace_event::MemoryAllocatorDump::kUnitsObjects, task_count);
+  // 只统计PendingTask本身，不含任务绑定的参数
+  dump->AddScalar(trace_event::MemoryAllocatorDump::kNameSize,
+                  trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  task_count * sizeof(PendingTask));
+  return true;
+}
+
 void MessageLoop::PreProcessTask() {
   FOR_EACH_OBSERVER(TaskObserver, task_observers_, PreProcessTask());
 }
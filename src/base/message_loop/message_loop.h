@@ -23,6 +23,7 @@
 #include "base/callback.h"
 #include "base/location.h"
 #include "base/task/pending_task.h"
+#include "base/trace_event/memory_dump_provider.h"
 
 namespace base {
 
@@ -49,7 +50,8 @@ typedef WinMessagePump::Dispatcher Dispatcher;
 #error Not support currently!
 #endif
 
-class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
+class BASE_EXPORT MessageLoop : public MessagePump::Delegate,
+                                public trace_event::MemoryDumpProvider {
  public:
   enum Type {
     kDefaultMessageLoop,
@@ -167,6 +169,10 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
   void set_os_modal_loop(bool os_modal_loop) { os_modal_loop_ = os_modal_loop; }
 #endif  // OS_WIN
 
+  // 报告各任务队列中的任务数及其大致内存占用。输入队列在任何线程上都会报告，
+  // 其余队列只被运行Run的线程访问，因此只在本MessageLoop的线程上报告
+  bool OnMemoryDump(trace_event::ProcessMemoryDump* pmd) override;
+
  protected:
   struct RunState {
     int run_depth;
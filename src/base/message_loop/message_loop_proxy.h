@@ -5,6 +5,8 @@
 #define BASE_MESSAGE_LOOP_PROXY_H_
 #pragma once
 
+#include <memory>
+
 #include "base/base_export.h"
 #include "base/message_loop/message_loop.h"
 #include "base/synchronization/lock.h"
@@ -9,8 +9,8 @@
 
 #include <algorithm>
 #include <limits>
-#include <vector>
 
+#include "base/containers/small_vector.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
@@ -118,7 +118,8 @@ class ObserverListBase
  private:
   friend class ObserverListThreadSafe<ObserverType>;
 
-  typedef std::vector<ObserverType*> ListType;
+  // Most lists hold a handful of observers, which then need no allocation.
+  typedef SmallVector<ObserverType*, 4> ListType;
 
   ListType observers_;
   int notify_depth_;
@@ -10,6 +10,7 @@
 #include <algorithm>  // for max()
 #include <limits>
 
+#include "base/atomicops.h"
 #include "base/bits.h"
 #include "base/macros.h"
 #include "build/build_config.h"
@@ -19,8 +20,22 @@ namespace base {
 // static
 const int Pickle::kPayloadUnit = 64;
 
+// static
+const size_t Pickle::kMaxVarIntLength;
+
 static const size_t kCapacityReadOnly = static_cast<size_t>(-1);
 
+// Live owned Pickles and their buffer bytes, reported by
+// Pickle::GetAllocationStats(). Only read for diagnostics, so no barriers.
+static subtle::AtomicWord g_pickle_count = 0;
+static subtle::AtomicWord g_pickle_bytes = 0;
+
+static void RecordPickleFree(size_t bytes) {
+  subtle::NoBarrier_AtomicIncrement(&g_pickle_count, -1);
+  subtle::NoBarrier_AtomicIncrement(&g_pickle_bytes,
+                                    -static_cast<subtle::AtomicWord>(bytes));
+}
+
 PickleIterator::PickleIterator(const Pickle& pickle)
     : payload_(pickle.payload()),
       read_index_(0),
@@ -32,10 +47,9 @@ inline bool PickleIterator::ReadBuiltinType(Type* result) {
   const char* read_from = GetReadPointerAndAdvance<Type>();
   if (!read_from)
     return false;
-  if (sizeof(Type) > sizeof(uint32_t))
-    memcpy(result, read_from, sizeof(*result));
-  else
-    *result = *reinterpret_cast<const Type*>(read_from);
+  // Compact (unpadded) writes may leave |read_from| unaligned, so always go
+  // through memcpy; compilers lower this to a single load.
+  memcpy(result, read_from, sizeof(*result));
   return true;
 }
 
@@ -81,6 +95,16 @@ inline const char* PickleIterator::GetReadPointerAndAdvance(
   return GetReadPointerAndAdvance(num_bytes32);
 }
 
+const char* PickleIterator::GetReadPointerAndAdvancePacked(size_t num_bytes) {
+  if (end_index_ - read_index_ < num_bytes) {
+    read_index_ = end_index_;
+    return NULL;
+  }
+  const char* current_read_ptr = payload_ + read_index_;
+  read_index_ += num_bytes;
+  return current_read_ptr;
+}
+
 bool PickleIterator::ReadBool(bool* result) {
   return ReadBuiltinType(result);
 }
@@ -209,6 +233,74 @@ bool PickleIterator::ReadBytes(const char** data, int length) {
   return true;
 }
 
+bool PickleIterator::ReadVarUInt64(uint64_t* result) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(payload_ + read_index_);
+  size_t available = end_index_ - read_index_;
+  size_t limit = std::min(available, Pickle::kMaxVarIntLength);
+  uint64_t value = 0;
+  for (size_t i = 0; i < limit; ++i) {
+    uint8_t byte = p[i];
+    value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+    if (!(byte & 0x80)) {
+      // The tenth byte may only carry the top bit of a 64-bit value.
+      if (i == Pickle::kMaxVarIntLength - 1 && byte > 1)
+        break;
+      read_index_ += i + 1;
+      *result = value;
+      return true;
+    }
+  }
+  read_index_ = end_index_;
+  return false;
+}
+
+bool PickleIterator::ReadVarUInt32(uint32_t* result) {
+  uint64_t value;
+  if (!ReadVarUInt64(&value) ||
+      value > std::numeric_limits<uint32_t>::max()) {
+    read_index_ = end_index_;
+    return false;
+  }
+  *result = static_cast<uint32_t>(value);
+  return true;
+}
+
+bool PickleIterator::ReadVarInt32(int32_t* result) {
+  uint32_t value;
+  if (!ReadVarUInt32(&value))
+    return false;
+  *result = static_cast<int32_t>((value >> 1) ^ (0u - (value & 1)));
+  return true;
+}
+
+bool PickleIterator::ReadVarInt64(int64_t* result) {
+  uint64_t value;
+  if (!ReadVarUInt64(&value))
+    return false;
+  *result = static_cast<int64_t>((value >> 1) ^ (0ull - (value & 1)));
+  return true;
+}
+
+bool PickleIterator::ReadVarString(std::string* result) {
+  StringPiece piece;
+  if (!ReadVarStringPiece(&piece))
+    return false;
+  piece.CopyToString(result);
+  return true;
+}
+
+bool PickleIterator::ReadVarStringPiece(StringPiece* result) {
+  uint64_t len;
+  if (!ReadVarUInt64(&len) || len > end_index_ - read_index_) {
+    read_index_ = end_index_;
+    return false;
+  }
+  const char* read_from =
+      GetReadPointerAndAdvancePacked(static_cast<size_t>(len));
+  *result = StringPiece(read_from, static_cast<size_t>(len));
+  return true;
+}
+
 // Payload is uint32_t aligned.
 
 Pickle::Pickle()
@@ -262,8 +354,11 @@ Pickle::Pickle(const Pickle& other)
 }
 
 Pickle::~Pickle() {
-  if (capacity_after_header_ != kCapacityReadOnly)
-    free(header_);
+  if (capacity_after_header_ == kCapacityReadOnly)
+    return;
+  if (header_)
+    RecordPickleFree(GetTotalAllocatedSize());
+  free(header_);
 }
 
 Pickle& Pickle::operator=(const Pickle& other) {
@@ -276,6 +371,8 @@ Pickle& Pickle::operator=(const Pickle& other) {
     capacity_after_header_ = 0;
   }
   if (header_size_ != other.header_size_) {
+    if (header_)
+      RecordPickleFree(GetTotalAllocatedSize());
     free(header_);
     header_ = NULL;
     header_size_ = other.header_size_;
@@ -311,6 +408,30 @@ bool Pickle::WriteBytes(const void* data, int length) {
   return true;
 }
 
+bool Pickle::WriteVarUInt64(uint64_t value) {
+  uint8_t buffer[kMaxVarIntLength];
+  size_t length = 0;
+  while (value >= 0x80) {
+    buffer[length++] = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  buffer[length++] = static_cast<uint8_t>(value);
+  void* write = ClaimUninitializedBytesInternal(length, false);
+  memcpy(write, buffer, length);
+  return true;
+}
+
+bool Pickle::WriteVarString(const StringPiece& value) {
+  if (!WriteVarUInt64(value.size()))
+    return false;
+  if (value.empty())
+    return true;
+  MSAN_CHECK_MEM_IS_INITIALIZED(value.data(), value.size());
+  void* write = ClaimUninitializedBytesInternal(value.size(), false);
+  memcpy(write, value.data(), value.size());
+  return true;
+}
+
 void Pickle::Reserve(size_t length) {
   size_t data_len = bits::Align(length, sizeof(uint32_t));
   DCHECK_GE(data_len, length);
@@ -325,10 +446,18 @@ void Pickle::Reserve(size_t length) {
 
 void Pickle::Resize(size_t new_capacity) {
   CHECK_NE(capacity_after_header_, kCapacityReadOnly);
+  size_t old_size = 0;
+  if (header_)
+    old_size = GetTotalAllocatedSize();
+  else
+    subtle::NoBarrier_AtomicIncrement(&g_pickle_count, 1);
   capacity_after_header_ = bits::Align(new_capacity, kPayloadUnit);
   void* p = realloc(header_, GetTotalAllocatedSize());
   CHECK(p);
   header_ = reinterpret_cast<Header*>(p);
+  subtle::NoBarrier_AtomicIncrement(
+      &g_pickle_bytes,
+      static_cast<subtle::AtomicWord>(GetTotalAllocatedSize() - old_size));
 }
 
 void* Pickle::ClaimBytes(size_t num_bytes) {
@@ -338,6 +467,13 @@ void* Pickle::ClaimBytes(size_t num_bytes) {
   return p;
 }
 
+// static
+void Pickle::GetAllocationStats(size_t* pickle_count, size_t* allocated_bytes) {
+  *pickle_count = static_cast<size_t>(subtle::NoBarrier_Load(&g_pickle_count));
+  *allocated_bytes =
+      static_cast<size_t>(subtle::NoBarrier_Load(&g_pickle_bytes));
+}
+
 size_t Pickle::GetTotalAllocatedSize() const {
   if (capacity_after_header_ == kCapacityReadOnly)
     return 0;
@@ -393,10 +529,11 @@ template void Pickle::WriteBytesStatic<2>(const void* data);
 template void Pickle::WriteBytesStatic<4>(const void* data);
 template void Pickle::WriteBytesStatic<8>(const void* data);
 
-inline void* Pickle::ClaimUninitializedBytesInternal(size_t length) {
+inline void* Pickle::ClaimUninitializedBytesInternal(size_t length,
+                                                     bool padded) {
   DCHECK_NE(kCapacityReadOnly, capacity_after_header_)
       << "oops: pickle is readonly";
-  size_t data_len = bits::Align(length, sizeof(uint32_t));
+  size_t data_len = padded ? bits::Align(length, sizeof(uint32_t)) : length;
   DCHECK_GE(data_len, length);
 #ifdef ARCH_CPU_64_BITS
   DCHECK_LE(data_len, std::numeric_limits<uint32_t>::max());
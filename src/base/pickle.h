@@ -74,6 +74,18 @@ class BASE_EXPORT PickleIterator {
     return !!GetReadPointerAndAdvance(num_bytes);
   }
 
+  // Methods for reading values written by the compact Pickle::WriteVar*()
+  // methods. Integers are LEB128 varints (zigzag-encoded when signed) and are
+  // not padded to a 32-bit boundary. Values that do not fit the requested type
+  // are rejected.
+  bool ReadVarUInt32(uint32_t* result) WARN_UNUSED_RESULT;
+  bool ReadVarUInt64(uint64_t* result) WARN_UNUSED_RESULT;
+  bool ReadVarInt32(int32_t* result) WARN_UNUSED_RESULT;
+  bool ReadVarInt64(int64_t* result) WARN_UNUSED_RESULT;
+  bool ReadVarString(std::string* result) WARN_UNUSED_RESULT;
+  // The StringPiece data will only be valid for the lifetime of the message.
+  bool ReadVarStringPiece(StringPiece* result) WARN_UNUSED_RESULT;
+
  private:
   // Read Type from Pickle.
   template <typename Type>
@@ -96,6 +108,10 @@ class BASE_EXPORT PickleIterator {
   const char* GetReadPointerAndAdvance(int num_elements,
                                        size_t size_element);
 
+  // Get read pointer for |num_bytes| and advance read pointer by exactly
+  // |num_bytes|, without rounding up to the 32-bit alignment.
+  const char* GetReadPointerAndAdvancePacked(size_t num_bytes);
+
   const char* payload_;  // Start of our pickle's payload.
   size_t read_index_;  // Offset of the next readable byte in payload.
   size_t end_index_;  // Payload size.
@@ -159,6 +175,10 @@ class BASE_EXPORT Pickle {
   // purposes.
   size_t GetTotalAllocatedSize() const;
 
+  // Reports how many Pickles currently own a buffer and the sum of their
+  // GetTotalAllocatedSize(). Read-only Pickles are not counted.
+  static void GetAllocationStats(size_t* pickle_count, size_t* allocated_bytes);
+
   // Methods for adding to the payload of the Pickle.  These values are
   // appended to the end of the Pickle's payload.  When reading values from a
   // Pickle, it is important to read them in the order in which they were added
@@ -203,6 +223,27 @@ class BASE_EXPORT Pickle {
   // known size. See also WriteData.
   bool WriteBytes(const void* data, int length);
 
+  // Compact encodings. Integers are written as LEB128 varints, so small values
+  // take a single byte; signed values are zigzag-encoded first so that small
+  // negative values stay small too. Unlike the methods above, the output is
+  // not padded to a 32-bit boundary. Read these back with the matching
+  // PickleIterator::ReadVar*() method. See also base/pickle_traits.h.
+  bool WriteVarUInt32(uint32_t value) { return WriteVarUInt64(value); }
+  bool WriteVarUInt64(uint64_t value);
+  bool WriteVarInt32(int32_t value) {
+    return WriteVarUInt32((static_cast<uint32_t>(value) << 1) ^
+                          static_cast<uint32_t>(value >> 31));
+  }
+  bool WriteVarInt64(int64_t value) {
+    return WriteVarUInt64((static_cast<uint64_t>(value) << 1) ^
+                          static_cast<uint64_t>(value >> 63));
+  }
+  // Writes a varint length followed by the unpadded string bytes.
+  bool WriteVarString(const StringPiece& value);
+
+  // The maximum number of bytes a 64-bit varint occupies.
+  static const size_t kMaxVarIntLength = 10;
+
   // Reserves space for upcoming writes when multiple writes will be made and
   // their sizes are computed in advance. It can be significantly faster to call
   // Reserve() before calling WriteFoo() multiple times.
@@ -243,6 +284,26 @@ class BASE_EXPORT Pickle {
     return header_ ? payload() + payload_size() : NULL;
   }
 
+  // Find the end of the pickled data that starts at range_start.  Returns NULL
+  // if the entire Pickle is not found in the given data range. Together with
+  // the Pickle(const char*, int) constructor, this reads a Pickle in place
+  // from a larger buffer such as a SharedMemory mapping, without copying it.
+  static const char* FindNext(size_t header_size,
+                              const char* range_start,
+                              const char* range_end);
+
+  // Parse pickle header and return total size of the pickle. Data range
+  // doesn't need to contain entire pickle.
+  // Returns true if pickle header was found and parsed. Callers must check
+  // returned |pickle_size| for sanity (against maximum message size, etc).
+  // NOTE: when function successfully parses a header, but encounters an
+  // overflow during pickle size calculation, it sets |pickle_size| to the
+  // maximum size_t value and returns true.
+  static bool PeekNext(size_t header_size,
+                       const char* range_start,
+                       const char* range_end,
+                       size_t* pickle_size);
+
  protected:
   char* mutable_payload() {
     return reinterpret_cast<char*>(header_) + header_size_;
@@ -263,24 +324,6 @@ class BASE_EXPORT Pickle {
   // Returns the address of the first byte claimed.
   void* ClaimBytes(size_t num_bytes);
 
-  // Find the end of the pickled data that starts at range_start.  Returns NULL
-  // if the entire Pickle is not found in the given data range.
-  static const char* FindNext(size_t header_size,
-                              const char* range_start,
-                              const char* range_end);
-
-  // Parse pickle header and return total size of the pickle. Data range
-  // doesn't need to contain entire pickle.
-  // Returns true if pickle header was found and parsed. Callers must check
-  // returned |pickle_size| for sanity (against maximum message size, etc).
-  // NOTE: when function successfully parses a header, but encounters an
-  // overflow during pickle size calculation, it sets |pickle_size| to the
-  // maximum size_t value and returns true.
-  static bool PeekNext(size_t header_size,
-                       const char* range_start,
-                       const char* range_end,
-                       size_t* pickle_size);
-
   // The allocation granularity of the payload.
   static const int kPayloadUnit;
 
@@ -305,7 +348,10 @@ class BASE_EXPORT Pickle {
     return true;
   }
 
-  inline void* ClaimUninitializedBytesInternal(size_t num_bytes);
+  // Claims |num_bytes| bytes, followed by enough zeroed padding to keep the
+  // write offset 32-bit aligned when |padded| is true.
+  inline void* ClaimUninitializedBytesInternal(size_t num_bytes,
+                                               bool padded = true);
   inline void WriteBytesCommon(const void* data, size_t length);
 };
 
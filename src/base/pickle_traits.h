@@ -0,0 +1,248 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// PickleTraits<T> describes how a value of type T is written to and read back
+// from a Pickle using the compact (varint, unpadded) encoding.
+//
+// Integral, enum, floating point, string and vector types are supported out of
+// the box. A struct declares its fields once by specializing PickleTraits with
+// a Fields() template; the Write/Read code is generated from it:
+//
+//   struct Point {
+//     int32_t x;
+//     int32_t y;
+//     std::string label;
+//   };
+//
+//   namespace base {
+//   template <>
+//   struct PickleTraits<Point> {
+//     template <typename S, typename Visitor>
+//     static bool Fields(S& p, Visitor& v) {
+//       return v(p.x) && v(p.y) && v(p.label);
+//     }
+//   };
+//   }  // namespace base
+//
+//   Pickle pickle;
+//   base::PickleWrite(&pickle, point);
+//   PickleIterator iter(pickle);
+//   if (!base::PickleRead(&iter, &point)) ...
+//
+// Specializations may instead provide static Write(Pickle*, const T&) and
+// Read(PickleIterator*, T*) functions when a type needs custom encoding.
+
+#ifndef BASE_PICKLE_TRAITS_H_
+#define BASE_PICKLE_TRAITS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/pickle.h"
+
+namespace base {
+
+template <typename T, typename Enable = void>
+struct PickleTraits;
+
+template <typename T>
+void PickleWrite(Pickle* pickle, const T& value);
+
+template <typename T>
+bool PickleRead(PickleIterator* iter, T* value) WARN_UNUSED_RESULT;
+
+template <>
+struct PickleTraits<bool> {
+  static void Write(Pickle* pickle, bool value) {
+    pickle->WriteVarUInt32(value ? 1 : 0);
+  }
+  static bool Read(PickleIterator* iter, bool* value) {
+    uint32_t v;
+    if (!iter->ReadVarUInt32(&v) || v > 1)
+      return false;
+    *value = v != 0;
+    return true;
+  }
+};
+
+// Unsigned integers are written as plain varints.
+template <typename T>
+struct PickleTraits<T,
+                    typename std::enable_if<std::is_integral<T>::value &&
+                                            std::is_unsigned<T>::value>::type> {
+  static void Write(Pickle* pickle, T value) { pickle->WriteVarUInt64(value); }
+  static bool Read(PickleIterator* iter, T* value) {
+    uint64_t v;
+    if (!iter->ReadVarUInt64(&v) || v != static_cast<T>(v))
+      return false;
+    *value = static_cast<T>(v);
+    return true;
+  }
+};
+
+// Signed integers are zigzag-encoded so that small negative values stay short.
+template <typename T>
+struct PickleTraits<T,
+                    typename std::enable_if<std::is_integral<T>::value &&
+                                            std::is_signed<T>::value>::type> {
+  static void Write(Pickle* pickle, T value) { pickle->WriteVarInt64(value); }
+  static bool Read(PickleIterator* iter, T* value) {
+    int64_t v;
+    if (!iter->ReadVarInt64(&v) || v != static_cast<T>(v))
+      return false;
+    *value = static_cast<T>(v);
+    return true;
+  }
+};
+
+template <typename T>
+struct PickleTraits<T, typename std::enable_if<std::is_enum<T>::value>::type> {
+  using Underlying = typename std::underlying_type<T>::type;
+
+  static void Write(Pickle* pickle, T value) {
+    PickleTraits<Underlying>::Write(pickle, static_cast<Underlying>(value));
+  }
+  static bool Read(PickleIterator* iter, T* value) {
+    Underlying v;
+    if (!PickleTraits<Underlying>::Read(iter, &v))
+      return false;
+    *value = static_cast<T>(v);
+    return true;
+  }
+};
+
+// Floating point values are written as their raw, unpadded bytes.
+template <>
+struct PickleTraits<float> {
+  static void Write(Pickle* pickle, float value) { pickle->WriteFloat(value); }
+  static bool Read(PickleIterator* iter, float* value) {
+    return iter->ReadFloat(value);
+  }
+};
+
+template <>
+struct PickleTraits<double> {
+  static void Write(Pickle* pickle, double value) {
+    pickle->WriteDouble(value);
+  }
+  static bool Read(PickleIterator* iter, double* value) {
+    return iter->ReadDouble(value);
+  }
+};
+
+template <>
+struct PickleTraits<std::string> {
+  static void Write(Pickle* pickle, const std::string& value) {
+    pickle->WriteVarString(value);
+  }
+  static bool Read(PickleIterator* iter, std::string* value) {
+    return iter->ReadVarString(value);
+  }
+};
+
+template <typename T>
+struct PickleTraits<std::vector<T>> {
+  static void Write(Pickle* pickle, const std::vector<T>& value) {
+    pickle->WriteVarUInt64(value.size());
+    for (const auto& element : value)
+      PickleWrite(pickle, element);
+  }
+  static bool Read(PickleIterator* iter, std::vector<T>* value) {
+    uint64_t size;
+    if (!iter->ReadVarUInt64(&size))
+      return false;
+    value->clear();
+    // Cap the up-front reservation so that a corrupt size cannot trigger a
+    // huge allocation before the element reads fail.
+    value->reserve(static_cast<size_t>(std::min<uint64_t>(size, 4096)));
+    for (uint64_t i = 0; i < size; ++i) {
+      T element;
+      if (!PickleRead(iter, &element))
+        return false;
+      value->push_back(std::move(element));
+    }
+    return true;
+  }
+};
+
+namespace internal {
+
+class PickleFieldWriter {
+ public:
+  explicit PickleFieldWriter(Pickle* pickle) : pickle_(pickle) {}
+
+  template <typename F>
+  bool operator()(const F& field) {
+    PickleWrite(pickle_, field);
+    return true;
+  }
+
+ private:
+  Pickle* pickle_;
+};
+
+class PickleFieldReader {
+ public:
+  explicit PickleFieldReader(PickleIterator* iter) : iter_(iter) {}
+
+  template <typename F>
+  bool operator()(F& field) {
+    return PickleRead(iter_, &field);
+  }
+
+ private:
+  PickleIterator* iter_;
+};
+
+// Prefer an explicit Write()/Read() in the traits; otherwise generate them
+// from Fields().
+template <typename Traits, typename T>
+auto PickleWriteImpl(Pickle* pickle, const T& value, int)
+    -> decltype(Traits::Write(pickle, value), void()) {
+  Traits::Write(pickle, value);
+}
+
+template <typename Traits, typename T>
+void PickleWriteImpl(Pickle* pickle, const T& value, long) {
+  PickleFieldWriter writer(pickle);
+  Traits::Fields(value, writer);
+}
+
+template <typename Traits, typename T>
+auto PickleReadImpl(PickleIterator* iter, T* value, int)
+    -> decltype(Traits::Read(iter, value)) {
+  return Traits::Read(iter, value);
+}
+
+template <typename Traits, typename T>
+bool PickleReadImpl(PickleIterator* iter, T* value, long) {
+  PickleFieldReader reader(iter);
+  return Traits::Fields(*value, reader);
+}
+
+}  // namespace internal
+
+// Appends |value| to |pickle| using PickleTraits<T>.
+template <typename T>
+void PickleWrite(Pickle* pickle, const T& value) {
+  internal::PickleWriteImpl<PickleTraits<T>>(pickle, value, 0);
+}
+
+// Reads a value written by PickleWrite(). Returns false if the data is
+// truncated or malformed; |value| may be partially written in that case.
+template <typename T>
+bool PickleRead(PickleIterator* iter, T* value) {
+  return internal::PickleReadImpl<PickleTraits<T>>(iter, value, 0);
+}
+
+}  // namespace base
+
+#endif  // BASE_PICKLE_TRAITS_H_
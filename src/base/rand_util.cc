@@ -11,24 +11,91 @@
 #include <algorithm>
 #include <limits>
 
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread_local_storage.h"
+#include "build/build_config.h"
+
+#if defined(COMPILER_MSVC) && defined(ARCH_CPU_X86_64)
+#include <intrin.h>
+#endif
 
 namespace base {
 
-int RandInt(int min, int max) {
-  DCHECK_LE(min, max);
+namespace {
+
+// Returns the high 64 bits of |a| * |b| and stores the low 64 bits in |low|.
+inline uint64_t MultiplyHigh(uint64_t a, uint64_t b, uint64_t* low) {
+#if defined(COMPILER_GCC) && defined(ARCH_CPU_64_BITS)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  *low = static_cast<uint64_t>(product);
+  return static_cast<uint64_t>(product >> 64);
+#elif defined(COMPILER_MSVC) && defined(ARCH_CPU_X86_64)
+  uint64_t high;
+  *low = _umul128(a, b, &high);
+  return high;
+#else
+  const uint64_t a_lo = a & 0xffffffff, a_hi = a >> 32;
+  const uint64_t b_lo = b & 0xffffffff, b_hi = b >> 32;
+  const uint64_t lo_lo = a_lo * b_lo;
+  const uint64_t hi_lo = a_hi * b_lo;
+  const uint64_t lo_hi = a_lo * b_hi;
+  const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+  *low = (cross << 32) | (lo_lo & 0xffffffff);
+  return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+// Maps the output of |next| onto [0, range) without bias, using Lemire's
+// multiply-and-shift reduction. Only a small fraction of calls needs a
+// division, and a retry is needed with probability below range / 2^64.
+template <typename NextFunction>
+uint64_t ReduceToRange(uint64_t range, NextFunction next) {
+  DCHECK_GT(range, 0u);
+  uint64_t low;
+  uint64_t result = MultiplyHigh(next(), range, &low);
+  if (low < range) {
+    const uint64_t threshold = (0 - range) % range;
+    while (low < threshold)
+      result = MultiplyHigh(next(), range, &low);
+  }
+  return result;
+}
 
+// Returns a random number between min and max (inclusive) given a function
+// that implements RandGenerator().
+template <typename GeneratorFunction>
+int RandIntImpl(int min, int max, GeneratorFunction generator) {
+  DCHECK_LE(min, max);
   uint64_t range = static_cast<uint64_t>(max) - min + 1;
-  // |range| is at most UINT_MAX + 1, so the result of RandGenerator(range)
+  // |range| is at most UINT_MAX + 1, so the result of generator(range)
   // is at most UINT_MAX.  Hence it's safe to cast it from uint64_t to int64_t.
-  int result =
-      static_cast<int>(min + static_cast<int64_t>(base::RandGenerator(range)));
+  int result = static_cast<int>(min + static_cast<int64_t>(generator(range)));
   DCHECK_GE(result, min);
   DCHECK_LE(result, max);
   return result;
 }
 
+void DeleteInsecureRandomGenerator(void* generator) {
+  delete static_cast<InsecureRandomGenerator*>(generator);
+}
+
+// TLS slot that owns each thread's InsecureRandomGenerator.
+class InsecureRandomGeneratorSlot : public ThreadLocalStorage::Slot {
+ public:
+  InsecureRandomGeneratorSlot() : Slot(&DeleteInsecureRandomGenerator) {}
+};
+
+LazyInstance<InsecureRandomGeneratorSlot>::Leaky g_insecure_generator_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+int RandInt(int min, int max) {
+  return RandIntImpl(min, max, &base::RandGenerator);
+}
+
 double RandDouble() {
   return BitsToOpenEndedUnitInterval(base::RandUint64());
 }
@@ -50,20 +117,7 @@ double BitsToOpenEndedUnitInterval(uint64_t bits) {
 }
 
 uint64_t RandGenerator(uint64_t range) {
-  DCHECK_GT(range, 0u);
-  // We must discard random results above this number, as they would
-  // make the random generator non-uniform (consider e.g. if
-  // MAX_UINT64 was 7 and |range| was 5, then a result of 1 would be twice
-  // as likely as a result of 3 or 4).
-  uint64_t max_acceptable_value =
-      (std::numeric_limits<uint64_t>::max() / range) * range - 1;
-
-  uint64_t value;
-  do {
-    value = base::RandUint64();
-  } while (value > max_acceptable_value);
-
-  return value % range;
+  return ReduceToRange(range, &base::RandUint64);
 }
 
 std::string RandBytesAsString(size_t length) {
@@ -73,4 +127,53 @@ std::string RandBytesAsString(size_t length) {
   return result;
 }
 
+InsecureRandomGenerator::InsecureRandomGenerator() {
+  RandBytes(state_, sizeof(state_));
+  // The all-zero state is a fixed point of xoshiro.
+  if (!(state_[0] | state_[1] | state_[2] | state_[3]))
+    Seed(0);
+}
+
+InsecureRandomGenerator::InsecureRandomGenerator(uint64_t seed) {
+  Seed(seed);
+}
+
+// static
+InsecureRandomGenerator* InsecureRandomGenerator::ForCurrentThread() {
+  InsecureRandomGeneratorSlot& slot = g_insecure_generator_slot.Get();
+  InsecureRandomGenerator* generator =
+      static_cast<InsecureRandomGenerator*>(slot.Get());
+  if (!generator) {
+    generator = new InsecureRandomGenerator;
+    slot.Set(generator);
+  }
+  return generator;
+}
+
+int InsecureRandomGenerator::RandInt(int min, int max) {
+  return RandIntImpl(min, max, [this](uint64_t range) {
+    return RandGenerator(range);
+  });
+}
+
+uint64_t InsecureRandomGenerator::RandGenerator(uint64_t range) {
+  return ReduceToRange(range, [this] { return RandUint64(); });
+}
+
+double InsecureRandomGenerator::RandDouble() {
+  // Use the high bits, which are the best distributed ones.
+  return BitsToOpenEndedUnitInterval(RandUint64() >> 11);
+}
+
+void InsecureRandomGenerator::Seed(uint64_t seed) {
+  // Expand the seed with splitmix64, as recommended by the xoshiro authors.
+  for (uint64_t& word : state_) {
+    seed += 0x9e3779b97f4a7c15ull;
+    uint64_t z = seed;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    word = z ^ (z >> 31);
+  }
+}
+
 }  // namespace base
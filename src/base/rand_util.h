@@ -57,6 +57,64 @@ BASE_EXPORT std::string RandBytesAsString(size_t length);
 BASE_EXPORT int GetUrandomFD();
 #endif
 
+// A fast, seedable pseudo-random number generator (xoshiro256**) for sampling,
+// jitter and similar uses where millions of numbers are needed and a syscall
+// per number is too expensive.
+//
+// WARNING:
+// The output is predictable once a few values have been observed. Never use
+// this for anything security-sensitive; use RandBytes() and friends instead.
+//
+// Not thread-safe; use ForCurrentThread() to get an instance that is private
+// to the calling thread.
+class BASE_EXPORT InsecureRandomGenerator {
+ public:
+  // Seeds the generator from RandBytes().
+  InsecureRandomGenerator();
+
+  // Seeds the generator deterministically from |seed|, e.g. for tests or for
+  // reproducible simulations.
+  explicit InsecureRandomGenerator(uint64_t seed);
+
+  // Returns the generator owned by the calling thread, creating and seeding it
+  // on first use. It is destroyed when the thread exits.
+  static InsecureRandomGenerator* ForCurrentThread();
+
+  // Returns a random number in range [0, UINT64_MAX].
+  uint64_t RandUint64() {
+    const uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+    return result;
+  }
+
+  // Returns a random number in range [0, UINT32_MAX].
+  uint32_t RandUint32() { return static_cast<uint32_t>(RandUint64() >> 32); }
+
+  // Returns a random number between min and max (inclusive).
+  int RandInt(int min, int max);
+
+  // Returns a random number in range [0, range), without modulo bias.
+  uint64_t RandGenerator(uint64_t range);
+
+  // Returns a random double in range [0, 1).
+  double RandDouble();
+
+ private:
+  static uint64_t RotateLeft(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  void Seed(uint64_t seed);
+
+  uint64_t state_[4];
+};
+
 }  // namespace base
 
 #endif  // BASE_RAND_UTIL_H_
@@ -6,13 +6,22 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "base/files/file_util.h"
 #include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/thread_local_storage.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include <sys/syscall.h>
+#endif
 
 namespace {
 
@@ -36,6 +45,84 @@ class URandomFd {
 
 base::LazyInstance<URandomFd>::Leaky g_urandom_fd = LAZY_INSTANCE_INITIALIZER;
 
+// Fills |output| straight from the kernel. Uses getrandom() where available,
+// which needs no file descriptor, and /dev/urandom otherwise.
+void RandBytesFromKernel(char* output, size_t output_length) {
+#if defined(OS_LINUX) && defined(__NR_getrandom)
+  while (output_length > 0) {
+    const long bytes =
+        HANDLE_EINTR(syscall(__NR_getrandom, output, output_length, 0));
+    // Pre-3.17 kernels do not have the syscall, and seccomp filters may
+    // reject it; /dev/urandom serves either way.
+    if (bytes < 0)
+      break;
+    output += bytes;
+    output_length -= bytes;
+  }
+  if (!output_length)
+    return;
+#endif
+  const bool success =
+      base::ReadFromFD(g_urandom_fd.Pointer()->fd(), output, output_length);
+  CHECK(success);
+}
+
+// Small requests are served from a per-thread buffer that is refilled with a
+// single kernel call, so that e.g. RandUint64() usually makes no syscall.
+// Bytes are wiped as soon as they are handed out.
+const size_t kRandBufferSize = 512;
+const size_t kMaxBufferedRequest = 64;
+
+struct RandBuffer {
+  size_t available;  // Unused bytes at the end of |bytes|.
+  char bytes[kRandBufferSize];
+};
+
+void DeleteRandBuffer(void* buffer) {
+  RandBuffer* rand_buffer = static_cast<RandBuffer*>(buffer);
+  memset(rand_buffer, 0, sizeof(*rand_buffer));
+  delete rand_buffer;
+}
+
+// A forked child must not replay the parent's buffered bytes. Only the forking
+// thread survives in the child, so discarding its buffer is enough.
+void DiscardRandBufferInChild();
+
+class RandBufferSlot : public base::ThreadLocalStorage::Slot {
+ public:
+  RandBufferSlot() : Slot(&DeleteRandBuffer) {
+    pthread_atfork(NULL, NULL, &DiscardRandBufferInChild);
+  }
+};
+
+base::LazyInstance<RandBufferSlot>::Leaky g_rand_buffer_slot =
+    LAZY_INSTANCE_INITIALIZER;
+
+void DiscardRandBufferInChild() {
+  RandBuffer* buffer =
+      static_cast<RandBuffer*>(g_rand_buffer_slot.Get().Get());
+  if (buffer)
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+void RandBytesFromBuffer(char* output, size_t output_length) {
+  RandBufferSlot& slot = g_rand_buffer_slot.Get();
+  RandBuffer* buffer = static_cast<RandBuffer*>(slot.Get());
+  if (!buffer) {
+    buffer = new RandBuffer;
+    buffer->available = 0;
+    slot.Set(buffer);
+  }
+  if (buffer->available < output_length) {
+    RandBytesFromKernel(buffer->bytes, kRandBufferSize);
+    buffer->available = kRandBufferSize;
+  }
+  char* start = buffer->bytes + buffer->available - output_length;
+  memcpy(output, start, output_length);
+  memset(start, 0, output_length);
+  buffer->available -= output_length;
+}
+
 }  // namespace
 
 namespace base {
@@ -48,10 +135,10 @@ uint64_t RandUint64() {
 }
 
 void RandBytes(void* output, size_t output_length) {
-  const int urandom_fd = g_urandom_fd.Pointer()->fd();
-  const bool success =
-      ReadFromFD(urandom_fd, static_cast<char*>(output), output_length);
-  CHECK(success);
+  if (output_length <= kMaxBufferedRequest)
+    RandBytesFromBuffer(static_cast<char*>(output), output_length);
+  else
+    RandBytesFromKernel(static_cast<char*>(output), output_length);
 }
 
 int GetUrandomFD(void) {
@@ -0,0 +1,62 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_SAMPLING_HEAP_PROFILER_OPERATOR_NEW_HOOKS_H_
+#define BASE_SAMPLING_HEAP_PROFILER_OPERATOR_NEW_HOOKS_H_
+
+#include <stdlib.h>
+
+#include <new>
+
+#include "base/sampling_heap_profiler/sampling_heap_profiler.h"
+
+// Replaces the global operator new and delete with versions that report to
+// SamplingHeapProfiler. Replacement operators must be defined exactly once
+// per program, so base does not define them itself: the executable expands
+// this macro at namespace scope in one of its own source files.
+//
+//   // main.cc
+//   #include "base/sampling_heap_profiler/operator_new_hooks.h"
+//   SAMPLING_HEAP_PROFILER_DEFINE_OPERATOR_NEW_HOOKS()
+//
+// Every replaceable form is defined, sized deletes included, so that nothing
+// allocated here is freed by the C++ library's own operators. Since the
+// hooks apply to the whole program, tests of them belong in an executable of
+// their own.
+//
+// Allocations made directly with malloc() are not seen. Only operator new
+// can be replaced portably; the C library's malloc hooks are gone.
+#define SAMPLING_HEAP_PROFILER_DEFINE_OPERATOR_NEW_HOOKS()                    \
+  void* operator new(size_t size) {                                           \
+    void* p = malloc(size ? size : 1);                                        \
+    if (!p)                                                                   \
+      throw std::bad_alloc();                                                 \
+    base::SamplingHeapProfiler::RecordAlloc(p, size);                         \
+    return p;                                                                 \
+  }                                                                           \
+  void* operator new[](size_t size) { return operator new(size); }            \
+  void* operator new(size_t size, const std::nothrow_t&) noexcept {           \
+    void* p = malloc(size ? size : 1);                                        \
+    base::SamplingHeapProfiler::RecordAlloc(p, size);                         \
+    return p;                                                                 \
+  }                                                                           \
+  void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {     \
+    return operator new(size, tag);                                           \
+  }                                                                           \
+  void operator delete(void* p) noexcept {                                    \
+    if (p)                                                                    \
+      base::SamplingHeapProfiler::RecordFree(p);                              \
+    free(p);                                                                  \
+  }                                                                           \
+  void operator delete[](void* p) noexcept { operator delete(p); }            \
+  void operator delete(void* p, const std::nothrow_t&) noexcept {             \
+    operator delete(p);                                                       \
+  }                                                                           \
+  void operator delete[](void* p, const std::nothrow_t&) noexcept {           \
+    operator delete(p);                                                       \
+  }                                                                           \
+  void operator delete(void* p, size_t) noexcept { operator delete(p); }      \
+  void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+#endif  // BASE_SAMPLING_HEAP_PROFILER_OPERATOR_NEW_HOOKS_H_
@@ -0,0 +1,315 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/sampling_heap_profiler/sampling_heap_profiler.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/format_macros.h"
+#include "base/memory/singleton.h"
+#include "base/rand_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/thread_local_storage.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "build/build_config.h"
+
+#if defined(OS_LINUX)
+#include "base/debug/proc_maps_linux.h"
+#endif
+
+namespace base {
+
+namespace {
+
+// Per-thread sampling state. It lives in malloc()ed memory rather than
+// operator new, which may be what is being profiled.
+struct ThreadState {
+  explicit ThreadState(uint64_t seed)
+      : bytes_until_sample(0), sampling_interval(0), entered(false),
+        random(seed) {}
+
+  // Allocated bytes left before the next sample.
+  intptr_t bytes_until_sample;
+  // The interval |bytes_until_sample| was drawn for.
+  size_t sampling_interval;
+  // Set while the thread runs profiler code, whose own allocations and frees
+  // must not be sampled: they would deadlock on the profiler's lock.
+  bool entered;
+  InsecureRandomGenerator random;
+};
+
+// Initialized by the first Start(), before any thread can sample.
+ThreadLocalStorage::StaticSlot g_thread_state_slot = TLS_INITIALIZER;
+
+void OnThreadExit(void* value) {
+  ThreadState* state = static_cast<ThreadState*>(value);
+  state->~ThreadState();
+  free(state);
+}
+
+ThreadState* GetThreadState() {
+  ThreadState* state = static_cast<ThreadState*>(g_thread_state_slot.Get());
+  if (UNLIKELY(!state)) {
+    void* memory = malloc(sizeof(ThreadState));
+    if (!memory)
+      return NULL;
+    // Seeding from RandBytes() would read a file from inside the allocator.
+    uint64_t seed = reinterpret_cast<uintptr_t>(memory) ^
+                    static_cast<uint64_t>(TimeTicks::Now().ToInternalValue());
+    state = new (memory) ThreadState(seed);
+    g_thread_state_slot.Set(state);
+  }
+  return state;
+}
+
+class ScopedEnterProfiler {
+ public:
+  explicit ScopedEnterProfiler(ThreadState* state)
+      : state_(state), was_entered_(state && state->entered) {
+    if (state_)
+      state_->entered = true;
+  }
+
+  ~ScopedEnterProfiler() {
+    if (state_)
+      state_->entered = was_entered_;
+  }
+
+ private:
+  ThreadState* state_;
+  bool was_entered_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedEnterProfiler);
+};
+
+// Draws the number of bytes up to the next sample. The gaps of a Poisson
+// process with rate 1 / |sampling_interval| are exponentially distributed.
+intptr_t NextSampleGap(ThreadState* state, size_t sampling_interval) {
+  if (sampling_interval <= 1)
+    return 0;
+  // 1 - RandDouble() is in (0, 1], so the log is finite.
+  double gap = -log(1.0 - state->random.RandDouble()) * sampling_interval;
+  return static_cast<intptr_t>(
+      std::min(gap, static_cast<double>(std::numeric_limits<intptr_t>::max() /
+                                        2)));
+}
+
+// A sampled allocation of |size| bytes stands for 1 / P(sampled) allocations
+// like it, where P(sampled) = 1 - exp(-size / sampling_interval).
+double SampleWeight(size_t size, size_t sampling_interval) {
+  if (sampling_interval <= 1)
+    return 1.0;
+  return 1.0 / -expm1(-static_cast<double>(size) / sampling_interval);
+}
+
+}  // namespace
+
+// static
+const size_t SamplingHeapProfiler::kDefaultSamplingInterval;
+
+// static
+subtle::Atomic32 SamplingHeapProfiler::running_ = 0;
+
+// static
+subtle::Atomic32 SamplingHeapProfiler::sampled_filter_[1 << kFilterBits];
+
+// static
+SamplingHeapProfiler* SamplingHeapProfiler::GetInstance() {
+  return Singleton<SamplingHeapProfiler,
+                   LeakySingletonTraits<SamplingHeapProfiler>>::get();
+}
+
+SamplingHeapProfiler::SamplingHeapProfiler()
+    : sampling_interval_(kDefaultSamplingInterval), registered_(false) {}
+
+SamplingHeapProfiler::~SamplingHeapProfiler() {}
+
+void SamplingHeapProfiler::Start() {
+  bool register_provider;
+  {
+    AutoLock lock(lock_);
+    if (!g_thread_state_slot.initialized())
+      g_thread_state_slot.Initialize(&OnThreadExit);
+    register_provider = !registered_;
+    registered_ = true;
+  }
+  if (register_provider) {
+    trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        this, "sampling_heap_profiler");
+  }
+  subtle::Release_Store(&running_, 1);
+}
+
+void SamplingHeapProfiler::Stop() {
+  subtle::Release_Store(&running_, 0);
+}
+
+void SamplingHeapProfiler::SetSamplingInterval(size_t sampling_interval) {
+  DCHECK_GT(sampling_interval, 0u);
+  subtle::NoBarrier_Store(&sampling_interval_,
+                          static_cast<subtle::AtomicWord>(sampling_interval));
+}
+
+void SamplingHeapProfiler::SampleAlloc(void* address, size_t size) {
+  if (!address)
+    return;
+  ThreadState* state = GetThreadState();
+  if (!state || state->entered)
+    return;
+
+  size_t interval = sampling_interval();
+  if (UNLIKELY(state->sampling_interval != interval)) {
+    state->sampling_interval = interval;
+    state->bytes_until_sample = NextSampleGap(state, interval);
+  }
+  state->bytes_until_sample -= static_cast<intptr_t>(size);
+  if (state->bytes_until_sample > 0)
+    return;
+  // The process is memoryless, so an allocation that spans several gaps is
+  // still one sample and the next gap starts afresh.
+  state->bytes_until_sample = NextSampleGap(state, interval);
+
+  ScopedEnterProfiler enter(state);
+  Sample sample = {size, interval, debug::StackTrace()};
+  AutoLock lock(lock_);
+  std::pair<FlatHashMap<const void*, Sample>::iterator, bool> result =
+      samples_.insert(std::make_pair(address, sample));
+  if (!result.second) {
+    // The block at |address| was freed while its thread was inside the
+    // profiler, so the free was not seen.
+    result.first->second = sample;
+    return;
+  }
+  subtle::NoBarrier_AtomicIncrement(&sampled_filter_[FilterIndex(address)], 1);
+}
+
+void SamplingHeapProfiler::SampleFree(void* address) {
+  ThreadState* state = GetThreadState();
+  if (!state || state->entered)
+    return;
+  ScopedEnterProfiler enter(state);
+  AutoLock lock(lock_);
+  if (samples_.erase(address))
+    subtle::NoBarrier_AtomicIncrement(&sampled_filter_[FilterIndex(address)],
+                                      -1);
+}
+
+std::vector<SamplingHeapProfiler::CallSite> SamplingHeapProfiler::GetProfile() {
+  ScopedEnterProfiler enter(
+      g_thread_state_slot.initialized() ? GetThreadState() : NULL);
+
+  std::vector<CallSite> profile;
+  std::vector<std::pair<double, double>> estimates;
+  std::map<std::vector<const void*>, size_t> site_index;
+  {
+    AutoLock lock(lock_);
+    for (const auto& it : samples_) {
+      const Sample& sample = it.second;
+      size_t frame_count;
+      const void* const* frames = sample.stack.Addresses(&frame_count);
+      std::vector<const void*> stack(frames, frames + frame_count);
+      std::pair<std::map<std::vector<const void*>, size_t>::iterator, bool>
+          inserted = site_index.insert(std::make_pair(stack, profile.size()));
+      if (inserted.second) {
+        CallSite site;
+        site.frames.swap(stack);
+        site.sampled_count = 0;
+        site.sampled_bytes = 0;
+        site.estimated_count = 0;
+        site.estimated_bytes = 0;
+        profile.push_back(site);
+        estimates.push_back(std::make_pair(0.0, 0.0));
+      }
+      size_t index = inserted.first->second;
+      double weight = SampleWeight(sample.size, sample.sampling_interval);
+      profile[index].sampled_count++;
+      profile[index].sampled_bytes += sample.size;
+      estimates[index].first += weight;
+      estimates[index].second += weight * sample.size;
+    }
+  }
+
+  for (size_t i = 0; i < profile.size(); ++i) {
+    profile[i].estimated_count = static_cast<size_t>(estimates[i].first + 0.5);
+    profile[i].estimated_bytes = static_cast<size_t>(estimates[i].second + 0.5);
+  }
+  std::sort(profile.begin(), profile.end(),
+            [](const CallSite& a, const CallSite& b) {
+              return a.estimated_bytes > b.estimated_bytes;
+            });
+  return profile;
+}
+
+bool SamplingHeapProfiler::DumpProfile(const FilePath& path) {
+  ScopedEnterProfiler enter(
+      g_thread_state_slot.initialized() ? GetThreadState() : NULL);
+  std::vector<CallSite> profile = GetProfile();
+
+  // "heap_v2" profiles hold the raw samples; pprof does the scaling itself
+  // from the interval in the header.
+  size_t total_count = 0;
+  size_t total_bytes = 0;
+  std::string sites;
+  for (const CallSite& site : profile) {
+    total_count += site.sampled_count;
+    total_bytes += site.sampled_bytes;
+    StringAppendF(&sites, "%6" PRIuS ": %8" PRIuS " [%6" PRIuS ": %8" PRIuS
+                  "] @", site.sampled_count, site.sampled_bytes,
+                  site.sampled_count, site.sampled_bytes);
+    for (const void* frame : site.frames)
+      StringAppendF(&sites, " 0x%" PRIxPTR, reinterpret_cast<uintptr_t>(frame));
+    sites += '\n';
+  }
+
+  std::string text = StringPrintf(
+      "heap profile: %6" PRIuS ": %8" PRIuS " [%6" PRIuS ": %8" PRIuS
+      "] @ heap_v2/%" PRIuS "\n",
+      total_count, total_bytes, total_count, total_bytes, sampling_interval());
+  text += sites;
+#if defined(OS_LINUX)
+  // Lets pprof symbolize the addresses.
+  std::string proc_maps;
+  if (debug::ReadProcMaps(&proc_maps)) {
+    text += "\nMAPPED_LIBRARIES:\n";
+    text += proc_maps;
+  }
+#endif
+
+  return WriteFile(path, text.data(), static_cast<int>(text.size())) ==
+         static_cast<int>(text.size());
+}
+
+bool SamplingHeapProfiler::OnMemoryDump(trace_event::ProcessMemoryDump* pmd) {
+  ScopedEnterProfiler enter(
+      g_thread_state_slot.initialized() ? GetThreadState() : NULL);
+  std::vector<CallSite> profile = GetProfile();
+  size_t count = 0;
+  size_t bytes = 0;
+  for (const CallSite& site : profile) {
+    count += site.estimated_count;
+    bytes += site.estimated_bytes;
+  }
+  trace_event::MemoryAllocatorDump* dump =
+      pmd->CreateAllocatorDump("sampling_heap_profiler");
+  dump->AddScalar(trace_event::MemoryAllocatorDump::kNameObjectCount,
+                  trace_event::MemoryAllocatorDump::kUnitsObjects, count);
+  dump->AddScalar(trace_event::MemoryAllocatorDump::kNameSize,
+                  trace_event::MemoryAllocatorDump::kUnitsBytes, bytes);
+  return true;
+}
+
+}  // namespace base
@@ -0,0 +1,147 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_SAMPLING_HEAP_PROFILER_SAMPLING_HEAP_PROFILER_H_
+#define BASE_SAMPLING_HEAP_PROFILER_SAMPLING_HEAP_PROFILER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/containers/flat_hash_map.h"
+#include "base/debug/stack_trace.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace base {
+
+class FilePath;
+
+template <typename T> struct DefaultSingletonTraits;
+
+// Samples heap allocations and keeps the call stack of each sampled one that
+// is still alive, giving a per-call-site heap profile at a small cost.
+//
+// Sampling is a Poisson process over allocated bytes: every byte is picked
+// with probability 1 / sampling interval, so each thread draws exponentially
+// distributed gaps between samples and only the allocation that crosses a gap
+// pays for a stack trace and a lock. Large allocations are thus almost always
+// sampled and small ones rarely; the profile scales each sample back up to
+// an unbiased estimate.
+//
+// The allocator reports to the profiler through RecordAlloc() and
+// RecordFree(). base/sampling_heap_profiler/operator_new_hooks.h wires them
+// into operator new and delete; other allocators can call them directly.
+//
+//   SamplingHeapProfiler::GetInstance()->Start();
+//   ...
+//   SamplingHeapProfiler::GetInstance()->DumpProfile(path);
+//
+// The dump is a gperftools heap profile that pprof reads.
+class BASE_EXPORT SamplingHeapProfiler
+    : public trace_event::MemoryDumpProvider {
+ public:
+  // The default mean number of bytes between samples. At this rate a
+  // workload spends well under 2% of its time in the profiler.
+  static const size_t kDefaultSamplingInterval = 128 * 1024;
+
+  // The live allocations sampled at one call site.
+  struct CallSite {
+    std::vector<const void*> frames;
+    size_t sampled_count;
+    size_t sampled_bytes;
+    // Scaled up for the sampling probability of each allocation.
+    size_t estimated_count;
+    size_t estimated_bytes;
+  };
+
+  static SamplingHeapProfiler* GetInstance();
+
+  // Reports an allocation of |size| bytes at |address|. Costs one load
+  // while the profiler is stopped.
+  static void RecordAlloc(void* address, size_t size) {
+    if (UNLIKELY(subtle::NoBarrier_Load(&running_)))
+      GetInstance()->SampleAlloc(address, size);
+  }
+
+  // Reports that |address| was freed. Costs a hash and a load unless
+  // |address| may be a sampled allocation. Sampled allocations keep being
+  // tracked after Stop() until they are freed.
+  static void RecordFree(void* address) {
+    size_t index = FilterIndex(address);
+    if (UNLIKELY(subtle::NoBarrier_Load(&sampled_filter_[index])))
+      GetInstance()->SampleFree(address);
+  }
+
+  // Starts and stops sampling new allocations. The profiler registers as a
+  // MemoryDumpProvider named "sampling_heap_profiler" on first Start().
+  void Start();
+  void Stop();
+
+  // Sets the mean number of bytes between samples. An interval of 1 samples
+  // every allocation, which is meant for tests. Threads pick up a new
+  // interval on their next allocation.
+  void SetSamplingInterval(size_t sampling_interval);
+  size_t sampling_interval() const {
+    return static_cast<size_t>(subtle::NoBarrier_Load(&sampling_interval_));
+  }
+
+  // Returns the live sampled allocations grouped by call stack, largest
+  // estimated size first.
+  std::vector<CallSite> GetProfile();
+
+  // Writes the profile to |path| in the gperftools heap profile format.
+  // Returns false if the file could not be written.
+  bool DumpProfile(const FilePath& path);
+
+  // trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(trace_event::ProcessMemoryDump* pmd) override;
+
+ private:
+  friend struct DefaultSingletonTraits<SamplingHeapProfiler>;
+
+  struct Sample {
+    size_t size;
+    // The interval the sample was taken at, for scaling it back up.
+    size_t sampling_interval;
+    debug::StackTrace stack;
+  };
+
+  // Frees that miss every bucket of this filter skip the lock. A bucket
+  // counts the sampled allocations whose address hashes to it.
+  static const int kFilterBits = 12;
+
+  static size_t FilterIndex(const void* address) {
+    uint64_t hash = static_cast<uint64_t>(
+        reinterpret_cast<uintptr_t>(address) >> 4) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> (64 - kFilterBits));
+  }
+
+  SamplingHeapProfiler();
+  ~SamplingHeapProfiler() override;
+
+  void SampleAlloc(void* address, size_t size);
+  void SampleFree(void* address);
+
+  static subtle::Atomic32 running_;
+  static subtle::Atomic32 sampled_filter_[1 << kFilterBits];
+
+  subtle::AtomicWord sampling_interval_;
+
+  // Guards |samples_| and |registered_|.
+  Lock lock_;
+  FlatHashMap<const void*, Sample> samples_;
+  bool registered_;
+
+  DISALLOW_COPY_AND_ASSIGN(SamplingHeapProfiler);
+};
+
+}  // namespace base
+
+#endif  // BASE_SAMPLING_HEAP_PROFILER_SAMPLING_HEAP_PROFILER_H_
@@ -69,15 +69,18 @@ size_t FindFirstOf(StringPiece16 piece, StringPiece16 one_of, size_t pos) {
 // multiple characters (BasicStringPiece<Str>). StringPiece has a version of
 // find for both of these cases, and the single-character version is the most
 // common and can be implemented faster, which is why this is a template.
-template<typename Str, typename OutputStringType, typename DelimiterType>
-static std::vector<OutputStringType> SplitStringT(
-    BasicStringPiece<Str> str,
-    DelimiterType delimiter,
-    WhitespaceHandling whitespace,
-    SplitResult result_type) {
-  std::vector<OutputStringType> result;
+template <typename Str,
+          typename OutputStringType,
+          typename DelimiterType,
+          typename ResultType>
+static void SplitStringT(BasicStringPiece<Str> str,
+                         DelimiterType delimiter,
+                         WhitespaceHandling whitespace,
+                         SplitResult result_type,
+                         ResultType* result) {
+  result->clear();
   if (str.empty())
-    return result;
+    return;
 
   size_t start = 0;
   while (start != Str::npos) {
@@ -96,9 +99,25 @@ static std::vector<OutputStringType> SplitStringT(
       piece = TrimString(piece, WhitespaceForType<Str>(), TRIM_ALL);
 
     if (result_type == SPLIT_WANT_ALL || !piece.empty())
-      result.push_back(PieceToOutputType<Str, OutputStringType>(piece));
+      result->push_back(PieceToOutputType<Str, OutputStringType>(piece));
   }
-  return result;
+}
+
+// Splits on any of |separators|, using the faster single-character search
+// when there is only one.
+template <typename Str, typename OutputStringType, typename ResultType>
+void SplitStringOnAnyOf(BasicStringPiece<Str> input,
+                        BasicStringPiece<Str> separators,
+                        WhitespaceHandling whitespace,
+                        SplitResult result_type,
+                        ResultType* result) {
+  if (separators.size() == 1) {
+    SplitStringT<Str, OutputStringType>(input, separators[0], whitespace,
+                                        result_type, result);
+    return;
+  }
+  SplitStringT<Str, OutputStringType>(input, separators, whitespace,
+                                      result_type, result);
 }
 
 bool AppendStringKeyValue(StringPiece input,
@@ -161,48 +180,58 @@ std::vector<std::string> SplitString(StringPiece input,
                                      StringPiece separators,
                                      WhitespaceHandling whitespace,
                                      SplitResult result_type) {
-  if (separators.size() == 1) {
-    return SplitStringT<std::string, std::string, char>(
-        input, separators[0], whitespace, result_type);
-  }
-  return SplitStringT<std::string, std::string, StringPiece>(
-      input, separators, whitespace, result_type);
+  std::vector<std::string> result;
+  SplitStringOnAnyOf<std::string, std::string>(input, separators, whitespace,
+                                               result_type, &result);
+  return result;
 }
 
 std::vector<string16> SplitString(StringPiece16 input,
                                   StringPiece16 separators,
                                   WhitespaceHandling whitespace,
                                   SplitResult result_type) {
-  if (separators.size() == 1) {
-    return SplitStringT<string16, string16, char16>(
-        input, separators[0], whitespace, result_type);
-  }
-  return SplitStringT<string16, string16, StringPiece16>(
-      input, separators, whitespace, result_type);
+  std::vector<string16> result;
+  SplitStringOnAnyOf<string16, string16>(input, separators, whitespace,
+                                         result_type, &result);
+  return result;
 }
 
 std::vector<StringPiece> SplitStringPiece(StringPiece input,
                                           StringPiece separators,
                                           WhitespaceHandling whitespace,
                                           SplitResult result_type) {
-  if (separators.size() == 1) {
-    return SplitStringT<std::string, StringPiece, char>(
-        input, separators[0], whitespace, result_type);
-  }
-  return SplitStringT<std::string, StringPiece, StringPiece>(
-      input, separators, whitespace, result_type);
+  std::vector<StringPiece> result;
+  SplitStringOnAnyOf<std::string, StringPiece>(input, separators, whitespace,
+                                               result_type, &result);
+  return result;
 }
 
 std::vector<StringPiece16> SplitStringPiece(StringPiece16 input,
                                             StringPiece16 separators,
                                             WhitespaceHandling whitespace,
                                             SplitResult result_type) {
-  if (separators.size() == 1) {
-    return SplitStringT<string16, StringPiece16, char16>(
-        input, separators[0], whitespace, result_type);
-  }
-  return SplitStringT<string16, StringPiece16, StringPiece16>(
-      input, separators, whitespace, result_type);
+  std::vector<StringPiece16> result;
+  SplitStringOnAnyOf<string16, StringPiece16>(input, separators, whitespace,
+                                              result_type, &result);
+  return result;
+}
+
+void SplitStringPiece(StringPiece input,
+                      StringPiece separators,
+                      WhitespaceHandling whitespace,
+                      SplitResult result_type,
+                      StringPieceSmallVector* result) {
+  SplitStringOnAnyOf<std::string, StringPiece>(input, separators, whitespace,
+                                               result_type, result);
+}
+
+void SplitStringPiece(StringPiece16 input,
+                      StringPiece16 separators,
+                      WhitespaceHandling whitespace,
+                      SplitResult result_type,
+                      StringPiece16SmallVector* result) {
+  SplitStringOnAnyOf<string16, StringPiece16>(input, separators, whitespace,
+                                              result_type, result);
 }
 
 bool SplitStringIntoKeyValuePairs(StringPiece input,
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/base_export.h"
+#include "base/containers/small_vector.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
 
@@ -77,6 +78,22 @@ BASE_EXPORT std::vector<StringPiece16> SplitStringPiece(
     WhitespaceHandling whitespace,
     SplitResult result_type);
 
+// Like SplitStringPiece above, but replaces the contents of |result| with the
+// pieces. Up to eight pieces fit in |result| without any allocation, which
+// suits splitting many short lines or fields in a loop.
+typedef SmallVector<StringPiece, 8> StringPieceSmallVector;
+typedef SmallVector<StringPiece16, 8> StringPiece16SmallVector;
+BASE_EXPORT void SplitStringPiece(StringPiece input,
+                                  StringPiece separators,
+                                  WhitespaceHandling whitespace,
+                                  SplitResult result_type,
+                                  StringPieceSmallVector* result);
+BASE_EXPORT void SplitStringPiece(StringPiece16 input,
+                                  StringPiece16 separators,
+                                  WhitespaceHandling whitespace,
+                                  SplitResult result_type,
+                                  StringPiece16SmallVector* result);
+
 using StringPairs = std::vector<std::pair<std::string, std::string>>;
 
 // Splits |line| into key value pairs according to the given delimiters and
@@ -18,6 +18,7 @@
 #if defined(OS_POSIX)
 #include <list>
 #include <utility>
+#include "base/memory/object_pool.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/lock.h"
 #endif
@@ -147,8 +148,13 @@ class BASE_EXPORT WaitableEvent {
   // so we have a kernel of the WaitableEvent, which is reference counted.
   // WaitableEventWatchers may then take a reference and thus match the Windows
   // behaviour.
-  struct WaitableEventKernel :
-      public RefCountedThreadSafe<WaitableEventKernel> {
+  //
+  // Kernels are created and destroyed with every WaitableEvent, often on
+  // different threads, so they are recycled through an ObjectPool.
+  struct WaitableEventKernel
+      : public RefCountedThreadSafe<
+            WaitableEventKernel,
+            PooledRefCountedThreadSafeTraits<WaitableEventKernel>> {
    public:
     WaitableEventKernel(bool manual_reset, bool initially_signaled);
 
@@ -160,7 +166,9 @@ class BASE_EXPORT WaitableEvent {
     std::list<Waiter*> waiters_;
 
    private:
-    friend class RefCountedThreadSafe<WaitableEventKernel>;
+    friend class RefCountedThreadSafe<
+        WaitableEventKernel,
+        PooledRefCountedThreadSafeTraits<WaitableEventKernel>>;
     ~WaitableEventKernel();
   };
 
@@ -40,7 +40,8 @@ namespace base {
 // This is just an abstract base class for waking the two types of waiters
 // -----------------------------------------------------------------------------
 WaitableEvent::WaitableEvent(bool manual_reset, bool initially_signaled)
-    : kernel_(new WaitableEventKernel(manual_reset, initially_signaled)) {
+    : kernel_(MakePooledRefCounted<WaitableEventKernel>(manual_reset,
+                                                        initially_signaled)) {
 }
 
 WaitableEvent::~WaitableEvent() {
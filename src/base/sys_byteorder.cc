@@ -0,0 +1,153 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/sys_byteorder.h"
+
+#include <string.h>
+
+#include "base/cpu.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+#endif
+
+// GCC and clang only allow SSSE3/AVX2 intrinsics in functions compiled for
+// those instruction sets; the callers below check base::CPU first.
+#if defined(ARCH_CPU_X86_FAMILY) && defined(COMPILER_GCC)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+
+namespace base {
+
+namespace {
+
+template <typename T>
+void ByteSwapScalar(const char* src, char* dst, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    T value;
+    memcpy(&value, src + i * sizeof(T), sizeof(T));
+    value = ByteSwap(value);
+    memcpy(dst + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+// pshufb masks that reverse every 2, 4 or 8-byte group of a 16-byte lane.
+template <typename T>
+struct ShuffleMask;
+
+template <>
+struct ShuffleMask<uint16_t> {
+  static __m128i Get() {
+    return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  }
+};
+
+template <>
+struct ShuffleMask<uint32_t> {
+  static __m128i Get() {
+    return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  }
+};
+
+template <>
+struct ShuffleMask<uint64_t> {
+  static __m128i Get() {
+    return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  }
+};
+
+template <typename T>
+TARGET_SSSE3 void ByteSwapSSSE3(const char* src, char* dst, size_t count) {
+  const size_t kPerVector = sizeof(__m128i) / sizeof(T);
+  const __m128i mask = ShuffleMask<T>::Get();
+  size_t i = 0;
+  for (; i + kPerVector <= count; i += kPerVector) {
+    __m128i v = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(src + i * sizeof(T)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * sizeof(T)),
+                     _mm_shuffle_epi8(v, mask));
+  }
+  ByteSwapScalar<T>(src + i * sizeof(T), dst + i * sizeof(T), count - i);
+}
+
+template <typename T>
+TARGET_AVX2 void ByteSwapAVX2(const char* src, char* dst, size_t count) {
+  const size_t kPerVector = sizeof(__m256i) / sizeof(T);
+  // vpshufb shuffles within each 128-bit lane, so use the same mask twice.
+  const __m128i lane_mask = ShuffleMask<T>::Get();
+  const __m256i mask =
+      _mm256_inserti128_si256(_mm256_castsi128_si256(lane_mask), lane_mask, 1);
+  size_t i = 0;
+  for (; i + kPerVector <= count; i += kPerVector) {
+    __m256i v = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(src + i * sizeof(T)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * sizeof(T)),
+                        _mm256_shuffle_epi8(v, mask));
+  }
+  ByteSwapScalar<T>(src + i * sizeof(T), dst + i * sizeof(T), count - i);
+}
+
+enum class SwapImpl { kScalar, kSSSE3, kAVX2 };
+
+SwapImpl GetSwapImpl() {
+  static const SwapImpl impl = [] {
+    CPU cpu;
+    if (cpu.has_avx2())
+      return SwapImpl::kAVX2;
+    if (cpu.has_ssse3())
+      return SwapImpl::kSSSE3;
+    return SwapImpl::kScalar;
+  }();
+  return impl;
+}
+
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+
+template <typename T>
+void ByteSwapBufferImpl(const void* src, void* dst, size_t count) {
+  const char* in = static_cast<const char*>(src);
+  char* out = static_cast<char*>(dst);
+#if defined(ARCH_CPU_X86_FAMILY)
+  // Short arrays are not worth the vector setup.
+  if (count * sizeof(T) >= sizeof(__m128i)) {
+    switch (GetSwapImpl()) {
+      case SwapImpl::kAVX2:
+        ByteSwapAVX2<T>(in, out, count);
+        return;
+      case SwapImpl::kSSSE3:
+        ByteSwapSSSE3<T>(in, out, count);
+        return;
+      case SwapImpl::kScalar:
+        break;
+    }
+  }
+#endif
+  ByteSwapScalar<T>(in, out, count);
+}
+
+}  // namespace
+
+void ByteSwapBuffer16(const void* src, void* dst, size_t count) {
+  ByteSwapBufferImpl<uint16_t>(src, dst, count);
+}
+
+void ByteSwapBuffer32(const void* src, void* dst, size_t count) {
+  ByteSwapBufferImpl<uint32_t>(src, dst, count);
+}
+
+void ByteSwapBuffer64(const void* src, void* dst, size_t count) {
+  ByteSwapBufferImpl<uint64_t>(src, dst, count);
+}
+
+}  // namespace base
@@ -7,12 +7,18 @@
 // the traditional ntohX() and htonX() functions.
 // Use the functions defined here rather than using the platform-specific
 // functions directly.
+//
+// The *Buffer*() functions convert whole arrays at once and use SSSE3/AVX2
+// shuffles where the CPU supports them.
 
 #ifndef BASE_SYS_BYTEORDER_H_
 #define BASE_SYS_BYTEORDER_H_
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
+#include "base/base_export.h"
 #include "build/build_config.h"
 
 namespace base {
@@ -38,6 +44,13 @@ inline uint64_t ByteSwap(uint64_t x) {
       ((x & 0xff00000000000000ull) >> 56);
 }
 
+// Reverses the byte order of each of the |count| 16, 32 or 64-bit values in
+// |src| and stores the results in |dst|. Neither buffer needs to be aligned.
+// |src| and |dst| may be the same buffer but must not otherwise overlap.
+BASE_EXPORT void ByteSwapBuffer16(const void* src, void* dst, size_t count);
+BASE_EXPORT void ByteSwapBuffer32(const void* src, void* dst, size_t count);
+BASE_EXPORT void ByteSwapBuffer64(const void* src, void* dst, size_t count);
+
 // Converts the bytes in |x| from host order (endianness) to little endian, and
 // returns the result.
 inline uint16_t ByteSwapToLE16(uint16_t x) {
@@ -110,6 +123,49 @@ inline uint64_t HostToNet64(uint64_t x) {
 #endif
 }
 
+// Converts |count| values in |src| from network to host order and stores the
+// results in |dst|. See ByteSwapBuffer16() for the buffer requirements.
+inline void NetToHostBuffer16(const void* src, void* dst, size_t count) {
+#if defined(ARCH_CPU_LITTLE_ENDIAN)
+  ByteSwapBuffer16(src, dst, count);
+#else
+  if (src != dst)
+    memcpy(dst, src, count * sizeof(uint16_t));
+#endif
+}
+
+inline void NetToHostBuffer32(const void* src, void* dst, size_t count) {
+#if defined(ARCH_CPU_LITTLE_ENDIAN)
+  ByteSwapBuffer32(src, dst, count);
+#else
+  if (src != dst)
+    memcpy(dst, src, count * sizeof(uint32_t));
+#endif
+}
+
+inline void NetToHostBuffer64(const void* src, void* dst, size_t count) {
+#if defined(ARCH_CPU_LITTLE_ENDIAN)
+  ByteSwapBuffer64(src, dst, count);
+#else
+  if (src != dst)
+    memcpy(dst, src, count * sizeof(uint64_t));
+#endif
+}
+
+// Converts |count| values in |src| from host to network order and stores the
+// results in |dst|. See ByteSwapBuffer16() for the buffer requirements.
+inline void HostToNetBuffer16(const void* src, void* dst, size_t count) {
+  NetToHostBuffer16(src, dst, count);
+}
+
+inline void HostToNetBuffer32(const void* src, void* dst, size_t count) {
+  NetToHostBuffer32(src, dst, count);
+}
+
+inline void HostToNetBuffer64(const void* src, void* dst, size_t count) {
+  NetToHostBuffer64(src, dst, count);
+}
+
 }  // namespace base
 
 #endif  // BASE_SYS_BYTEORDER_H_
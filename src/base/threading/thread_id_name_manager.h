@@ -5,10 +5,10 @@
 #ifndef BASE_THREADING_THREAD_ID_NAME_MANAGER_H_
 #define BASE_THREADING_THREAD_ID_NAME_MANAGER_H_
 
-#include <map>
 #include <string>
 
 #include "base/base_export.h"
+#include "base/containers/flat_hash_map.h"
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/platform_thread.h"
@@ -39,11 +39,11 @@ class BASE_EXPORT ThreadIdNameManager {
  private:
   friend struct DefaultSingletonTraits<ThreadIdNameManager>;
 
-  typedef std::map<PlatformThreadId, PlatformThreadHandle::Handle>
+  typedef FlatHashMap<PlatformThreadId, PlatformThreadHandle::Handle>
       ThreadIdToHandleMap;
-  typedef std::map<PlatformThreadHandle::Handle, std::string*>
+  typedef FlatHashMap<PlatformThreadHandle::Handle, std::string*>
       ThreadHandleToInternedNameMap;
-  typedef std::map<std::string, std::string*> NameToInternedNameMap;
+  typedef FlatHashMap<std::string, std::string*> NameToInternedNameMap;
 
   ThreadIdNameManager();
   ~ThreadIdNameManager();
@@ -0,0 +1,100 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/memory_dump_manager.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/memory/singleton.h"
+#include "base/pickle.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+class PickleDumpProvider : public MemoryDumpProvider {
+ public:
+  bool OnMemoryDump(ProcessMemoryDump* pmd) override {
+    size_t count;
+    size_t bytes;
+    Pickle::GetAllocationStats(&count, &bytes);
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("pickle");
+    dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                    MemoryAllocatorDump::kUnitsObjects, count);
+    dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                    MemoryAllocatorDump::kUnitsBytes, bytes);
+    return true;
+  }
+};
+
+// RefCountedMemory subclasses report their size through a virtual, which
+// the base class cannot call while counting, so only the count is known.
+class RefCountedMemoryDumpProvider : public MemoryDumpProvider {
+ public:
+  bool OnMemoryDump(ProcessMemoryDump* pmd) override {
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("ref_counted_memory");
+    dump->AddScalar(MemoryAllocatorDump::kNameObjectCount,
+                    MemoryAllocatorDump::kUnitsObjects,
+                    RefCountedMemory::GetLiveCount());
+    return true;
+  }
+};
+
+}  // namespace
+
+// static
+MemoryDumpManager* MemoryDumpManager::GetInstance() {
+  return Singleton<MemoryDumpManager,
+                   LeakySingletonTraits<MemoryDumpManager>>::get();
+}
+
+MemoryDumpManager::MemoryDumpManager() {
+  // Leaked along with the manager.
+  RegisterDumpProvider(new PickleDumpProvider, "pickle");
+  RegisterDumpProvider(new RefCountedMemoryDumpProvider, "ref_counted_memory");
+}
+
+MemoryDumpManager::~MemoryDumpManager() {}
+
+void MemoryDumpManager::RegisterDumpProvider(MemoryDumpProvider* provider,
+                                             const char* name) {
+  DCHECK(provider);
+  ProviderInfo info;
+  info.provider = provider;
+  info.name = name;
+  AutoLock lock(lock_);
+  providers_.push_back(info);
+}
+
+void MemoryDumpManager::UnregisterDumpProvider(MemoryDumpProvider* provider) {
+  AutoLock lock(lock_);
+  std::vector<ProviderInfo>::iterator it = std::find_if(
+      providers_.begin(), providers_.end(),
+      [provider](const ProviderInfo& info) {
+        return info.provider == provider;
+      });
+  DCHECK(it != providers_.end()) << "Unregistering an unknown provider";
+  if (it != providers_.end())
+    providers_.erase(it);
+}
+
+bool MemoryDumpManager::CreateProcessDump(ProcessMemoryDump* pmd) {
+  bool success = true;
+  AutoLock lock(lock_);
+  for (const ProviderInfo& info : providers_) {
+    if (!info.provider->OnMemoryDump(pmd)) {
+      DLOG(WARNING) << "Memory dump provider " << info.name << " failed";
+      success = false;
+    }
+  }
+  return success;
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -0,0 +1,66 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_MEMORY_DUMP_MANAGER_H_
+#define BASE_TRACE_EVENT_MEMORY_DUMP_MANAGER_H_
+
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+
+namespace base {
+
+template <typename T> struct DefaultSingletonTraits;
+
+namespace trace_event {
+
+class MemoryDumpProvider;
+class ProcessMemoryDump;
+
+// Keeps the registered MemoryDumpProviders and asks each of them to report
+// when a dump is requested. base's own accounting, for Pickle and
+// RefCountedMemory, is always registered.
+//
+//   ProcessMemoryDump pmd;
+//   MemoryDumpManager::GetInstance()->CreateProcessDump(&pmd);
+//   LOG(INFO) << pmd.ToString();
+class BASE_EXPORT MemoryDumpManager {
+ public:
+  static MemoryDumpManager* GetInstance();
+
+  // |name| must outlive the registration. Providers can be registered and
+  // unregistered on any thread; once UnregisterDumpProvider() returns,
+  // |provider| is not called again.
+  void RegisterDumpProvider(MemoryDumpProvider* provider, const char* name);
+  void UnregisterDumpProvider(MemoryDumpProvider* provider);
+
+  // Asks every provider to add its dumps to |pmd|. Returns false if any
+  // provider failed.
+  bool CreateProcessDump(ProcessMemoryDump* pmd);
+
+ private:
+  friend struct DefaultSingletonTraits<MemoryDumpManager>;
+
+  struct ProviderInfo {
+    MemoryDumpProvider* provider;
+    const char* name;
+  };
+
+  MemoryDumpManager();
+  ~MemoryDumpManager();
+
+  // Held while providers run, which is what makes unregistering safe.
+  Lock lock_;
+  std::vector<ProviderInfo> providers_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryDumpManager);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_MEMORY_DUMP_MANAGER_H_
@@ -0,0 +1,38 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_MEMORY_DUMP_PROVIDER_H_
+#define BASE_TRACE_EVENT_MEMORY_DUMP_PROVIDER_H_
+
+#include "base/base_export.h"
+#include "base/macros.h"
+
+namespace base {
+namespace trace_event {
+
+class ProcessMemoryDump;
+
+// The interface a subsystem implements to report how much memory it holds.
+// Register it with MemoryDumpManager.
+class BASE_EXPORT MemoryDumpProvider {
+ public:
+  virtual ~MemoryDumpProvider() {}
+
+  // Adds allocator dumps describing the provider's memory to |pmd|. Called
+  // on the thread requesting the dump, with the manager's lock held, so it
+  // must not register or unregister providers. Returns false if nothing
+  // could be reported.
+  virtual bool OnMemoryDump(ProcessMemoryDump* pmd) = 0;
+
+ protected:
+  MemoryDumpProvider() {}
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(MemoryDumpProvider);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_MEMORY_DUMP_PROVIDER_H_
@@ -0,0 +1,80 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/trace_event/process_memory_dump.h"
+
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace base {
+namespace trace_event {
+
+const char MemoryAllocatorDump::kNameSize[] = "size";
+const char MemoryAllocatorDump::kNameObjectCount[] = "object_count";
+const char MemoryAllocatorDump::kUnitsBytes[] = "bytes";
+const char MemoryAllocatorDump::kUnitsObjects[] = "objects";
+
+MemoryAllocatorDump::MemoryAllocatorDump(const std::string& absolute_name)
+    : absolute_name_(absolute_name) {}
+
+MemoryAllocatorDump::~MemoryAllocatorDump() {}
+
+void MemoryAllocatorDump::AddScalar(const char* name,
+                                    const char* units,
+                                    uint64_t value) {
+  Entry entry;
+  entry.name = name;
+  entry.units = units;
+  entry.value = value;
+  entries_.push_back(entry);
+}
+
+bool MemoryAllocatorDump::GetScalar(const char* name, uint64_t* value) const {
+  for (const Entry& entry : entries_) {
+    if (entry.name == name) {
+      *value = entry.value;
+      return true;
+    }
+  }
+  return false;
+}
+
+ProcessMemoryDump::ProcessMemoryDump() {}
+
+ProcessMemoryDump::~ProcessMemoryDump() {}
+
+MemoryAllocatorDump* ProcessMemoryDump::CreateAllocatorDump(
+    const std::string& absolute_name) {
+  std::unique_ptr<MemoryAllocatorDump>& dump = allocator_dumps_[absolute_name];
+  DCHECK(!dump) << "Duplicate allocator dump " << absolute_name;
+  dump.reset(new MemoryAllocatorDump(absolute_name));
+  return dump.get();
+}
+
+MemoryAllocatorDump* ProcessMemoryDump::GetAllocatorDump(
+    const std::string& absolute_name) const {
+  AllocatorDumpsMap::const_iterator it = allocator_dumps_.find(absolute_name);
+  return it == allocator_dumps_.end() ? NULL : it->second.get();
+}
+
+std::string ProcessMemoryDump::ToString() const {
+  std::string result;
+  for (const auto& it : allocator_dumps_) {
+    result += it.first;
+    result += ':';
+    for (const MemoryAllocatorDump::Entry& entry : it.second->entries()) {
+      result += ' ';
+      result += entry.name;
+      result += '=';
+      result += Uint64ToString(entry.value);
+      result += ' ';
+      result += entry.units;
+    }
+    result += '\n';
+  }
+  return result;
+}
+
+}  // namespace trace_event
+}  // namespace base
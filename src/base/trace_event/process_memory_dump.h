@@ -0,0 +1,85 @@
+// Copyright 2026 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TRACE_EVENT_PROCESS_MEMORY_DUMP_H_
+#define BASE_TRACE_EVENT_PROCESS_MEMORY_DUMP_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+
+namespace base {
+namespace trace_event {
+
+// A named set of scalars describing one allocator or subsystem, such as
+// "pickle" or "message_loop/0x1234".
+class BASE_EXPORT MemoryAllocatorDump {
+ public:
+  // Well-known scalar names and units.
+  static const char kNameSize[];
+  static const char kNameObjectCount[];
+  static const char kUnitsBytes[];
+  static const char kUnitsObjects[];
+
+  struct Entry {
+    std::string name;
+    std::string units;
+    uint64_t value;
+  };
+
+  explicit MemoryAllocatorDump(const std::string& absolute_name);
+  ~MemoryAllocatorDump();
+
+  void AddScalar(const char* name, const char* units, uint64_t value);
+
+  // Returns false if no scalar called |name| was added.
+  bool GetScalar(const char* name, uint64_t* value) const;
+
+  const std::string& absolute_name() const { return absolute_name_; }
+  const std::vector<Entry>& entries() const { return entries_; }
+
+ private:
+  const std::string absolute_name_;
+  std::vector<Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(MemoryAllocatorDump);
+};
+
+// The result of one memory dump: the allocator dumps every registered
+// MemoryDumpProvider added.
+class BASE_EXPORT ProcessMemoryDump {
+ public:
+  typedef std::map<std::string, std::unique_ptr<MemoryAllocatorDump>>
+      AllocatorDumpsMap;
+
+  ProcessMemoryDump();
+  ~ProcessMemoryDump();
+
+  // Creates a dump called |absolute_name|, which must not exist yet.
+  MemoryAllocatorDump* CreateAllocatorDump(const std::string& absolute_name);
+
+  // Returns NULL if there is no dump called |absolute_name|.
+  MemoryAllocatorDump* GetAllocatorDump(const std::string& absolute_name) const;
+
+  const AllocatorDumpsMap& allocator_dumps() const { return allocator_dumps_; }
+
+  // One line per dump, e.g. "pickle: object_count=3 objects size=192 bytes".
+  std::string ToString() const;
+
+ private:
+  AllocatorDumpsMap allocator_dumps_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProcessMemoryDump);
+};
+
+}  // namespace trace_event
+}  // namespace base
+
+#endif  // BASE_TRACE_EVENT_PROCESS_MEMORY_DUMP_H_
@@ -24,8 +24,8 @@ namespace {
 // parsed successfully, false otherwise.
 bool ParseVersionNumbers(const std::string& version_str,
                          std::vector<uint32_t>* parsed) {
-  std::vector<StringPiece> numbers =
-      SplitStringPiece(version_str, ".", KEEP_WHITESPACE, SPLIT_WANT_ALL);
+  StringPieceSmallVector numbers;
+  SplitStringPiece(version_str, ".", KEEP_WHITESPACE, SPLIT_WANT_ALL, &numbers);
   if (numbers.empty())
     return false;
 
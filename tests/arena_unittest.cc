@@ -0,0 +1,98 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/arena.h"
+
+namespace base {
+
+namespace {
+
+class Tracked {
+ public:
+  Tracked(std::vector<int>* log, int id) : log_(log), id_(id) {}
+  ~Tracked() { log_->push_back(id_); }
+
+ private:
+  std::vector<int>* log_;
+  int id_;
+};
+
+}  // namespace
+
+TEST_CASE("Arena allocation", "[Arena]") {
+  Arena arena(1024);
+
+  SECTION("allocations are aligned and distinct") {
+    char* previous = nullptr;
+    for (size_t i = 1; i < 2000; ++i) {
+      const size_t alignment = size_t(1) << (i % 7);
+      char* p = static_cast<char*>(arena.Allocate(i % 100 + 1, alignment));
+      REQUIRE(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+      REQUIRE(p != previous);
+      memset(p, 0xab, i % 100 + 1);
+      previous = p;
+    }
+    void* big = arena.Allocate(100000, 64);
+    REQUIRE(reinterpret_cast<uintptr_t>(big) % 64 == 0);
+    memset(big, 0, 100000);
+    REQUIRE(arena.bytes_reserved() >= 100000u);
+  }
+
+  SECTION("destructors run in reverse order") {
+    std::vector<int> log;
+    {
+      Arena scoped(1024);
+      for (int i = 0; i < 100; ++i)
+        scoped.New<Tracked>(&log, i);
+      scoped.New<std::string>(1000, 'x');
+    }
+    REQUIRE(log.size() == 100u);
+    for (int i = 0; i < 100; ++i)
+      REQUIRE(log[i] == 99 - i);
+  }
+
+  SECTION("ScopedArenaReset releases only what was allocated inside it") {
+    std::vector<int> log;
+    arena.New<Tracked>(&log, 1);
+    int* outer = arena.New<int>(7);
+    const size_t reserved = arena.bytes_reserved();
+    for (int round = 0; round < 3; ++round) {
+      ScopedArenaReset reset(&arena);
+      for (int i = 0; i < 500; ++i)
+        arena.New<Tracked>(&log, 2);
+      arena.Allocate(10000);
+    }
+    REQUIRE(log.size() == 1500u);
+    REQUIRE(*outer == 7);
+    // One spare block may be kept around for the next round.
+    REQUIRE(arena.bytes_reserved() <= reserved + 1024);
+
+    arena.Reset();
+    REQUIRE(log.size() == 1501u);
+    REQUIRE(log.back() == 1);
+  }
+
+  SECTION("ArenaAllocator backs STL containers") {
+    typedef std::map<int, int, std::less<int>,
+                     ArenaAllocator<std::pair<const int, int>>>
+        ArenaMap;
+    ArenaMap map{std::less<int>(),
+                 ArenaAllocator<std::pair<const int, int>>(&arena)};
+    std::vector<int, ArenaAllocator<int>> vector{ArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 1000; ++i) {
+      map[i] = i * 2;
+      vector.push_back(i);
+    }
+    REQUIRE(map.size() == 1000u);
+    REQUIRE(map[999] == 1998);
+    REQUIRE(vector[500] == 500);
+  }
+}
+
+}  // namespace base
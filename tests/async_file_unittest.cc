@@ -0,0 +1,143 @@
+#include <string.h>
+
+#include <functional>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/async_file.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+
+namespace base {
+
+namespace {
+
+const int kBlockSize = 4096;
+const int kBlocks = 256;
+
+void FillBlock(int block, char* data) {
+  for (int i = 0; i < kBlockSize; ++i)
+    data[i] = static_cast<char>(block * 31 + i);
+}
+
+void StoreResult(int* out, int result) {
+  *out = result;
+}
+
+void ReadAndWriteBlocks(const FilePath& path, bool disable_io_uring) {
+  File file(path, File::FLAG_CREATE_ALWAYS | File::FLAG_READ |
+                      File::FLAG_WRITE);
+  REQUIRE(file.IsValid());
+
+  AsyncFile::Options options;
+  options.queue_depth = 32;
+  options.disable_io_uring = disable_io_uring;
+  AsyncFile async_file(&file, options);
+  if (disable_io_uring)
+    REQUIRE(!async_file.using_io_uring());
+
+  std::vector<char> written(kBlocks * kBlockSize);
+  std::vector<int> results(kBlocks, 0);
+  for (int block = 0; block < kBlocks; ++block) {
+    char* data = &written[block * kBlockSize];
+    FillBlock(block, data);
+    // Keeps the queue full, reaping only when it has to.
+    while (!async_file.Write(block * kBlockSize, data, kBlockSize,
+                             std::bind(&StoreResult, &results[block],
+                                       std::placeholders::_1))) {
+      async_file.ProcessCompletions(true);
+    }
+  }
+  async_file.WaitForAll();
+  for (int result : results)
+    REQUIRE(result == kBlockSize);
+  REQUIRE(file.GetLength() == kBlocks * kBlockSize);
+
+  std::vector<char> read(kBlocks * kBlockSize);
+  for (int block = kBlocks - 1; block >= 0; --block) {
+    while (!async_file.Read(block * kBlockSize, &read[block * kBlockSize],
+                            kBlockSize,
+                            std::bind(&StoreResult, &results[block],
+                                      std::placeholders::_1))) {
+      async_file.ProcessCompletions(true);
+    }
+  }
+  async_file.WaitForAll();
+  REQUIRE(async_file.in_flight() == 0);
+  for (int result : results)
+    REQUIRE(result == kBlockSize);
+  REQUIRE(memcmp(&read[0], &written[0], read.size()) == 0);
+
+  // A read across the end of the file comes back short.
+  char tail[kBlockSize * 2];
+  int result = 0;
+  REQUIRE(async_file.Read((kBlocks - 1) * kBlockSize, tail, sizeof(tail),
+                          std::bind(&StoreResult, &result,
+                                    std::placeholders::_1)));
+  async_file.WaitForAll();
+  REQUIRE(result == kBlockSize);
+}
+
+}  // namespace
+
+TEST_CASE("AsyncFile", "[AsyncFile]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("async");
+
+  SECTION("thread pool backend") {
+    ReadAndWriteBlocks(path, true);
+  }
+
+  SECTION("default backend") {
+    ReadAndWriteBlocks(path, false);
+  }
+
+  SECTION("queue depth bounds operations in flight") {
+    File file(path, File::FLAG_CREATE_ALWAYS | File::FLAG_READ |
+                        File::FLAG_WRITE);
+    AsyncFile::Options options;
+    options.queue_depth = 2;
+    AsyncFile async_file(&file, options);
+    char data[16] = "0123456789abcde";
+    int results[3] = {0, 0, 0};
+    REQUIRE(async_file.Write(0, data, 8,
+                             std::bind(&StoreResult, &results[0],
+                                       std::placeholders::_1)));
+    REQUIRE(async_file.Write(8, data + 8, 8,
+                             std::bind(&StoreResult, &results[1],
+                                       std::placeholders::_1)));
+    REQUIRE(!async_file.Write(16, data, 8,
+                              std::bind(&StoreResult, &results[2],
+                                        std::placeholders::_1)));
+    REQUIRE(async_file.in_flight() == 2);
+    async_file.WaitForAll();
+    REQUIRE(results[0] == 8);
+    REQUIRE(results[1] == 8);
+    REQUIRE(results[2] == 0);
+  }
+
+  SECTION("callbacks can be handed to a task runner") {
+    File file(path, File::FLAG_CREATE_ALWAYS | File::FLAG_READ |
+                        File::FLAG_WRITE);
+    std::vector<Closure> tasks;
+    AsyncFile::Options options;
+    options.post_task = [&tasks](const Closure& task) {
+      tasks.push_back(task);
+    };
+    AsyncFile async_file(&file, options);
+    int result = 0;
+    REQUIRE(async_file.Write(0, "data", 4,
+                             std::bind(&StoreResult, &result,
+                                       std::placeholders::_1)));
+    async_file.WaitForAll();
+    REQUIRE(result == 0);
+    REQUIRE(tasks.size() == 1u);
+    tasks[0]();
+    REQUIRE(result == 4);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,69 @@
+#include <stdint.h>
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/big_endian.h"
+
+namespace base {
+
+TEST_CASE("Bulk big endian reads and writes", "[BigEndian]") {
+  // Odd counts exercise both the vector loop and the scalar tail.
+  const size_t kCount = 37;
+  std::vector<uint16_t> u16(kCount);
+  std::vector<uint32_t> u32(kCount);
+  std::vector<uint64_t> u64(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    u16[i] = static_cast<uint16_t>(0x0102 * (i + 1));
+    u32[i] = static_cast<uint32_t>(0x01020304u * (i + 1));
+    u64[i] = 0x0102030405060708ull * (i + 1);
+  }
+
+  // Offset by one byte so the buffer is deliberately unaligned.
+  std::vector<char> buffer(1 + kCount * (2 + 4 + 8));
+  BigEndianWriter writer(buffer.data() + 1, buffer.size() - 1);
+  REQUIRE(writer.WriteU16Array(u16.data(), kCount));
+  REQUIRE(writer.WriteU32Array(u32.data(), kCount));
+  REQUIRE(writer.WriteU64Array(u64.data(), kCount));
+  REQUIRE(writer.remaining() == 0);
+  REQUIRE_FALSE(writer.WriteU16Array(u16.data(), 1));
+
+  SECTION("element-wise reads see the bulk writes") {
+    BigEndianReader reader(buffer.data() + 1, buffer.size() - 1);
+    for (size_t i = 0; i < kCount; ++i) {
+      uint16_t v;
+      REQUIRE(reader.ReadU16(&v));
+      REQUIRE(v == u16[i]);
+    }
+  }
+
+  SECTION("bulk reads round trip") {
+    BigEndianReader reader(buffer.data() + 1, buffer.size() - 1);
+    std::vector<uint16_t> r16(kCount);
+    std::vector<uint32_t> r32(kCount);
+    std::vector<uint64_t> r64(kCount);
+    REQUIRE(reader.ReadU16Array(r16.data(), kCount));
+    REQUIRE(reader.ReadU32Array(r32.data(), kCount));
+    REQUIRE(reader.ReadU64Array(r64.data(), kCount));
+    REQUIRE(r16 == u16);
+    REQUIRE(r32 == u32);
+    REQUIRE(r64 == u64);
+    REQUIRE_FALSE(reader.ReadU64Array(r64.data(), 1));
+  }
+
+  SECTION("array views decode lazily") {
+    BigEndianReader reader(buffer.data() + 1, buffer.size() - 1);
+    REQUIRE(reader.Skip(kCount * sizeof(uint16_t)));
+    BigEndianArrayView<uint32_t> view;
+    REQUIRE(reader.ReadArrayView(&view, kCount));
+    REQUIRE(view.size() == kCount);
+    REQUIRE(view[5] == u32[5]);
+    std::vector<uint32_t> copy(kCount);
+    view.CopyTo(copy.data());
+    REQUIRE(copy == u32);
+    REQUIRE_FALSE(reader.ReadArrayView(&view, kCount * 3));
+  }
+}
+
+}  // namespace base
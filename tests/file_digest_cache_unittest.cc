@@ -0,0 +1,184 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file_digest_cache.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/md5.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
+#include "build/build_config.h"
+
+namespace base {
+
+namespace {
+
+// Writes |contents| and backdates the file, since the cache skips files
+// modified within the last second.
+void WriteOldFile(const FilePath& path, const std::string& contents) {
+  REQUIRE(WriteFile(path, contents.data(), static_cast<int>(contents.size())) ==
+          static_cast<int>(contents.size()));
+  Time old = Time::FromTimeT(1000000000);
+  REQUIRE(TouchFile(path, old, old));
+}
+
+bool HasDigestOf(FileDigestCache* cache,
+                 const FilePath& path,
+                 const std::string& contents) {
+  MD5Digest digest;
+  MD5Digest expected;
+  MD5Sum(contents.data(), contents.size(), &expected);
+  return cache->GetDigest(path, &digest) &&
+         MD5DigestToBase16(digest) == MD5DigestToBase16(expected);
+}
+
+#if defined(OS_LINUX)
+// Counts the mappings of index files that have since been replaced.
+int CountReplacedMappings(const FilePath& index) {
+  std::string maps;
+  REQUIRE(ReadFileToString(FilePath("/proc/self/maps"), &maps));
+  std::string replaced = index.value() + " (deleted)";
+  int count = 0;
+  for (size_t pos = maps.find(replaced); pos != std::string::npos;
+       pos = maps.find(replaced, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+#endif
+
+class DigestReader : public DelegateSimpleThread::Delegate {
+ public:
+  DigestReader(FileDigestCache* cache,
+               const std::vector<FilePath>& paths,
+               const std::vector<std::string>& contents)
+      : cache_(cache), paths_(paths), contents_(contents), failures_(0) {}
+
+  void Run() override {
+    for (size_t i = 0; i < paths_.size(); ++i) {
+      if (!HasDigestOf(cache_, paths_[i], contents_[i]))
+        ++failures_;
+    }
+  }
+
+  int failures() const { return failures_; }
+
+ private:
+  FileDigestCache* cache_;
+  const std::vector<FilePath>& paths_;
+  const std::vector<std::string>& contents_;
+  int failures_;
+};
+
+}  // namespace
+
+TEST_CASE("FileDigestCache", "[FileDigestCache]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath index = temp_dir.path().AppendASCII("digests");
+  FilePath path = temp_dir.path().AppendASCII("file");
+
+  SECTION("records digests of unchanged files") {
+    FileDigestCache cache;
+    REQUIRE(cache.Initialize(index));
+    WriteOldFile(path, "contents");
+    REQUIRE(HasDigestOf(&cache, path, "contents"));
+    REQUIRE(cache.size() == 1u);
+
+    // Rewriting the file without changing its size or time goes unnoticed,
+    // which shows the digest comes from the cache.
+    WriteOldFile(path, "CONTENTS");
+    REQUIRE(HasDigestOf(&cache, path, "contents"));
+
+    WriteOldFile(path, "new contents");
+    REQUIRE(HasDigestOf(&cache, path, "new contents"));
+    REQUIRE(cache.size() == 2u);
+
+    // Recently modified files are hashed every time.
+    std::string contents = "recent";
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    REQUIRE(HasDigestOf(&cache, path, "recent"));
+    REQUIRE(cache.size() == 2u);
+
+    MD5Digest digest;
+    REQUIRE(!cache.GetDigest(temp_dir.path().AppendASCII("missing"), &digest));
+    REQUIRE(!cache.GetDigest(temp_dir.path(), &digest));
+  }
+
+  SECTION("persists and grows") {
+    std::vector<FilePath> paths;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 5000; ++i) {
+      paths.push_back(temp_dir.path().AppendASCII(IntToString(i)));
+      contents.push_back(IntToString(i * 7919));
+      WriteOldFile(paths.back(), contents.back());
+    }
+    {
+      FileDigestCache cache;
+      REQUIRE(cache.Initialize(index));
+      // Readers on several threads race with the table growing.
+      std::vector<std::unique_ptr<DigestReader>> readers;
+      std::vector<std::unique_ptr<DelegateSimpleThread>> threads;
+      for (int i = 0; i < 4; ++i) {
+        readers.push_back(std::unique_ptr<DigestReader>(
+            new DigestReader(&cache, paths, contents)));
+        threads.push_back(std::unique_ptr<DelegateSimpleThread>(
+            new DelegateSimpleThread(readers.back().get(), "DigestReader")));
+        threads.back()->Start();
+      }
+      for (size_t i = 0; i < threads.size(); ++i) {
+        threads[i]->Join();
+        REQUIRE(readers[i]->failures() == 0);
+      }
+      REQUIRE(cache.size() == paths.size());
+#if defined(OS_LINUX)
+      // The tables replaced while growing are gone once the readers are.
+      MD5Digest digest;
+      REQUIRE(cache.GetDigest(paths[0], &digest));
+      REQUIRE(CountReplacedMappings(index) == 0);
+#endif
+    }
+
+    FileDigestCache cache;
+    REQUIRE(cache.Initialize(index));
+    REQUIRE(cache.size() == paths.size());
+    for (size_t i = 0; i < paths.size(); ++i)
+      REQUIRE(HasDigestOf(&cache, paths[i], contents[i]));
+    REQUIRE(cache.size() == paths.size());
+  }
+
+  SECTION("starts over with a damaged index") {
+    REQUIRE(WriteFile(index, "not an index", 12) == 12);
+    FileDigestCache cache;
+    REQUIRE(cache.Initialize(index));
+    REQUIRE(cache.size() == 0u);
+    WriteOldFile(path, "contents");
+    REQUIRE(HasDigestOf(&cache, path, "contents"));
+  }
+
+  SECTION("compares contents") {
+    FileDigestCache cache;
+    REQUIRE(cache.Initialize(index));
+    FilePath same = temp_dir.path().AppendASCII("same");
+    FilePath other = temp_dir.path().AppendASCII("other");
+    FilePath shorter = temp_dir.path().AppendASCII("shorter");
+    WriteOldFile(path, "contents");
+    WriteOldFile(same, "contents");
+    WriteOldFile(other, "CONTENTS");
+    WriteOldFile(shorter, "content");
+
+    REQUIRE(cache.ContentsEqual(path, same));
+    REQUIRE(cache.ContentsEqual(path, path));
+    REQUIRE(!cache.ContentsEqual(path, other));
+    REQUIRE(!cache.ContentsEqual(path, shorter));
+    REQUIRE(!cache.ContentsEqual(path, temp_dir.path().AppendASCII("none")));
+    REQUIRE(cache.size() == 3u);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,205 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/parallel_file_enumerator.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace base {
+
+namespace {
+
+// Builds a tree of |width| subdirectories per level, |depth| levels deep,
+// with |width| files of varying sizes in each directory. Records the size of
+// every file in |files|.
+void MakeTree(const FilePath& root,
+              int width,
+              int depth,
+              std::map<FilePath, int64_t>* files) {
+  REQUIRE(CreateDirectory(root));
+  for (int i = 0; i < width; ++i) {
+    FilePath file = root.AppendASCII("file" + IntToString(i));
+    std::string contents(files->size() % 1000, 'x');
+    REQUIRE(WriteFile(file, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    (*files)[file] = contents.size();
+    if (depth > 1)
+      MakeTree(root.AppendASCII("dir" + IntToString(i)), width, depth - 1,
+               files);
+  }
+}
+
+std::vector<FilePath> Enumerate(
+    const FilePath& root,
+    int file_type,
+    const ParallelFileEnumerator::Options& options) {
+  std::vector<FilePath> paths;
+  ParallelFileEnumerator enumerator(root, true, file_type, options);
+  for (FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    paths.push_back(path);
+  }
+  return paths;
+}
+
+// Appends |directory| and, depth first, the directories below it in the
+// order |children| lists them.
+void PreOrder(const FilePath& directory,
+              const std::map<FilePath, std::vector<FilePath>>& children,
+              std::vector<FilePath>* order) {
+  order->push_back(directory);
+  auto it = children.find(directory);
+  if (it == children.end())
+    return;
+  for (const FilePath& child : it->second)
+    PreOrder(child, children, order);
+}
+
+}  // namespace
+
+TEST_CASE("FileEnumerator", "[FileEnumerator]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath root = temp_dir.path().AppendASCII("root");
+  std::map<FilePath, int64_t> files;
+  MakeTree(root, 4, 4, &files);
+
+  SECTION("stats entries only when asked") {
+    FileEnumerator enumerator(root, true, FileEnumerator::FILES);
+    size_t count = 0;
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      REQUIRE(files.count(path) == 1u);
+      FileEnumerator::FileInfo info = enumerator.GetInfo();
+      REQUIRE(!info.IsDirectory());
+      REQUIRE(info.GetSize() == files[path]);
+      ++count;
+    }
+    REQUIRE(count == files.size());
+  }
+
+  SECTION("parallel enumeration finds the same entries") {
+    std::set<FilePath> expected;
+    FileEnumerator enumerator(
+        root, true, FileEnumerator::FILES | FileEnumerator::DIRECTORIES);
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      expected.insert(path);
+    }
+
+    for (int threads : {1, 3, 8}) {
+      ParallelFileEnumerator::Options options;
+      options.num_threads = threads;
+      std::vector<FilePath> paths = Enumerate(
+          root, FileEnumerator::FILES | FileEnumerator::DIRECTORIES, options);
+      REQUIRE(paths.size() == expected.size());
+      REQUIRE(std::set<FilePath>(paths.begin(), paths.end()) == expected);
+    }
+  }
+
+  SECTION("ordered results are depth first and repeatable") {
+    ParallelFileEnumerator::Options options;
+    options.order = ParallelFileEnumerator::ORDERED;
+    options.num_threads = 4;
+    std::vector<FilePath> paths = Enumerate(
+        root, FileEnumerator::FILES | FileEnumerator::DIRECTORIES, options);
+    REQUIRE(paths.size() == files.size() + 4 + 16 + 64);
+    for (int i = 0; i < 10; ++i) {
+      REQUIRE(Enumerate(root,
+                        FileEnumerator::FILES | FileEnumerator::DIRECTORIES,
+                        options) == paths);
+    }
+
+    // Each directory's entries come together, and the directories come in
+    // depth-first order of how their parents listed them.
+    std::vector<FilePath> runs;
+    std::map<FilePath, std::vector<FilePath>> children;
+    for (const FilePath& path : paths) {
+      if (runs.empty() || runs.back() != path.DirName())
+        runs.push_back(path.DirName());
+      if (DirectoryExists(path))
+        children[path.DirName()].push_back(path);
+    }
+    std::vector<FilePath> pre_order;
+    PreOrder(root, children, &pre_order);
+    REQUIRE(runs == pre_order);
+  }
+
+  SECTION("requested stat fields") {
+    ParallelFileEnumerator::Options options;
+    options.stat_fields = ParallelFileEnumerator::STAT_SIZE;
+    ParallelFileEnumerator enumerator(root, true, FileEnumerator::FILES,
+                                      options);
+    int64_t total = 0;
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      REQUIRE(enumerator.GetInfo().GetSize() == files[path]);
+      total += files[path];
+    }
+    REQUIRE(ComputeDirectorySize(root) == total);
+  }
+
+  SECTION("non-recursive and abandoned enumerations") {
+    ParallelFileEnumerator top(root, false, FileEnumerator::DIRECTORIES);
+    int count = 0;
+    for (FilePath path = top.Next(); !path.empty(); path = top.Next()) {
+      REQUIRE(top.GetInfo().IsDirectory());
+      ++count;
+    }
+    REQUIRE(count == 4);
+
+    for (ParallelFileEnumerator::Order order :
+         {ParallelFileEnumerator::UNORDERED, ParallelFileEnumerator::ORDERED}) {
+      ParallelFileEnumerator::Options options;
+      options.order = order;
+      ParallelFileEnumerator enumerator(root, true, FileEnumerator::FILES,
+                                        options);
+      REQUIRE(!enumerator.Next().empty());
+    }
+
+    REQUIRE(Enumerate(temp_dir.path().AppendASCII("missing"),
+                      FileEnumerator::FILES,
+                      ParallelFileEnumerator::Options()).empty());
+  }
+
+  SECTION("links to directories are not descended into") {
+    FilePath link = root.AppendASCII("dir0").AppendASCII("loop");
+    REQUIRE(CreateSymbolicLink(root, link));
+    std::vector<FilePath> paths =
+        Enumerate(root, FileEnumerator::FILES | FileEnumerator::DIRECTORIES,
+                  ParallelFileEnumerator::Options());
+    REQUIRE(paths.size() == files.size() + 4 + 16 + 64 + 1);
+
+    ParallelFileEnumerator::Options options;
+    options.num_threads = 1;
+    ParallelFileEnumerator enumerator(root.AppendASCII("dir0"), false,
+                                      FileEnumerator::DIRECTORIES, options);
+    int directories = 0;
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      ++directories;
+    }
+    REQUIRE(directories == 5);
+
+    ParallelFileEnumerator links(
+        root.AppendASCII("dir0"), false,
+        FileEnumerator::FILES | FileEnumerator::SHOW_SYM_LINKS, options);
+    int link_count = 0;
+    for (FilePath path = links.Next(); !path.empty(); path = links.Next()) {
+      if (path == link) {
+        REQUIRE(S_ISLNK(links.GetInfo().stat().st_mode));
+        ++link_count;
+      }
+    }
+    REQUIRE(link_count == 1);
+  }
+}
+
+}  // namespace base
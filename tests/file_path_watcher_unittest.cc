@@ -0,0 +1,195 @@
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file_path.h"
+#include "base/files/file_path_watcher.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+namespace {
+
+// Collects the changes a FilePathWatcher reports.
+class ChangeCollector {
+ public:
+  ChangeCollector() : changed_(&lock_), batches_(0), errors_(0) {}
+
+  FilePathWatcher::Callback callback() {
+    return [this](const std::vector<FilePath>& paths, bool error) {
+      AutoLock lock(lock_);
+      paths_.insert(paths.begin(), paths.end());
+      ++batches_;
+      errors_ += error;
+      changed_.Broadcast();
+    };
+  }
+
+  // Waits up to ten seconds for |path| to be reported, or for |count|
+  // batches.
+  bool WaitFor(const FilePath& path) {
+    return WaitUntil([this, &path] { return paths_.count(path) != 0; });
+  }
+  bool WaitForBatches(int count) {
+    return WaitUntil([this, count] { return batches_ >= count; });
+  }
+
+  bool Reported(const FilePath& path) {
+    AutoLock lock(lock_);
+    return paths_.count(path) != 0;
+  }
+
+  int batches() {
+    AutoLock lock(lock_);
+    return batches_;
+  }
+
+  int errors() {
+    AutoLock lock(lock_);
+    return errors_;
+  }
+
+ private:
+  bool WaitUntil(const std::function<bool()>& done) {
+    AutoLock lock(lock_);
+    TimeTicks deadline = TimeTicks::Now() + TimeDelta::FromSeconds(10);
+    while (!done()) {
+      TimeTicks now = TimeTicks::Now();
+      if (now >= deadline)
+        return false;
+      changed_.TimedWait(deadline - now);
+    }
+    return true;
+  }
+
+  Lock lock_;
+  ConditionVariable changed_;
+  std::set<FilePath> paths_;
+  int batches_;
+  int errors_;
+};
+
+void Write(const FilePath& path, const std::string& contents) {
+  REQUIRE(WriteFile(path, contents.data(), static_cast<int>(contents.size())) ==
+          static_cast<int>(contents.size()));
+}
+
+}  // namespace
+
+TEST_CASE("FilePathWatcher", "[FilePathWatcher]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath root = temp_dir.path().AppendASCII("root");
+  REQUIRE(CreateDirectory(root.AppendASCII("a").AppendASCII("b")));
+  FilePath file = root.AppendASCII("config");
+
+  for (bool force_polling : {false, true}) {
+    FilePathWatcher::Options options;
+    options.force_polling = force_polling;
+    options.poll_interval = TimeDelta::FromMilliseconds(20);
+
+    SECTION(force_polling ? "polled file" : "watched file") {
+      ChangeCollector collector;
+      FilePathWatcher watcher;
+      REQUIRE(watcher.Watch(file, options, collector.callback()));
+#if defined(OS_LINUX)
+      REQUIRE(watcher.using_inotify() == !force_polling);
+#endif
+
+      // Replacing the file by rename, as editors do, is seen as well.
+      Write(file, "created");
+      REQUIRE(collector.WaitFor(file));
+      int batches = collector.batches();
+      FilePath temp = root.AppendASCII("config.tmp");
+      Write(temp, "replaced");
+      REQUIRE(Move(temp, file));
+      REQUIRE(collector.WaitForBatches(batches + 1));
+      REQUIRE(collector.errors() == 0);
+      REQUIRE(!collector.Reported(root.AppendASCII("a")));
+    }
+
+    SECTION(force_polling ? "polled tree" : "watched tree") {
+      options.recursive = true;
+      ChangeCollector collector;
+      FilePathWatcher watcher;
+      REQUIRE(watcher.Watch(root, options, collector.callback()));
+
+      FilePath deep = root.AppendASCII("a").AppendASCII("b").AppendASCII("c");
+      Write(deep, "deep");
+      REQUIRE(collector.WaitFor(deep));
+
+      // New directories are watched as they appear.
+      FilePath created = root.AppendASCII("new").AppendASCII("dir");
+      REQUIRE(CreateDirectory(created));
+      FilePath inside = created.AppendASCII("file");
+      Write(inside, "inside");
+      REQUIRE(collector.WaitFor(inside));
+
+      // Directories moved away are no longer watched under the old name.
+      FilePath moved = root.AppendASCII("moved");
+      REQUIRE(Move(root.AppendASCII("new"), moved));
+      FilePath moved_file = moved.AppendASCII("dir").AppendASCII("file");
+      REQUIRE(collector.WaitFor(moved_file));
+      REQUIRE(collector.errors() == 0);
+    }
+  }
+
+  SECTION("coalesces bursts") {
+    FilePathWatcher::Options options;
+    options.recursive = true;
+    options.debounce = TimeDelta::FromMilliseconds(200);
+    options.max_delay = TimeDelta::FromSeconds(5);
+    ChangeCollector collector;
+    FilePathWatcher watcher;
+    REQUIRE(watcher.Watch(root, options, collector.callback()));
+    for (int i = 0; i < 50; ++i)
+      Write(file, std::string(i, 'x'));
+    Write(root.AppendASCII("last"), "last");
+    REQUIRE(collector.WaitFor(root.AppendASCII("last")));
+    REQUIRE(collector.Reported(file));
+    REQUIRE(collector.batches() == 1);
+  }
+
+  SECTION("posts callbacks") {
+    std::vector<Closure> tasks;
+    Lock lock;
+    FilePathWatcher::Options options;
+    options.post_task = [&](const Closure& task) {
+      AutoLock auto_lock(lock);
+      tasks.push_back(task);
+    };
+    ChangeCollector collector;
+    {
+      FilePathWatcher watcher;
+      REQUIRE(watcher.Watch(file, options, collector.callback()));
+      Write(file, "posted");
+      for (;;) {
+        AutoLock auto_lock(lock);
+        if (!tasks.empty())
+          break;
+        AutoUnlock unlock(lock);
+        PlatformThread::Sleep(TimeDelta::FromMilliseconds(1));
+      }
+    }
+    REQUIRE(!collector.Reported(file));
+    for (const Closure& task : tasks)
+      task();
+    REQUIRE(collector.Reported(file));
+  }
+
+  SECTION("missing directories") {
+    FilePathWatcher watcher;
+    REQUIRE(!watcher.Watch(root.AppendASCII("missing").AppendASCII("file"),
+                           false,
+                           [](const std::vector<FilePath>&, bool) {}));
+  }
+}
+
+}  // namespace base
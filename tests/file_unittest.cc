@@ -0,0 +1,139 @@
+#include <limits.h>
+#include <string.h>
+#include <sys/uio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/aligned_memory.h"
+
+namespace base {
+
+namespace {
+
+struct iovec MakeIOVec(const std::string& buffer) {
+  struct iovec iov;
+  iov.iov_base = const_cast<char*>(buffer.data());
+  iov.iov_len = buffer.size();
+  return iov;
+}
+
+std::string Contents(const FilePath& path) {
+  std::string contents;
+  REQUIRE(ReadFileToString(path, &contents));
+  return contents;
+}
+
+}  // namespace
+
+TEST_CASE("File", "[File]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("file");
+
+  SECTION("vectored reads and writes") {
+    File file(path, File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+    REQUIRE(file.IsValid());
+
+    std::string header = "header:";
+    std::string payload = "the payload";
+    struct iovec write_iov[] = {MakeIOVec(header), MakeIOVec(payload)};
+    REQUIRE(file.WriteV(3, write_iov, 2, 0) == 18);
+    REQUIRE(file.WriteV(21, write_iov, 2, File::IO_DSYNC) == 18);
+    REQUIRE(file.GetLength() == 39);
+
+    // The read buffers split the data differently, and run past the end.
+    std::string first(10, '\0');
+    std::string second(40, '\0');
+    struct iovec read_iov[] = {MakeIOVec(first), MakeIOVec(second)};
+    REQUIRE(file.ReadV(3, read_iov, 2, 0) == 36);
+    REQUIRE(first == "header:the");
+    REQUIRE(second.substr(0, 26) == " payloadheader:the payload");
+
+    int64_t nowait = file.ReadV(3, read_iov, 2, File::IO_NOWAIT);
+    REQUIRE((nowait == 36 || nowait == -1));
+
+    REQUIRE(file.ReadV(100, read_iov, 2, 0) == 0);
+    REQUIRE(file.ReadV(0, read_iov, 0, 0) == 0);
+  }
+
+  SECTION("more buffers than one system call takes") {
+    File file(path, File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+    const int kCount = IOV_MAX * 2 + 5;
+    std::vector<std::string> buffers;
+    std::vector<struct iovec> iov;
+    std::string expected;
+    for (int i = 0; i < kCount; ++i)
+      buffers.push_back(std::string(i % 7, static_cast<char>('a' + i % 26)));
+    for (const std::string& buffer : buffers) {
+      iov.push_back(MakeIOVec(buffer));
+      expected += buffer;
+    }
+    REQUIRE(file.WriteV(0, iov.data(), kCount, 0) ==
+            static_cast<int64_t>(expected.size()));
+    REQUIRE(Contents(path) == expected);
+
+    for (std::string& buffer : buffers)
+      buffer.assign(buffer.size(), '\0');
+    REQUIRE(file.ReadV(0, iov.data(), kCount, 0) ==
+            static_cast<int64_t>(expected.size()));
+    std::string read;
+    for (const std::string& buffer : buffers)
+      read += buffer;
+    REQUIRE(read == expected);
+  }
+
+  SECTION("appending") {
+    REQUIRE(WriteFile(path, "start", 5) == 5);
+    File file(path, File::FLAG_OPEN | File::FLAG_APPEND);
+    std::string data = "-end";
+    struct iovec iov[] = {MakeIOVec(data), MakeIOVec(data)};
+    REQUIRE(file.WriteV(0, iov, 2, 0) == 8);
+    REQUIRE(Contents(path) == "start-end-end");
+  }
+
+  SECTION("preallocation and advice") {
+    File file(path, File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+    REQUIRE(file.Preallocate(0, 1 << 20, false));
+    REQUIRE(file.GetLength() == 1 << 20);
+    REQUIRE(file.Preallocate(1 << 20, 1 << 20, true));
+    REQUIRE(file.GetLength() == 1 << 20);
+
+    REQUIRE(file.Advise(0, 0, File::ADVICE_SEQUENTIAL));
+    REQUIRE(file.Advise(4096, 8192, File::ADVICE_WILL_NEED));
+    REQUIRE(file.Advise(0, 0, File::ADVICE_DONT_NEED));
+  }
+
+  SECTION("direct I/O") {
+    File file(path, File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE |
+                        File::FLAG_DIRECT);
+    // Some file systems do not support uncached I/O.
+    if (file.IsValid()) {
+      const size_t kSize = 4 * File::kDirectIOAlignment;
+      std::unique_ptr<char, AlignedFreeDeleter> buffer(
+          static_cast<char*>(AlignedAlloc(kSize, File::kDirectIOAlignment)));
+      for (size_t i = 0; i < kSize; ++i)
+        buffer.get()[i] = static_cast<char>(i);
+      struct iovec iov[] = {
+          {buffer.get(), File::kDirectIOAlignment},
+          {buffer.get() + File::kDirectIOAlignment,
+           kSize - File::kDirectIOAlignment}};
+      REQUIRE(file.WriteV(File::kDirectIOAlignment, iov, 2, 0) ==
+              static_cast<int64_t>(kSize));
+      memset(buffer.get(), 0, kSize);
+      REQUIRE(file.Read(File::kDirectIOAlignment, buffer.get(),
+                        static_cast<int>(kSize)) == static_cast<int>(kSize));
+      for (size_t i = 0; i < kSize; ++i)
+        REQUIRE(buffer.get()[i] == static_cast<char>(i));
+    }
+  }
+}
+
+}  // namespace base
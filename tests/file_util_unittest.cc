@@ -0,0 +1,177 @@
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace base {
+
+namespace {
+
+std::string MakeContents(size_t size, int seed) {
+  std::string contents(size, '\0');
+  for (size_t i = 0; i < size; ++i)
+    contents[i] = static_cast<char>(i * 7 + seed + (i >> 12));
+  return contents;
+}
+
+void WriteContents(const FilePath& path, const std::string& contents) {
+  int size = static_cast<int>(contents.size());
+  REQUIRE(WriteFile(path, contents.data(), size) == size);
+}
+
+// Spreads the files of CopyDirectory tests over three levels.
+FilePath DirectoryForFile(const FilePath& root, int i) {
+  if (i % 3 == 0)
+    return root;
+  return i % 3 == 1 ? root.AppendASCII("a") : root.AppendASCII("a/b");
+}
+
+std::string ReadContents(const FilePath& path) {
+  std::string contents;
+  REQUIRE(ReadFileToString(path, &contents));
+  return contents;
+}
+
+}  // namespace
+
+TEST_CASE("CopyFile", "[FileUtil]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath from = temp_dir.path().AppendASCII("from");
+  FilePath to = temp_dir.path().AppendASCII("to");
+
+  SECTION("copies files of any size") {
+    const size_t kSizes[] = {0, 1, 4095, 4096, 1024 * 1024 + 3,
+                             9 * 1024 * 1024};
+    for (size_t size : kSizes) {
+      std::string contents = MakeContents(size, static_cast<int>(size));
+      WriteContents(from, contents);
+      REQUIRE(CopyFile(from, to));
+      REQUIRE(ReadContents(to) == contents);
+    }
+  }
+
+  SECTION("overwrites a longer destination") {
+    WriteContents(to, MakeContents(100000, 1));
+    std::string contents = MakeContents(10, 2);
+    WriteContents(from, contents);
+    REQUIRE(CopyFile(from, to));
+    REQUIRE(ReadContents(to) == contents);
+  }
+
+#if defined(OS_LINUX)
+  SECTION("copies regular files in the kernel") {
+    std::string contents = MakeContents(3 * 1024 * 1024, 3);
+    WriteContents(from, contents);
+    File infile(from, File::FLAG_OPEN | File::FLAG_READ);
+    File outfile(to, File::FLAG_CREATE_ALWAYS | File::FLAG_WRITE);
+    bool copied_all = false;
+    REQUIRE(internal::CopyFileContentsInKernel(&infile, &outfile, &copied_all));
+    REQUIRE(copied_all);
+    outfile.Close();
+    REQUIRE(ReadContents(to) == contents);
+  }
+
+  SECTION("copies files that claim to be empty") {
+    REQUIRE(CopyFile(FilePath("/proc/self/status"), to));
+    REQUIRE(ReadContents(to).find("Name:") == 0);
+  }
+#endif
+
+  SECTION("fails for a missing source") {
+    REQUIRE(!CopyFile(temp_dir.path().AppendASCII("missing"), to));
+  }
+}
+
+TEST_CASE("ReadFileToString", "[FileUtil]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("file");
+
+  SECTION("reads files of any size") {
+    const size_t kSizes[] = {0, 1, 4095, 4096, 4097, 3 * 1024 * 1024};
+    for (size_t size : kSizes) {
+      std::string contents = MakeContents(size, 1);
+      WriteContents(path, contents);
+      std::string read;
+      REQUIRE(ReadFileToString(path, &read));
+      REQUIRE(read == contents);
+      REQUIRE(ReadFileToString(path, NULL));
+    }
+  }
+
+  SECTION("stops at the maximum size") {
+    std::string contents = MakeContents(10000, 2);
+    WriteContents(path, contents);
+    std::string read;
+    REQUIRE(ReadFileToString(path, &read, 10000));
+    REQUIRE(read == contents);
+    REQUIRE(!ReadFileToString(path, &read, 9999));
+    REQUIRE(read == contents.substr(0, 9999));
+    REQUIRE(!ReadFileToString(path, &read, 0));
+    REQUIRE(read.empty());
+    REQUIRE(!ReadFileToString(path, NULL, 100));
+  }
+
+  SECTION("reads files that claim to be empty") {
+    std::string read;
+    REQUIRE(ReadFileToString(FilePath("/proc/self/status"), &read));
+    REQUIRE(read.find("Name:") == 0);
+    REQUIRE(read.size() > 100u);
+  }
+
+  SECTION("fails for directories and missing files") {
+    std::string read = "stale";
+    REQUIRE(!ReadFileToString(temp_dir.path(), &read));
+    REQUIRE(read.empty());
+    REQUIRE(!ReadFileToString(temp_dir.path().AppendASCII("missing"), &read));
+    REQUIRE(!ReadFileToString(temp_dir.path().AppendASCII("../file"), &read));
+  }
+
+  SECTION("reads into RefCountedBytes") {
+    std::string contents = MakeContents(70000, 3);
+    WriteContents(path, contents);
+    scoped_refptr<RefCountedBytes> buffer(new RefCountedBytes);
+    REQUIRE(ReadFileToBuffer(path, buffer.get()));
+    REQUIRE(buffer->size() == contents.size());
+    REQUIRE(std::string(buffer->front_as<char>(), buffer->size()) == contents);
+    REQUIRE(!ReadFileToBuffer(path, buffer.get(), 10));
+    REQUIRE(buffer->size() == 10u);
+  }
+}
+
+TEST_CASE("CopyDirectory", "[FileUtil]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath from = temp_dir.path().AppendASCII("from");
+  REQUIRE(CreateDirectory(from.AppendASCII("a").AppendASCII("b")));
+  const int kFiles = 200;
+  for (int i = 0; i < kFiles; ++i) {
+    FilePath path = DirectoryForFile(from, i).AppendASCII(IntToString(i));
+    WriteContents(path, MakeContents(i * 97, i));
+  }
+  WriteContents(from.AppendASCII("large"), MakeContents(4 * 1024 * 1024, 5));
+
+  for (int parallelism : {1, 4}) {
+    FilePath to = temp_dir.path().AppendASCII("to" + IntToString(parallelism));
+    REQUIRE(CopyDirectoryWithParallelism(from, to, true, parallelism));
+    for (int i = 0; i < kFiles; ++i) {
+      FilePath path = DirectoryForFile(to, i).AppendASCII(IntToString(i));
+      REQUIRE(ReadContents(path) == MakeContents(i * 97, i));
+    }
+    REQUIRE(ReadContents(to.AppendASCII("large")) ==
+            MakeContents(4 * 1024 * 1024, 5));
+  }
+
+  FilePath to = temp_dir.path().AppendASCII("to");
+  REQUIRE(CopyDirectory(from, to, true));
+  REQUIRE(ReadContents(to.AppendASCII("a/b/2")) == MakeContents(2 * 97, 2));
+}
+
+}  // namespace base
@@ -0,0 +1,92 @@
+#include <map>
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch.hpp"
+
+#include "base/containers/flat_hash_map.h"
+#include "base/containers/flat_map.h"
+#include "base/strings/string_number_conversions.h"
+
+namespace base {
+
+TEST_CASE("FlatHashMap matches std::map", "[FlatHashMap]") {
+  FlatHashMap<int, std::string> map;
+  std::map<int, std::string> reference;
+  REQUIRE(map.empty());
+  REQUIRE(map.find(1) == map.end());
+
+  // Enough elements for several rehashes, with interleaved erasures leaving
+  // tombstones behind.
+  for (int i = 0; i < 5000; ++i) {
+    map[i * 7] = IntToString(i);
+    reference[i * 7] = IntToString(i);
+    if (i % 3 == 0) {
+      REQUIRE(map.erase(i * 7 / 2 * 2) == reference.erase(i * 7 / 2 * 2));
+    }
+  }
+  REQUIRE(map.size() == reference.size());
+  for (const auto& entry : reference) {
+    auto it = map.find(entry.first);
+    REQUIRE(it != map.end());
+    REQUIRE(it->second == entry.second);
+  }
+  size_t visited = 0;
+  for (const auto& entry : map) {
+    REQUIRE(reference.count(entry.first) == 1u);
+    ++visited;
+  }
+  REQUIRE(visited == reference.size());
+
+  REQUIRE_FALSE(map.insert(std::make_pair(7, std::string("dup"))).second);
+  REQUIRE(map.emplace(-1, "negative").second);
+  REQUIRE(map.count(-1) == 1u);
+  map.erase(map.find(-1));
+  REQUIRE(map.count(-1) == 0u);
+
+  FlatHashMap<int, std::string> copy(map);
+  map.clear();
+  REQUIRE(map.empty());
+  REQUIRE(copy.size() == reference.size());
+}
+
+TEST_CASE("FlatHashSet with string keys", "[FlatHashMap]") {
+  FlatHashSet<std::string> set;
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(set.insert("key" + IntToString(i)).second);
+  REQUIRE_FALSE(set.insert("key42").second);
+  REQUIRE(set.count("key99") == 1u);
+  REQUIRE(set.count("key100") == 0u);
+  REQUIRE(set.erase("key0") == 1u);
+  REQUIRE(set.size() == 99u);
+
+  // Keys cannot be changed in place.
+  static_assert(std::is_same<FlatHashSet<std::string>::iterator,
+                             FlatHashSet<std::string>::const_iterator>::value,
+                "set iterators must be const");
+  static_assert(std::is_same<decltype(*set.begin()), const std::string&>::value,
+                "set elements must be const");
+  REQUIRE(*set.find("key1") == "key1");
+  set.erase(set.find("key1"));
+  REQUIRE(set.count("key1") == 0u);
+}
+
+TEST_CASE("flat_map keeps keys sorted", "[flat_map]") {
+  flat_map<std::string, int> map(
+      {{"b", 2}, {"a", 1}, {"c", 3}, {"a", 100}});
+  REQUIRE(map.size() == 3u);
+  REQUIRE(map.begin()->first == "a");
+  REQUIRE(map.begin()->second == 1);
+  REQUIRE(map.find("c")->second == 3);
+  REQUIRE(map.find("d") == map.end());
+
+  map["d"] = 4;
+  REQUIRE_FALSE(map.insert(std::make_pair(std::string("b"), 20)).second);
+  REQUIRE(map.erase("a") == 1u);
+  std::string keys;
+  for (const auto& entry : map)
+    keys += entry.first;
+  REQUIRE(keys == "bcd");
+}
+
+}  // namespace base
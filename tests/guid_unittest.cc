@@ -4,6 +4,8 @@
 #include "catch2/catch.hpp"
 
 #include "base/guid.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
 
 namespace base {
 
@@ -20,6 +22,46 @@ TEST_CASE("Generating or validating a GUID", "[GUID]") {
 
     std::string invalid_guid = "8B6099ED-1517-4735-81F2-3FECEEE56CG8";
     REQUIRE_FALSE(IsValidGUID(invalid_guid));
+    REQUIRE_FALSE(IsValidGUID("8B6099ED-1517-4735-81F2-3FECEEE56C"));
+    REQUIRE_FALSE(IsValidGUID("8B6099ED+1517-4735-81F2-3FECEEE56CA8"));
+    REQUIRE(IsValidGUID("8b6099ed-1517-4735-81f2-3feceee56ca8"));
+  }
+}
+
+TEST_CASE("Guid value type", "[GUID]") {
+  SECTION("random v4 guids format like GenerateGUID") {
+    Guid guid = Guid::GenerateRandomV4();
+    REQUIRE(guid.version() == 4);
+    REQUIRE_FALSE(guid.is_nil());
+    std::string text = guid.ToString();
+    REQUIRE(text.size() == Guid::kStringLength);
+    REQUIRE(IsValidGUID(text));
+    REQUIRE((text[19] == '8' || text[19] == '9' || text[19] == 'A' ||
+             text[19] == 'B'));
+
+    Guid parsed;
+    REQUIRE(Guid::Parse(text, &parsed));
+    REQUIRE(parsed == guid);
+    REQUIRE_FALSE(Guid::Parse("not a guid", &parsed));
+    REQUIRE(parsed == guid);
+  }
+
+#if defined(OS_POSIX)
+  SECTION("formatting matches RandomDataToGUIDString") {
+    const uint64_t bytes[2] = {0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL};
+    REQUIRE(RandomDataToGUIDString(bytes) ==
+            "01234567-89AB-CDEF-FEDC-BA9876543210");
+  }
+#endif
+
+  SECTION("v7 guids are time ordered") {
+    Guid first = Guid::GenerateTimeOrderedV7();
+    PlatformThread::Sleep(TimeDelta::FromMilliseconds(2));
+    Guid second = Guid::GenerateTimeOrderedV7();
+    REQUIRE(first.version() == 7);
+    REQUIRE(second.version() == 7);
+    REQUIRE(first < second);
+    REQUIRE(IsValidGUID(second.ToString()));
   }
 }
 
@@ -0,0 +1,126 @@
+#include <sys/stat.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+namespace {
+
+std::string Contents(const FilePath& path) {
+  std::string contents;
+  REQUIRE(ReadFileToString(path, &contents));
+  return contents;
+}
+
+int CountFiles(const FilePath& directory) {
+  int count = 0;
+  FileEnumerator enumerator(directory, false, FileEnumerator::FILES);
+  while (!enumerator.Next().empty())
+    ++count;
+  return count;
+}
+
+}  // namespace
+
+TEST_CASE("ImportantFileWriter", "[ImportantFileWriter]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("state");
+
+  SECTION("writes one file atomically") {
+    REQUIRE(ImportantFileWriter::WriteFileAtomically(path, "first"));
+    REQUIRE(Contents(path) == "first");
+    REQUIRE(ImportantFileWriter::WriteFileAtomically(path, ""));
+    REQUIRE(Contents(path) == "");
+    REQUIRE(CountFiles(temp_dir.path()) == 1);
+
+    REQUIRE(!ImportantFileWriter::WriteFileAtomically(
+        temp_dir.path().AppendASCII("missing").AppendASCII("state"), "x"));
+
+    // Replaced files keep their permissions; new ones get the umask's.
+    REQUIRE(SetPosixFilePermissions(path, 0640));
+    REQUIRE(ImportantFileWriter::WriteFileAtomically(path, "private"));
+    int mode = 0;
+    REQUIRE(GetPosixFilePermissions(path, &mode));
+    REQUIRE(mode == 0640);
+    mode_t mask = umask(022);
+    umask(mask);
+    FilePath new_path = temp_dir.path().AppendASCII("new");
+    REQUIRE(ImportantFileWriter::WriteFileAtomically(new_path, "new"));
+    REQUIRE(GetPosixFilePermissions(new_path, &mode));
+    REQUIRE(mode == static_cast<int>(0666 & ~mask));
+
+    // The temporary file's name does not grow with the target's.
+    FilePath long_path = temp_dir.path().AppendASCII(std::string(255, 'l'));
+    REQUIRE(ImportantFileWriter::WriteFileAtomically(long_path, "long"));
+    REQUIRE(Contents(long_path) == "long");
+  }
+
+  SECTION("batches scheduled writes") {
+    std::atomic<int> succeeded(0);
+    std::atomic<int> failed(0);
+    ImportantFileWriter::WriteCallback callback = [&](bool success) {
+      ++(success ? succeeded : failed);
+    };
+
+    ImportantFileWriter::Options options;
+    options.commit_interval = TimeDelta::FromSeconds(60);
+    options.max_batch_size = 16;
+    ImportantFileWriter writer(options);
+    for (int i = 0; i < 100; ++i) {
+      writer.ScheduleWrite(temp_dir.path().AppendASCII(IntToString(i % 40)),
+                           "contents " + IntToString(i), callback);
+    }
+    writer.ScheduleWrite(
+        temp_dir.path().AppendASCII("missing").AppendASCII("state"), "x",
+        callback);
+    writer.CommitPendingWrites();
+
+    REQUIRE(succeeded == 100);
+    REQUIRE(failed == 1);
+    REQUIRE(CountFiles(temp_dir.path()) == 40);
+    for (int i = 60; i < 100; ++i) {
+      REQUIRE(Contents(temp_dir.path().AppendASCII(IntToString(i % 40))) ==
+              "contents " + IntToString(i));
+    }
+  }
+
+  SECTION("commits pending writes on destruction") {
+    for (bool sync_file_system : {false, true}) {
+      ImportantFileWriter::Options options;
+      options.commit_interval = TimeDelta::FromSeconds(60);
+      options.sync_file_system = sync_file_system;
+      {
+        ImportantFileWriter writer(options);
+        writer.ScheduleWrite(path, "pending", nullptr);
+      }
+      REQUIRE(Contents(path) == "pending");
+      DeleteFile(path, false);
+    }
+  }
+
+  SECTION("commits after the interval") {
+    ImportantFileWriter::Options options;
+    options.commit_interval = TimeDelta::FromMilliseconds(1);
+    ImportantFileWriter writer(options);
+    std::atomic<bool> done(false);
+    writer.ScheduleWrite(path, "soon", [&](bool success) { done = success; });
+    while (!done)
+      PlatformThread::Sleep(TimeDelta::FromMilliseconds(1));
+    REQUIRE(Contents(path) == "soon");
+  }
+}
+
+}  // namespace base
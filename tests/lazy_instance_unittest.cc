@@ -0,0 +1,76 @@
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/atomicops.h"
+#include "base/lazy_instance.h"
+#include "base/memory/singleton.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+
+namespace base {
+
+namespace {
+
+subtle::Atomic32 g_constructions = 0;
+
+// Slow to construct, so that racing threads find it being created.
+class SlowObject {
+ public:
+  SlowObject() {
+    subtle::NoBarrier_AtomicIncrement(&g_constructions, 1);
+    PlatformThread::Sleep(TimeDelta::FromMilliseconds(20));
+    value_ = 42;
+  }
+
+  static SlowObject* GetInstance() {
+    return Singleton<SlowObject, LeakySingletonTraits<SlowObject>>::get();
+  }
+
+  int value() const { return value_; }
+
+ private:
+  int value_;
+};
+
+LazyInstance<SlowObject>::Leaky g_lazy_object = LAZY_INSTANCE_INITIALIZER;
+
+class Accessor : public PlatformThread::Delegate {
+ public:
+  Accessor() : lazy_(nullptr), singleton_(nullptr), value_sum_(0) {}
+
+  void ThreadMain() override {
+    lazy_ = g_lazy_object.Pointer();
+    singleton_ = SlowObject::GetInstance();
+    for (int i = 0; i < 10000; ++i) {
+      value_sum_ += g_lazy_object.Get().value();
+      value_sum_ += SlowObject::GetInstance()->value();
+    }
+  }
+
+  SlowObject* lazy_;
+  SlowObject* singleton_;
+  int value_sum_;
+};
+
+}  // namespace
+
+TEST_CASE("LazyInstance and Singleton under contention", "[LazyInstance]") {
+  const int kThreads = 64;
+  std::vector<Accessor> accessors(kThreads);
+  std::vector<PlatformThreadHandle> handles(kThreads);
+  for (int i = 0; i < kThreads; ++i)
+    REQUIRE(PlatformThread::Create(0, &accessors[i], &handles[i]));
+  for (int i = 0; i < kThreads; ++i)
+    PlatformThread::Join(handles[i]);
+
+  REQUIRE(subtle::NoBarrier_Load(&g_constructions) == 2);
+  for (const Accessor& accessor : accessors) {
+    REQUIRE(accessor.lazy_ == g_lazy_object.Pointer());
+    REQUIRE(accessor.singleton_ == SlowObject::GetInstance());
+    REQUIRE(accessor.value_sum_ == 2 * 10000 * 42);
+  }
+  REQUIRE(g_lazy_object.Pointer() != SlowObject::GetInstance());
+}
+
+}  // namespace base
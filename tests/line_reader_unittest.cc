@@ -0,0 +1,162 @@
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/line_reader.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/files/scoped_temp_dir.h"
+
+namespace base {
+
+namespace {
+
+std::vector<std::string> ReadAllLines(LineReader* reader) {
+  std::vector<std::string> lines;
+  StringPiece line;
+  bool continued = false;
+  while (reader->ReadLine(&line)) {
+    if (continued)
+      lines.back().append(line.data(), line.size());
+    else
+      lines.push_back(line.as_string());
+    continued = reader->partial();
+  }
+  REQUIRE(!reader->error());
+  return lines;
+}
+
+std::vector<std::string> ReadFileLines(const FilePath& path,
+                                       const LineReader::Options& options) {
+  File file(path, File::FLAG_OPEN | File::FLAG_READ);
+  REQUIRE(file.IsValid());
+  LineReader reader(&file, options);
+  return ReadAllLines(&reader);
+}
+
+std::vector<std::string> ReadMappedLines(const FilePath& path) {
+  MemoryMappedFile mapped_file;
+  REQUIRE(mapped_file.Initialize(path));
+  LineReader reader(&mapped_file);
+  return ReadAllLines(&reader);
+}
+
+}  // namespace
+
+TEST_CASE("LineReader", "[LineReader]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("lines");
+
+  SECTION("splits lines") {
+    std::string contents = "one\r\ntwo\n\n\r\nthree\rstill three\nlast";
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    std::vector<std::string> expected = {"one", "two", "", "",
+                                         "three\rstill three", "last"};
+    REQUIRE(ReadMappedLines(path) == expected);
+    REQUIRE(ReadFileLines(path, LineReader::Options()) == expected);
+
+    REQUIRE(WriteFile(path, "only\n", 5) == 5);
+    REQUIRE(ReadFileLines(path, LineReader::Options()) ==
+            std::vector<std::string>{"only"});
+
+    REQUIRE(WriteFile(path, "", 0) == 0);
+    REQUIRE(ReadFileLines(path, LineReader::Options()).empty());
+  }
+
+  SECTION("reads lines across buffers") {
+    std::vector<std::string> expected;
+    std::string contents;
+    for (int i = 0; i < 2000; ++i) {
+      expected.push_back(std::string(i * 7 % 97, 'a' + i % 26));
+      contents += expected.back() + (i % 3 ? "\n" : "\r\n");
+    }
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    REQUIRE(ReadMappedLines(path) == expected);
+
+    for (size_t buffer_size : {1u, 7u, 64u, 4096u}) {
+      for (bool read_ahead : {false, true}) {
+        LineReader::Options options;
+        options.buffer_size = buffer_size;
+        options.read_ahead = read_ahead;
+        REQUIRE(ReadFileLines(path, options) == expected);
+      }
+    }
+  }
+
+  SECTION("returns long lines in pieces") {
+    std::string contents = "0123456789\r\n01234567890123456789x\nabc\r\n";
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    for (bool read_ahead : {false, true}) {
+      LineReader::Options options;
+      options.buffer_size = 3;
+      options.max_line_length = 10;
+      options.read_ahead = read_ahead;
+      File file(path, File::FLAG_OPEN | File::FLAG_READ);
+      LineReader reader(&file, options);
+      StringPiece line;
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "0123456789");
+      REQUIRE(!reader.partial());
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "0123456789");
+      REQUIRE(reader.partial());
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "0123456789");
+      REQUIRE(reader.partial());
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "x");
+      REQUIRE(!reader.partial());
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "abc");
+      REQUIRE(!reader.ReadLine(&line));
+      REQUIRE(!reader.error());
+    }
+  }
+
+  SECTION("returns a long last line in pieces") {
+    std::string contents = "abc\n0123456789x";
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    for (size_t buffer_size : {3u, 64u}) {
+      LineReader::Options options;
+      options.buffer_size = buffer_size;
+      options.max_line_length = 10;
+      File file(path, File::FLAG_OPEN | File::FLAG_READ);
+      LineReader reader(&file, options);
+      StringPiece line;
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "abc");
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "0123456789");
+      REQUIRE(reader.partial());
+      REQUIRE(reader.ReadLine(&line));
+      REQUIRE(line == "x");
+      REQUIRE(!reader.partial());
+      REQUIRE(!reader.ReadLine(&line));
+      REQUIRE(!reader.error());
+    }
+  }
+
+  SECTION("stops reading ahead when destroyed early") {
+    std::string contents(1 << 20, 'x');
+    REQUIRE(WriteFile(path, contents.data(), contents.size()) ==
+            static_cast<int>(contents.size()));
+    LineReader::Options options;
+    options.buffer_size = 16;
+    options.read_ahead = true;
+    File file(path, File::FLAG_OPEN | File::FLAG_READ);
+    LineReader reader(&file, options);
+    StringPiece line;
+    REQUIRE(reader.ReadLine(&line));
+    REQUIRE(reader.partial());
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,114 @@
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/ref_counted_memory.h"
+#include "base/pickle.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "base/trace_event/process_memory_dump.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+class FakeProvider : public MemoryDumpProvider {
+ public:
+  FakeProvider() : calls(0) {}
+
+  bool OnMemoryDump(ProcessMemoryDump* pmd) override {
+    ++calls;
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump("fake");
+    dump->AddScalar(MemoryAllocatorDump::kNameSize,
+                    MemoryAllocatorDump::kUnitsBytes, 1234);
+    return true;
+  }
+
+  int calls;
+};
+
+uint64_t GetScalar(const ProcessMemoryDump& pmd,
+                   const char* dump_name,
+                   const char* scalar_name) {
+  MemoryAllocatorDump* dump = pmd.GetAllocatorDump(dump_name);
+  REQUIRE(dump);
+  uint64_t value = 0;
+  REQUIRE(dump->GetScalar(scalar_name, &value));
+  return value;
+}
+
+}  // namespace
+
+TEST_CASE("MemoryDumpManager", "[MemoryDumpManager]") {
+  MemoryDumpManager* manager = MemoryDumpManager::GetInstance();
+
+  SECTION("registered providers are called until unregistered") {
+    FakeProvider provider;
+    manager->RegisterDumpProvider(&provider, "fake");
+    {
+      ProcessMemoryDump pmd;
+      REQUIRE(manager->CreateProcessDump(&pmd));
+      REQUIRE(provider.calls == 1);
+      REQUIRE(GetScalar(pmd, "fake", MemoryAllocatorDump::kNameSize) == 1234);
+      REQUIRE(pmd.ToString().find("fake: size=1234 bytes\n") !=
+              std::string::npos);
+    }
+    manager->UnregisterDumpProvider(&provider);
+    ProcessMemoryDump pmd;
+    REQUIRE(manager->CreateProcessDump(&pmd));
+    REQUIRE(provider.calls == 1);
+    REQUIRE(!pmd.GetAllocatorDump("fake"));
+  }
+
+  SECTION("Pickle buffers are accounted") {
+    size_t count_before;
+    size_t bytes_before;
+    Pickle::GetAllocationStats(&count_before, &bytes_before);
+    {
+      Pickle pickle;
+      for (int i = 0; i < 1000; ++i)
+        pickle.WriteInt(i);
+      Pickle copy(pickle);
+      Pickle custom_header(64);
+      custom_header = pickle;
+
+      ProcessMemoryDump pmd;
+      REQUIRE(manager->CreateProcessDump(&pmd));
+      REQUIRE(GetScalar(pmd, "pickle", MemoryAllocatorDump::kNameObjectCount) ==
+              count_before + 3);
+      REQUIRE(GetScalar(pmd, "pickle", MemoryAllocatorDump::kNameSize) ==
+              bytes_before + pickle.GetTotalAllocatedSize() +
+                  copy.GetTotalAllocatedSize() +
+                  custom_header.GetTotalAllocatedSize());
+
+      // Read-only pickles do not own their buffer.
+      Pickle read_only(static_cast<const char*>(pickle.data()),
+                       static_cast<int>(pickle.size()));
+      size_t count;
+      size_t bytes;
+      Pickle::GetAllocationStats(&count, &bytes);
+      REQUIRE(count == count_before + 3);
+    }
+    size_t count_after;
+    size_t bytes_after;
+    Pickle::GetAllocationStats(&count_after, &bytes_after);
+    REQUIRE(count_after == count_before);
+    REQUIRE(bytes_after == bytes_before);
+  }
+
+  SECTION("RefCountedMemory objects are counted") {
+    size_t before = RefCountedMemory::GetLiveCount();
+    scoped_refptr<RefCountedMemory> bytes = new RefCountedBytes;
+    scoped_refptr<RefCountedMemory> string = new RefCountedString;
+    ProcessMemoryDump pmd;
+    REQUIRE(manager->CreateProcessDump(&pmd));
+    REQUIRE(GetScalar(pmd, "ref_counted_memory",
+                      MemoryAllocatorDump::kNameObjectCount) == before + 2);
+    bytes = nullptr;
+    REQUIRE(RefCountedMemory::GetLiveCount() == before + 1);
+  }
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -0,0 +1,136 @@
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "catch2/catch.hpp"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/files/scoped_temp_dir.h"
+
+namespace base {
+
+namespace {
+
+std::string MakeContents(size_t size) {
+  std::string contents(size, '\0');
+  for (size_t i = 0; i < size; ++i)
+    contents[i] = static_cast<char>(i * 13 + (i >> 10));
+  return contents;
+}
+
+void WriteContents(const FilePath& path, const std::string& contents) {
+  int size = static_cast<int>(contents.size());
+  REQUIRE(WriteFile(path, contents.data(), size) == size);
+}
+
+std::string MappedContents(const MemoryMappedFile& map) {
+  return std::string(reinterpret_cast<const char*>(map.data()), map.length());
+}
+
+}  // namespace
+
+TEST_CASE("MemoryMappedFile", "[MemoryMappedFile]") {
+  ScopedTempDir temp_dir;
+  REQUIRE(temp_dir.CreateUniqueTempDir());
+  FilePath path = temp_dir.path().AppendASCII("mapped");
+  const std::string contents = MakeContents(5 * 1024 * 1024 + 123);
+  WriteContents(path, contents);
+
+  SECTION("hints, populate and huge page alignment") {
+    MemoryMappedFile::Options options;
+    options.hint = MemoryMappedFile::ACCESS_SEQUENTIAL;
+    options.populate = true;
+    options.huge_page_aligned = true;
+    MemoryMappedFile map;
+    REQUIRE(map.Initialize(path, options));
+    REQUIRE(MappedContents(map) == contents);
+    REQUIRE(map.Advise(MemoryMappedFile::ACCESS_RANDOM, 12345, 100000));
+    REQUIRE(map.Advise(MemoryMappedFile::ACCESS_WILL_NEED, 0, map.length()));
+  }
+
+  SECTION("regions and background prefetch") {
+    MemoryMappedFile map;
+    MemoryMappedFile::Region region = {1000001, 3000000};
+    REQUIRE(map.Initialize(File(path, File::FLAG_OPEN | File::FLAG_READ),
+                           region));
+    map.PrefetchInBackground(7, 2999990);
+    map.PrefetchInBackground(0, 3000000);
+    REQUIRE(MappedContents(map) == contents.substr(1000001, 3000000));
+  }
+
+  SECTION("writes reach the file") {
+    MemoryMappedFile::Options options;
+    options.access = MemoryMappedFile::READ_WRITE;
+    {
+      MemoryMappedFile map;
+      REQUIRE(map.Initialize(path, options));
+      memcpy(map.writable_data() + 10, "written", 7);
+      REQUIRE(map.Flush(true));
+    }
+    std::string read;
+    REQUIRE(ReadFileToString(path, &read));
+    REQUIRE(read.compare(10, 7, "written") == 0);
+    REQUIRE(read.compare(17, std::string::npos, contents, 17,
+                         std::string::npos) == 0);
+  }
+
+  SECTION("copy-on-write leaves the file alone") {
+    MemoryMappedFile::Options options;
+    options.access = MemoryMappedFile::READ_WRITE_COPY;
+    MemoryMappedFile map;
+    REQUIRE(map.Initialize(path, options));
+    memset(map.writable_data(), 'x', 4096);
+    REQUIRE(map.data()[4095] == 'x');
+    REQUIRE(map.Flush(true));
+    std::string read;
+    REQUIRE(ReadFileToString(path, &read));
+    REQUIRE(read == contents);
+  }
+
+  SECTION("writable mappings grow and shrink the file") {
+    MemoryMappedFile::Options options;
+    options.access = MemoryMappedFile::READ_WRITE;
+    MemoryMappedFile map;
+    REQUIRE(map.Initialize(path, options));
+    map.PrefetchInBackground(0, map.length());
+    size_t grown = contents.size() + 3 * 1024 * 1024;
+    REQUIRE(map.Resize(grown));
+    REQUIRE(map.length() == grown);
+    REQUIRE(memcmp(map.data(), contents.data(), contents.size()) == 0);
+    map.writable_data()[grown - 1] = 'z';
+    REQUIRE(map.Flush(false));
+
+    int64_t file_size = 0;
+    REQUIRE(GetFileSize(path, &file_size));
+    REQUIRE(file_size == static_cast<int64_t>(grown));
+
+    REQUIRE(map.Resize(4096));
+    REQUIRE(GetFileSize(path, &file_size));
+    REQUIRE(file_size == 4096);
+    REQUIRE(MappedContents(map) == contents.substr(0, 4096));
+  }
+
+  SECTION("read-only mappings follow a growing file") {
+    MemoryMappedFile map;
+    REQUIRE(map.Initialize(path));
+    std::string more = MakeContents(10000);
+    REQUIRE(AppendToFile(path, more.data(), static_cast<int>(more.size())));
+    REQUIRE(map.Resize(contents.size() + more.size()));
+    REQUIRE(MappedContents(map) == contents + more);
+  }
+
+  SECTION("region mappings cannot be resized") {
+    MemoryMappedFile map;
+    MemoryMappedFile::Region region = {5000, 10000};
+    REQUIRE(map.Initialize(File(path, File::FLAG_OPEN | File::FLAG_READ),
+                           region));
+    REQUIRE(!map.Resize(20000));
+    REQUIRE(MappedContents(map) == contents.substr(5000, 10000));
+  }
+}
+
+}  // namespace base
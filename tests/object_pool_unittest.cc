@@ -0,0 +1,188 @@
+#include <stdint.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/object_pool.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+namespace {
+
+struct Payload {
+  explicit Payload(int v) : value(v) {}
+  int value;
+  char padding[40];
+};
+
+class Pooled
+    : public RefCountedThreadSafe<Pooled,
+                                  PooledRefCountedThreadSafeTraits<Pooled>> {
+ public:
+  explicit Pooled(int* destroyed) : destroyed_(destroyed) {}
+
+ private:
+  friend class RefCountedThreadSafe<Pooled,
+                                    PooledRefCountedThreadSafeTraits<Pooled>>;
+  ~Pooled() { ++*destroyed_; }
+
+  int* destroyed_;
+};
+
+// Frees on its own thread the objects another thread allocated.
+class Freer : public PlatformThread::Delegate {
+ public:
+  Freer(ObjectPool<Payload>* pool, std::vector<Payload*> objects)
+      : pool_(pool), objects_(std::move(objects)) {}
+
+  void ThreadMain() override {
+    for (Payload* object : objects_)
+      pool_->Delete(object);
+  }
+
+ private:
+  ObjectPool<Payload>* pool_;
+  std::vector<Payload*> objects_;
+};
+
+// Allocates on its own thread from the pools it is handed.
+class PoolUser : public PlatformThread::Delegate {
+ public:
+  PoolUser() : pool_(NULL), object_(NULL), ready_(false, false),
+               done_(false, false) {}
+
+  // Has the thread fill its cache for |pool| and returns an object it
+  // allocated from it. NULL ends the thread.
+  Payload* Use(ObjectPool<Payload>* pool) {
+    pool_ = pool;
+    ready_.Signal();
+    done_.Wait();
+    return object_;
+  }
+
+  void ThreadMain() override {
+    for (;;) {
+      ready_.Wait();
+      if (!pool_) {
+        done_.Signal();
+        return;
+      }
+      std::vector<Payload*> objects;
+      for (int i = 0; i < 100; ++i)
+        objects.push_back(pool_->New(i));
+      for (Payload* object : objects)
+        pool_->Delete(object);
+      object_ = pool_->New(7);
+      done_.Signal();
+    }
+  }
+
+ private:
+  ObjectPool<Payload>* pool_;
+  Payload* object_;
+  WaitableEvent ready_;
+  WaitableEvent done_;
+};
+
+}  // namespace
+
+TEST_CASE("ObjectPool", "[ObjectPool]") {
+  SECTION("slots are cache line aware and recycled") {
+    ObjectPool<Payload> pool;
+    std::vector<Payload*> objects;
+    std::set<Payload*> distinct;
+    for (int i = 0; i < 1000; ++i) {
+      objects.push_back(pool.New(i));
+      distinct.insert(objects.back());
+      // 44-byte objects get 64-byte slots, so none straddles a cache line.
+      REQUIRE(reinterpret_cast<uintptr_t>(objects.back()) % 64 == 0);
+    }
+    REQUIRE(distinct.size() == 1000u);
+    for (int i = 0; i < 1000; ++i)
+      REQUIRE(objects[i]->value == i);
+
+    const size_t slab_bytes = pool.GetStats().slab_bytes;
+    for (int round = 0; round < 10; ++round) {
+      for (Payload* object : objects)
+        pool.Delete(object);
+      for (Payload*& object : objects)
+        object = pool.New(round);
+    }
+    REQUIRE(pool.GetStats().slab_bytes == slab_bytes);
+    for (Payload* object : objects)
+      pool.Delete(object);
+  }
+
+  SECTION("pools can be created and destroyed without limit") {
+    // More pools than there are thread-local storage slots.
+    for (int i = 0; i < 1000; ++i) {
+      ObjectPool<Payload> pool;
+      Payload* object = pool.New(i);
+      REQUIRE(object->value == i);
+      pool.Delete(object);
+    }
+  }
+
+  SECTION("threads may outlive the pools they used") {
+    PoolUser user;
+    PlatformThreadHandle handle;
+    REQUIRE(PlatformThread::Create(0, &user, &handle));
+    std::unique_ptr<ObjectPool<Payload>> first(new ObjectPool<Payload>);
+    std::unique_ptr<ObjectPool<Payload>> second(new ObjectPool<Payload>);
+    first->Delete(user.Use(first.get()));
+    second->Delete(user.Use(second.get()));
+    first.reset();
+    second.reset();
+
+    // A new pool takes over an id, but not the cache the thread kept for it.
+    ObjectPool<Payload> pool;
+    Payload* object = user.Use(&pool);
+    REQUIRE(pool.GetStats().slab_bytes > 0);
+    REQUIRE(object->value == 7);
+    pool.Delete(object);
+    // The thread exits with a cache for a destroyed pool too.
+    user.Use(NULL);
+    PlatformThread::Join(handle);
+  }
+
+  SECTION("objects freed on other threads come back through the depot") {
+    ObjectPool<Payload>* pool = ObjectPool<Payload>::GetDefault();
+    for (int round = 0; round < 5; ++round) {
+      std::vector<Payload*> objects;
+      for (int i = 0; i < 2000; ++i)
+        objects.push_back(pool->New(i));
+      Freer freer(pool, std::move(objects));
+      PlatformThreadHandle handle;
+      REQUIRE(PlatformThread::Create(0, &freer, &handle));
+      PlatformThread::Join(handle);
+    }
+    ObjectPoolStats stats = pool->GetStats();
+    REQUIRE(stats.batches_to_depot + stats.overflow_batches > 0);
+    REQUIRE(stats.batches_from_depot > 0);
+    // Later rounds reuse the memory freed by earlier ones.
+    REQUIRE(stats.slab_bytes < 5 * 2000 * 64u);
+  }
+
+  SECTION("RefCountedThreadSafe can opt in through traits") {
+    int destroyed = 0;
+    {
+      scoped_refptr<Pooled> a = MakePooledRefCounted<Pooled>(&destroyed);
+      scoped_refptr<Pooled> b = a;
+      a = nullptr;
+      REQUIRE(destroyed == 0);
+    }
+    REQUIRE(destroyed == 1);
+
+    WaitableEvent event(false, false);
+    event.Signal();
+    REQUIRE(event.IsSignaled());
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,124 @@
+#include <stdint.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/pickle.h"
+#include "base/pickle_traits.h"
+
+namespace {
+
+struct Record {
+  int32_t id;
+  uint64_t timestamp;
+  bool active;
+  std::string name;
+  std::vector<int16_t> deltas;
+};
+
+}  // namespace
+
+namespace base {
+
+template <>
+struct PickleTraits<Record> {
+  template <typename S, typename Visitor>
+  static bool Fields(S& r, Visitor& v) {
+    return v(r.id) && v(r.timestamp) && v(r.active) && v(r.name) &&
+           v(r.deltas);
+  }
+};
+
+TEST_CASE("Compact varint encoding in Pickle", "[Pickle]") {
+  SECTION("round trip varints at the edges") {
+    const uint64_t kUnsigned[] = {0, 1, 127, 128, 16383, 16384,
+                                  std::numeric_limits<uint32_t>::max(),
+                                  std::numeric_limits<uint64_t>::max()};
+    const int64_t kSigned[] = {0, -1, 1, -64, 64,
+                               std::numeric_limits<int64_t>::min(),
+                               std::numeric_limits<int64_t>::max()};
+    Pickle pickle;
+    for (uint64_t v : kUnsigned)
+      pickle.WriteVarUInt64(v);
+    for (int64_t v : kSigned)
+      pickle.WriteVarInt64(v);
+    pickle.WriteVarInt32(std::numeric_limits<int32_t>::min());
+    pickle.WriteVarString("hello");
+    // Aligned writes still work after unaligned ones.
+    pickle.WriteInt(42);
+
+    PickleIterator iter(pickle);
+    for (uint64_t expected : kUnsigned) {
+      uint64_t v;
+      REQUIRE(iter.ReadVarUInt64(&v));
+      REQUIRE(v == expected);
+    }
+    for (int64_t expected : kSigned) {
+      int64_t v;
+      REQUIRE(iter.ReadVarInt64(&v));
+      REQUIRE(v == expected);
+    }
+    int32_t i32;
+    REQUIRE(iter.ReadVarInt32(&i32));
+    REQUIRE(i32 == std::numeric_limits<int32_t>::min());
+    std::string s;
+    REQUIRE(iter.ReadVarString(&s));
+    REQUIRE(s == "hello");
+    int i;
+    REQUIRE(iter.ReadInt(&i));
+    REQUIRE(i == 42);
+    uint32_t u32;
+    REQUIRE_FALSE(iter.ReadVarUInt32(&u32));
+  }
+
+  SECTION("small values take one byte") {
+    Pickle pickle;
+    pickle.WriteVarUInt32(5);
+    pickle.WriteVarInt32(-3);
+    REQUIRE(pickle.payload_size() == 2u);
+  }
+
+  SECTION("reject truncated and oversized varints") {
+    Pickle pickle;
+    pickle.WriteVarUInt64(std::numeric_limits<uint64_t>::max());
+    Pickle short_pickle;
+    short_pickle.WriteBytes(pickle.payload(), 4);
+    PickleIterator short_iter(short_pickle);
+    uint64_t v;
+    REQUIRE_FALSE(short_iter.ReadVarUInt64(&v));
+
+    PickleIterator iter(pickle);
+    uint32_t u32;
+    REQUIRE_FALSE(iter.ReadVarUInt32(&u32));
+  }
+
+  SECTION("PickleTraits generates struct serialization") {
+    Record in = {-7, 1600000000000ull, true, "record", {1, -2, 300}};
+    Pickle pickle;
+    PickleWrite(&pickle, in);
+
+    Pickle aligned;
+    aligned.WriteInt(in.id);
+    aligned.WriteUInt64(in.timestamp);
+    aligned.WriteBool(in.active);
+    aligned.WriteString(in.name);
+    aligned.WriteInt(static_cast<int>(in.deltas.size()));
+    for (int16_t d : in.deltas)
+      aligned.WriteInt(d);
+    REQUIRE(pickle.payload_size() < aligned.payload_size() / 2);
+
+    Record out;
+    PickleIterator iter(pickle);
+    REQUIRE(PickleRead(&iter, &out));
+    REQUIRE(out.id == in.id);
+    REQUIRE(out.timestamp == in.timestamp);
+    REQUIRE(out.active == in.active);
+    REQUIRE(out.name == in.name);
+    REQUIRE(out.deltas == in.deltas);
+  }
+}
+
+}  // namespace base
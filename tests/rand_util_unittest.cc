@@ -0,0 +1,113 @@
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/rand_util.h"
+
+namespace base {
+
+TEST_CASE("InsecureRandomGenerator", "[RandUtil]") {
+  SECTION("is deterministic for a seed") {
+    InsecureRandomGenerator a(42);
+    InsecureRandomGenerator b(42);
+    InsecureRandomGenerator c(43);
+    bool differs = false;
+    for (int i = 0; i < 100; ++i) {
+      uint64_t value = a.RandUint64();
+      REQUIRE(value == b.RandUint64());
+      differs |= value != c.RandUint64();
+    }
+    REQUIRE(differs);
+  }
+
+  SECTION("stays in range") {
+    InsecureRandomGenerator* generator =
+        InsecureRandomGenerator::ForCurrentThread();
+    REQUIRE(generator == InsecureRandomGenerator::ForCurrentThread());
+    bool seen_min = false;
+    bool seen_max = false;
+    for (int i = 0; i < 10000; ++i) {
+      int value = generator->RandInt(-3, 3);
+      REQUIRE(value >= -3);
+      REQUIRE(value <= 3);
+      seen_min |= value == -3;
+      seen_max |= value == 3;
+      REQUIRE(generator->RandGenerator(10) < 10u);
+      double fraction = generator->RandDouble();
+      REQUIRE(fraction >= 0.0);
+      REQUIRE(fraction < 1.0);
+    }
+    REQUIRE(seen_min);
+    REQUIRE(seen_max);
+    REQUIRE(generator->RandGenerator(1) == 0u);
+    REQUIRE(generator->RandInt(5, 5) == 5);
+  }
+}
+
+TEST_CASE("RandGenerator", "[RandUtil]") {
+  SECTION("covers small ranges") {
+    std::vector<int> counts(6);
+    for (int i = 0; i < 6000; ++i) {
+      uint64_t value = RandGenerator(6);
+      REQUIRE(value < 6u);
+      ++counts[value];
+    }
+    for (int count : counts)
+      REQUIRE(count > 0);
+  }
+
+  SECTION("handles the range bounds") {
+    REQUIRE(RandGenerator(1) == 0u);
+    REQUIRE(RandInt(7, 7) == 7);
+    const uint64_t kLargeRange = (UINT64_C(1) << 63) + 1;
+    for (int i = 0; i < 1000; ++i) {
+      REQUIRE(RandGenerator(kLargeRange) < kLargeRange);
+      int value = RandInt(INT_MIN, INT_MAX);
+      REQUIRE(value >= INT_MIN);
+    }
+  }
+}
+
+TEST_CASE("RandBytes", "[RandUtil]") {
+  // Requests up to 64 bytes come from a 512-byte per-thread buffer, larger
+  // ones straight from the kernel.
+  for (size_t size : {1u, 8u, 64u, 65u, 512u, 513u, 4096u}) {
+    SECTION("of " + std::to_string(size) + " bytes") {
+      std::set<std::string> outputs;
+      // Enough requests to refill the buffer several times.
+      for (int i = 0; i < 100; ++i) {
+        std::string bytes(size, '\0');
+        RandBytes(&bytes[0], size);
+        // Output never repeats; single bytes collide by chance.
+        if (size >= 8)
+          REQUIRE(outputs.insert(bytes).second);
+      }
+      if (size >= 8)
+        REQUIRE(outputs.size() == 100u);
+    }
+  }
+
+  SECTION("fills the whole output") {
+    // A zero byte at a given position has probability 1/256 per call, so
+    // after 64 calls every position should have been nonzero at least once.
+    const size_t kSize = 600;
+    std::vector<char> seen(kSize);
+    for (int i = 0; i < 64; ++i) {
+      char bytes[kSize];
+      memset(bytes, 0, sizeof(bytes));
+      RandBytes(bytes, sizeof(bytes));
+      for (size_t j = 0; j < kSize; ++j)
+        seen[j] |= bytes[j];
+    }
+    for (char byte : seen)
+      REQUIRE(byte != 0);
+  }
+}
+
+}  // namespace base
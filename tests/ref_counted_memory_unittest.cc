@@ -0,0 +1,92 @@
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/ref_counted_memory.h"
+
+namespace base {
+
+namespace {
+
+scoped_refptr<RefCountedMemory> MakeString(const std::string& value) {
+  std::string copy = value;
+  return RefCountedString::TakeString(&copy);
+}
+
+std::string ToString(const RefCountedMemory* memory) {
+  return std::string(memory->front_as<char>(), memory->size());
+}
+
+}  // namespace
+
+TEST_CASE("RefCountedMemoryChain", "[RefCountedMemory]") {
+  scoped_refptr<RefCountedMemory> header = MakeString("HEADER:");
+  scoped_refptr<RefCountedMemory> body = MakeString("body-bytes");
+  static const char kTrailer[] = "|end";
+  scoped_refptr<RefCountedMemory> trailer =
+      new RefCountedStaticMemory(kTrailer, sizeof(kTrailer) - 1);
+
+  scoped_refptr<RefCountedMemoryChain> chain = new RefCountedMemoryChain;
+  chain->Append(header);
+  chain->Append(body, 5, 5);
+  chain->Append(trailer);
+  chain->Append(body, 0, 0);
+
+  SECTION("slices reference the original memory") {
+    REQUIRE(chain->size() == 16u);
+    REQUIRE(chain->slice_count() == 3u);
+    REQUIRE(chain->slice_data(0) == header->front());
+    REQUIRE(chain->slice_data(1) == body->front() + 5);
+
+    std::vector<struct iovec> iovecs;
+    chain->GetIOVecs(&iovecs);
+    REQUIRE(iovecs.size() == 3u);
+    std::string gathered;
+    for (const struct iovec& iov : iovecs)
+      gathered.append(static_cast<const char*>(iov.iov_base), iov.iov_len);
+    REQUIRE(gathered == "HEADER:bytes|end");
+  }
+
+  SECTION("front() flattens lazily") {
+    REQUIRE(ToString(chain.get()) == "HEADER:bytes|end");
+    chain->Append(header, 0, 6);
+    REQUIRE(ToString(chain.get()) == "HEADER:bytes|endHEADER");
+
+    scoped_refptr<RefCountedMemoryChain> single = new RefCountedMemoryChain;
+    REQUIRE(single->front() == nullptr);
+    single->Append(body);
+    REQUIRE(single->front() == body->front());
+  }
+
+  SECTION("sub-slicing") {
+    scoped_refptr<RefCountedMemoryChain> middle = chain->Slice(3, 9);
+    REQUIRE(ToString(middle.get()) == "DER:bytes");
+    REQUIRE(middle->slice_count() == 2u);
+
+    scoped_refptr<RefCountedMemoryChain> inner = middle->Slice(5, 3);
+    REQUIRE(inner->slice_count() == 1u);
+    REQUIRE(inner->front() == body->front() + 6);
+
+    REQUIRE(chain->Slice(16, 0)->size() == 0u);
+    REQUIRE(ToString(chain->Slice(12, 4).get()) == "|end");
+
+    char buffer[6];
+    chain->CopyTo(5, sizeof(buffer), buffer);
+    REQUIRE(std::string(buffer, sizeof(buffer)) == "R:byte");
+  }
+
+  SECTION("appending a chain shares its slices") {
+    scoped_refptr<RefCountedMemoryChain> outer = new RefCountedMemoryChain;
+    outer->AppendChain(*chain);
+    outer->AppendChain(*chain);
+    REQUIRE(outer->slice_count() == 6u);
+    REQUIRE(outer->slice_data(3) == header->front());
+    REQUIRE(ToString(outer.get()) == "HEADER:bytes|endHEADER:bytes|end");
+    REQUIRE(outer->Equals(outer->Slice(0, outer->size())));
+  }
+}
+
+}  // namespace base
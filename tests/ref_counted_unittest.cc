@@ -0,0 +1,151 @@
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/ref_counted.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+namespace {
+
+class Biased : public BiasedRefCounted<Biased> {
+ public:
+  explicit Biased(int* destroyed) : destroyed_(destroyed) {}
+
+ private:
+  friend class BiasedRefCounted<Biased>;
+  ~Biased() { ++*destroyed_; }
+
+  int* destroyed_;
+};
+
+// Counts AddRef() calls, to check that moves leave the count alone.
+class Counted {
+ public:
+  Counted() : add_refs(0), refs(0) {}
+
+  void AddRef() const {
+    ++add_refs;
+    ++refs;
+  }
+  void Release() const { --refs; }
+
+  mutable int add_refs;
+  mutable int refs;
+};
+
+// Takes and drops references on its own thread. Every reference in
+// |objects_| was taken by the thread that created the objects.
+class Releaser : public PlatformThread::Delegate {
+ public:
+  explicit Releaser(std::vector<scoped_refptr<Biased>> objects)
+      : objects_(std::move(objects)) {}
+
+  void ThreadMain() override {
+    for (const scoped_refptr<Biased>& object : objects_) {
+      scoped_refptr<Biased> copy = object;
+      copy = nullptr;
+    }
+    objects_.clear();
+  }
+
+ private:
+  std::vector<scoped_refptr<Biased>> objects_;
+};
+
+// Creates objects on its own thread and exits while |out_| still holds
+// references to them.
+class Creator : public PlatformThread::Delegate {
+ public:
+  Creator(int* destroyed, std::vector<scoped_refptr<Biased>>* out)
+      : destroyed_(destroyed), out_(out) {}
+
+  void ThreadMain() override {
+    for (int i = 0; i < 100; ++i) {
+      scoped_refptr<Biased> object = new Biased(destroyed_);
+      out_->push_back(object);
+    }
+  }
+
+ private:
+  int* destroyed_;
+  std::vector<scoped_refptr<Biased>>* out_;
+};
+
+void RunOnThread(PlatformThread::Delegate* delegate) {
+  PlatformThreadHandle handle;
+  REQUIRE(PlatformThread::Create(0, delegate, &handle));
+  PlatformThread::Join(handle);
+}
+
+}  // namespace
+
+TEST_CASE("BiasedRefCounted", "[RefCounted]") {
+  int destroyed = 0;
+
+  SECTION("owner thread references") {
+    scoped_refptr<Biased> a = new Biased(&destroyed);
+    REQUIRE(a->HasOneRef());
+    scoped_refptr<Biased> b = a;
+    REQUIRE(!a->HasOneRef());
+    b = nullptr;
+    REQUIRE(a->HasOneRef());
+    a = nullptr;
+    REQUIRE(destroyed == 1);
+  }
+
+  SECTION("releases of owner references on other threads are queued") {
+    std::vector<scoped_refptr<Biased>> objects;
+    for (int i = 0; i < 100; ++i)
+      objects.push_back(new Biased(&destroyed));
+    Releaser releaser(std::move(objects));
+    RunOnThread(&releaser);
+    // The releases are pending until this thread merges them.
+    REQUIRE(destroyed == 0);
+    Biased::ProcessPendingReleases();
+    REQUIRE(destroyed == 100);
+  }
+
+  SECTION("shared references outlive the owner's") {
+    scoped_refptr<Biased> object = new Biased(&destroyed);
+    std::vector<scoped_refptr<Biased>> objects(10, object);
+    object = nullptr;
+    Releaser releaser(std::move(objects));
+    RunOnThread(&releaser);
+    Biased::ProcessPendingReleases();
+    REQUIRE(destroyed == 1);
+  }
+
+  SECTION("references outliving the owner thread") {
+    std::vector<scoped_refptr<Biased>> objects;
+    Creator creator(&destroyed, &objects);
+    RunOnThread(&creator);
+    REQUIRE(objects.size() == 100u);
+    REQUIRE(destroyed == 0);
+    scoped_refptr<Biased> kept = objects[0];
+    objects.clear();
+    REQUIRE(destroyed == 99);
+    kept = nullptr;
+    REQUIRE(destroyed == 100);
+  }
+}
+
+TEST_CASE("scoped_refptr moves", "[RefCounted]") {
+  Counted counted;
+  {
+    std::vector<scoped_refptr<Counted>> refs;
+    refs.push_back(scoped_refptr<Counted>(&counted));
+    // Growing the vector moves its elements.
+    for (int i = 0; i < 100; ++i)
+      refs.push_back(std::move(refs.back()));
+    scoped_refptr<Counted> moved;
+    moved = std::move(refs.back());
+    REQUIRE(counted.add_refs == 1);
+    REQUIRE(counted.refs == 1);
+  }
+  REQUIRE(counted.refs == 0);
+}
+
+}  // namespace base
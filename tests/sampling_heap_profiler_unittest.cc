@@ -0,0 +1,147 @@
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/compiler_specific.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/sampling_heap_profiler/operator_new_hooks.h"
+#include "base/sampling_heap_profiler/sampling_heap_profiler.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+
+// This file is built into an executable of its own, since the hooks replace
+// operator new and delete for the whole program.
+SAMPLING_HEAP_PROFILER_DEFINE_OPERATOR_NEW_HOOKS()
+
+namespace base {
+
+namespace {
+
+const size_t kBlockSize = 64;
+
+// One call site for every block, so that the blocks share a stack.
+NOINLINE void* AllocateBlock() {
+  void* block = malloc(kBlockSize);
+  SamplingHeapProfiler::RecordAlloc(block, kBlockSize);
+  return block;
+}
+
+NOINLINE char* NewBlock() {
+  return new char[kBlockSize];
+}
+
+void FreeBlock(void* block) {
+  SamplingHeapProfiler::RecordFree(block);
+  free(block);
+}
+
+// Returns the call site whose samples are all of |block_size| bytes and that
+// has the most of them, or NULL.
+const SamplingHeapProfiler::CallSite* FindBlockSite(
+    const std::vector<SamplingHeapProfiler::CallSite>& profile) {
+  const SamplingHeapProfiler::CallSite* best = NULL;
+  for (const SamplingHeapProfiler::CallSite& site : profile) {
+    if (site.sampled_bytes != site.sampled_count * kBlockSize)
+      continue;
+    if (!best || site.sampled_count > best->sampled_count)
+      best = &site;
+  }
+  return best;
+}
+
+}  // namespace
+
+TEST_CASE("SamplingHeapProfiler", "[SamplingHeapProfiler]") {
+  SamplingHeapProfiler* profiler = SamplingHeapProfiler::GetInstance();
+  size_t default_interval = profiler->sampling_interval();
+  REQUIRE(default_interval == SamplingHeapProfiler::kDefaultSamplingInterval);
+
+  SECTION("an interval of 1 samples everything") {
+    profiler->SetSamplingInterval(1);
+    profiler->Start();
+    std::vector<void*> blocks;
+    for (int i = 0; i < 10; ++i)
+      blocks.push_back(AllocateBlock());
+    profiler->Stop();
+
+    std::vector<SamplingHeapProfiler::CallSite> profile =
+        profiler->GetProfile();
+    const SamplingHeapProfiler::CallSite* site = FindBlockSite(profile);
+    REQUIRE(site);
+    REQUIRE(site->sampled_count == 10u);
+    REQUIRE(site->estimated_count == 10u);
+    REQUIRE(site->estimated_bytes == 10 * kBlockSize);
+    REQUIRE(!site->frames.empty());
+
+    // Frees are tracked after Stop().
+    for (void* block : blocks)
+      FreeBlock(block);
+    profile = profiler->GetProfile();
+    site = FindBlockSite(profile);
+    REQUIRE((!site || site->sampled_count < 10u));
+  }
+
+  SECTION("sampled sizes scale up to an unbiased estimate") {
+    const size_t kBlocks = 100000;
+    profiler->SetSamplingInterval(4096);
+    profiler->Start();
+    std::vector<std::unique_ptr<char[]>> blocks(kBlocks);
+    for (size_t i = 0; i < kBlocks; ++i)
+      blocks[i].reset(NewBlock());
+    profiler->Stop();
+
+    std::vector<SamplingHeapProfiler::CallSite> profile =
+        profiler->GetProfile();
+    const SamplingHeapProfiler::CallSite* site = FindBlockSite(profile);
+    REQUIRE(site);
+    // About 1500 samples, so the estimate is within a few percent.
+    REQUIRE(site->sampled_count > 1000u);
+    REQUIRE(site->sampled_count < 2200u);
+    REQUIRE(site->estimated_bytes > kBlocks * kBlockSize * 8 / 10);
+    REQUIRE(site->estimated_bytes < kBlocks * kBlockSize * 12 / 10);
+
+    trace_event::ProcessMemoryDump pmd;
+    trace_event::MemoryDumpManager::GetInstance()->CreateProcessDump(&pmd);
+    trace_event::MemoryAllocatorDump* dump =
+        pmd.GetAllocatorDump("sampling_heap_profiler");
+    REQUIRE(dump);
+    uint64_t bytes = 0;
+    REQUIRE(dump->GetScalar(trace_event::MemoryAllocatorDump::kNameSize,
+                            &bytes));
+    REQUIRE(bytes >= site->estimated_bytes);
+
+    blocks.clear();
+    profile = profiler->GetProfile();
+    site = FindBlockSite(profile);
+    REQUIRE((!site || site->sampled_count < 100u));
+  }
+
+  SECTION("profiles dump in the gperftools format") {
+    profiler->SetSamplingInterval(1);
+    profiler->Start();
+    void* block = AllocateBlock();
+    profiler->Stop();
+
+    ScopedTempDir temp_dir;
+    REQUIRE(temp_dir.CreateUniqueTempDir());
+    FilePath path = temp_dir.path().AppendASCII("heap.prof");
+    REQUIRE(profiler->DumpProfile(path));
+    FreeBlock(block);
+
+    std::string contents;
+    REQUIRE(ReadFileToString(path, &contents));
+    REQUIRE(contents.compare(0, 14, "heap profile: ") == 0);
+    REQUIRE(contents.find("] @ heap_v2/1\n") != std::string::npos);
+    REQUIRE(contents.find(":       64 [") != std::string::npos);
+    REQUIRE(contents.find("\nMAPPED_LIBRARIES:\n") != std::string::npos);
+  }
+
+  profiler->SetSamplingInterval(default_interval);
+}
+
+}  // namespace base
@@ -0,0 +1,81 @@
+#include <string.h>
+
+#include <string>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/shared_memory.h"
+#include "base/pickle.h"
+
+namespace base {
+
+TEST_CASE("Anonymous shared memory", "[SharedMemory]") {
+  const size_t kSize = 64 * 1024;
+
+  SECTION("mappings of one object see each other's writes") {
+    SharedMemory writer;
+    REQUIRE(writer.CreateAndMapAnonymous(kSize));
+    REQUIRE(writer.mapped_size() == kSize);
+
+    SharedMemoryHandle handle;
+    REQUIRE(writer.ShareToProcess(GetCurrentProcessHandle(), &handle));
+    size_t size = 0;
+    REQUIRE(SharedMemory::GetSizeFromSharedMemoryHandle(handle, &size));
+    REQUIRE(size == kSize);
+
+    SharedMemory reader(handle, true);
+    REQUIRE(reader.Map(kSize));
+    memset(writer.memory(), 0x5a, kSize);
+    REQUIRE(static_cast<const char*>(reader.memory())[kSize - 1] == 0x5a);
+  }
+
+  SECTION("read-only handles cannot be mapped writable") {
+    SharedMemoryCreateOptions options;
+    options.size = kSize;
+    options.share_read_only = true;
+    SharedMemory memory;
+    REQUIRE(memory.Create(options));
+
+    SharedMemoryHandle handle;
+    REQUIRE(memory.ShareReadOnlyToProcess(GetCurrentProcessHandle(), &handle));
+    SharedMemory writable(handle, false);
+    REQUIRE_FALSE(writable.Map(kSize));
+  }
+
+  SECTION("flags and huge pages fall back gracefully") {
+    SharedMemoryCreateOptions options;
+    options.size = kSize;
+    options.huge_pages = true;
+    SharedMemory memory;
+    REQUIRE(memory.Create(options));
+    REQUIRE(memory.MapAtWithFlags(
+        0, kSize,
+        SharedMemory::MAP_FLAG_PREFAULT | SharedMemory::MAP_FLAG_HUGE_PAGES));
+    REQUIRE(memory.mapped_size() >= kSize);
+    static_cast<char*>(memory.memory())[kSize - 1] = 1;
+  }
+
+  SECTION("a Pickle can be read in place from a mapping") {
+    SharedMemory memory;
+    REQUIRE(memory.CreateAndMapAnonymous(kSize));
+    Pickle pickle;
+    pickle.WriteString("in shared memory");
+    pickle.WriteInt(42);
+    memcpy(memory.memory(), pickle.data(), pickle.size());
+
+    const char* start = static_cast<const char*>(memory.memory());
+    const char* end =
+        Pickle::FindNext(sizeof(Pickle::Header), start, start + kSize);
+    REQUIRE(end == start + pickle.size());
+    Pickle mapped(start, static_cast<int>(end - start));
+    PickleIterator iter(mapped);
+    std::string s;
+    int i;
+    REQUIRE(iter.ReadString(&s));
+    REQUIRE(iter.ReadInt(&i));
+    REQUIRE(s == "in shared memory");
+    REQUIRE(i == 42);
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,151 @@
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/memory/shared_memory.h"
+#include "base/memory/shared_ring_buffer.h"
+#include "base/pickle.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+namespace {
+
+const size_t kCapacity = 4096;
+const int kMessagesPerWriter = 20000;
+
+class Writer : public PlatformThread::Delegate {
+ public:
+  Writer(void* memory, size_t size, int id) : id_(id), succeeded_(false) {
+    attached_ = ring_.Attach(memory, size);
+  }
+
+  bool succeeded() const { return succeeded_; }
+
+  void ThreadMain() override {
+    if (!attached_)
+      return;
+    for (int i = 0; i < kMessagesPerWriter; ++i) {
+      Pickle pickle;
+      pickle.WriteInt(id_);
+      pickle.WriteInt(i);
+      // Vary the size so that records wrap at different offsets.
+      pickle.WriteString(std::string(i % 97, 'x'));
+      if (!ring_.Write(pickle))
+        return;
+    }
+    succeeded_ = true;
+  }
+
+ private:
+  SharedRingBuffer ring_;
+  int id_;
+  bool attached_;
+  bool succeeded_;
+};
+
+void RunWriters(SharedRingBuffer::Mode mode, int writer_count) {
+  SharedMemory memory;
+  const size_t size = SharedRingBuffer::RequiredMemorySize(kCapacity);
+  REQUIRE(memory.CreateAndMapAnonymous(size));
+  REQUIRE(SharedRingBuffer::Initialize(memory.memory(), size, mode));
+
+  SharedRingBuffer reader;
+  REQUIRE(reader.Attach(memory.memory(), size));
+
+  std::vector<Writer*> writers;
+  std::vector<PlatformThreadHandle> handles(writer_count);
+  for (int i = 0; i < writer_count; ++i) {
+    writers.push_back(new Writer(memory.memory(), size, i));
+    REQUIRE(PlatformThread::Create(0, writers[i], &handles[i]));
+  }
+
+  // Messages from any one writer arrive in order.
+  std::vector<int> next(writer_count, 0);
+  for (int n = 0; n < writer_count * kMessagesPerWriter; ++n) {
+    Pickle pickle;
+    REQUIRE(reader.Read(&pickle));
+    PickleIterator iter(pickle);
+    int id, i;
+    std::string padding;
+    REQUIRE(iter.ReadInt(&id));
+    REQUIRE(iter.ReadInt(&i));
+    REQUIRE(iter.ReadString(&padding));
+    REQUIRE(i == next[id]++);
+    REQUIRE(padding.size() == static_cast<size_t>(i % 97));
+  }
+
+  for (int i = 0; i < writer_count; ++i) {
+    PlatformThread::Join(handles[i]);
+    REQUIRE(writers[i]->succeeded());
+    delete writers[i];
+  }
+  Pickle pickle;
+  REQUIRE_FALSE(reader.TryRead(&pickle));
+}
+
+}  // namespace
+
+TEST_CASE("Shared memory ring buffer", "[SharedRingBuffer]") {
+  SECTION("single writer") {
+    RunWriters(SharedRingBuffer::SINGLE_WRITER, 1);
+  }
+
+  SECTION("multiple writers") {
+    RunWriters(SharedRingBuffer::MULTI_WRITER, 3);
+  }
+
+  SECTION("full rings, oversized messages and shutdown") {
+    SharedMemory memory;
+    const size_t size = SharedRingBuffer::RequiredMemorySize(kCapacity);
+    REQUIRE(memory.CreateAndMapAnonymous(size));
+    REQUIRE(SharedRingBuffer::Initialize(memory.memory(), size,
+                                         SharedRingBuffer::SINGLE_WRITER));
+    SharedRingBuffer ring;
+    REQUIRE(ring.Attach(memory.memory(), size));
+
+    Pickle big;
+    big.WriteString(std::string(ring.max_message_size(), 'x'));
+    REQUIRE_FALSE(ring.TryWrite(big));
+
+    Pickle small;
+    small.WriteInt(1);
+    int written = 0;
+    while (ring.TryWrite(small))
+      ++written;
+    REQUIRE(written > 0);
+
+    size_t message_size;
+    const char* data = ring.Peek(&message_size);
+    REQUIRE(data != nullptr);
+    Pickle in_place(data, static_cast<int>(message_size));
+    PickleIterator iter(in_place);
+    int value;
+    REQUIRE(iter.ReadInt(&value));
+    REQUIRE(value == 1);
+    ring.Pop();
+    REQUIRE(ring.TryWrite(small));
+
+    ring.Shutdown();
+    REQUIRE_FALSE(ring.Write(small));
+    Pickle out;
+    for (int i = 0; i < written; ++i)
+      REQUIRE(ring.Read(&out));
+    REQUIRE_FALSE(ring.Read(&out));
+  }
+
+  SECTION("attaching rejects garbage") {
+    SharedMemory memory;
+    const size_t size = SharedRingBuffer::RequiredMemorySize(kCapacity);
+    REQUIRE(memory.CreateAndMapAnonymous(size));
+    SharedRingBuffer ring;
+    REQUIRE_FALSE(ring.Attach(memory.memory(), size));
+    REQUIRE_FALSE(SharedRingBuffer::Initialize(memory.memory(), size + 8,
+                                               SharedRingBuffer::MULTI_WRITER));
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,190 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "catch2/catch.hpp"
+
+#include "base/command_line.h"
+#include "base/containers/small_vector.h"
+#include "base/observer_list.h"
+#include "base/strings/string_split.h"
+
+namespace base {
+
+namespace {
+
+int g_live_objects = 0;
+
+// Not trivially relocatable; counts live instances to catch leaks and double
+// destruction.
+class Tracked {
+ public:
+  explicit Tracked(int value = 0) : value_(value), self_(this) {
+    ++g_live_objects;
+  }
+  Tracked(const Tracked& other) : value_(other.value_), self_(this) {
+    ++g_live_objects;
+  }
+  Tracked(Tracked&& other) : value_(other.value_), self_(this) {
+    other.value_ = -1;
+    ++g_live_objects;
+  }
+  ~Tracked() {
+    REQUIRE(self_ == this);
+    --g_live_objects;
+  }
+  Tracked& operator=(const Tracked& other) {
+    value_ = other.value_;
+    return *this;
+  }
+  Tracked& operator=(Tracked&& other) {
+    value_ = other.value_;
+    other.value_ = -1;
+    return *this;
+  }
+
+  int value() const { return value_; }
+  bool operator==(const Tracked& other) const { return value_ == other.value_; }
+
+ private:
+  int value_;
+  const Tracked* self_;
+};
+
+class Observer {
+ public:
+  Observer() : calls(0) {}
+  void Notify() { ++calls; }
+  int calls;
+};
+
+}  // namespace
+
+TEST_CASE("SmallVector", "[SmallVector]") {
+  SECTION("inline storage then heap") {
+    SmallVector<int, 4> v;
+    REQUIRE(v.empty());
+    REQUIRE(v.capacity() == 4u);
+    for (int i = 0; i < 4; ++i)
+      v.push_back(i);
+    REQUIRE(v.using_inline_storage());
+    v.push_back(4);
+    REQUIRE(!v.using_inline_storage());
+    REQUIRE(v.capacity() >= 5u);
+    for (int i = 5; i < 100; ++i)
+      v.emplace_back(i);
+    REQUIRE(v.size() == 100u);
+    for (int i = 0; i < 100; ++i)
+      REQUIRE(v[i] == i);
+
+    v.resize(3);
+    v.shrink_to_fit();
+    REQUIRE(v.using_inline_storage());
+    REQUIRE(v == SmallVector<int, 4>({0, 1, 2}));
+  }
+
+  SECTION("moves steal heap buffers") {
+    SmallVector<int, 2> heap = {1, 2, 3, 4};
+    const int* data = heap.data();
+    SmallVector<int, 2> moved(std::move(heap));
+    REQUIRE(moved.data() == data);
+    REQUIRE(heap.empty());
+    REQUIRE(heap.using_inline_storage());
+
+    SmallVector<int, 2> small = {7};
+    moved = std::move(small);
+    REQUIRE(moved.size() == 1u);
+    REQUIRE(moved.using_inline_storage());
+    REQUIRE(moved[0] == 7);
+  }
+
+  SECTION("non-trivial elements are constructed and destroyed once") {
+    {
+      SmallVector<Tracked, 3> v;
+      for (int i = 0; i < 10; ++i)
+        v.emplace_back(i);
+      v.insert(v.begin() + 2, Tracked(100));
+      v.erase(v.begin(), v.begin() + 2);
+      REQUIRE(v.front().value() == 100);
+      REQUIRE(v.size() == 9u);
+
+      SmallVector<Tracked, 3> copy(v);
+      SmallVector<Tracked, 3> small(2, Tracked(5));
+      copy.swap(small);
+      REQUIRE(copy.size() == 2u);
+      REQUIRE(small == v);
+      SmallVector<Tracked, 3> moved(std::move(copy));
+      REQUIRE(moved[1].value() == 5);
+      REQUIRE(g_live_objects == 9 + 9 + 2);
+    }
+    REQUIRE(g_live_objects == 0);
+  }
+
+  SECTION("growth copes with arguments that alias the vector") {
+    SmallVector<std::string, 2> v = {"first", "second"};
+    v.push_back(v[0]);
+    REQUIRE(v.size() == 3u);
+    REQUIRE(v[2] == "first");
+
+    v.insert(v.begin() + 1, v.begin(), v.end());
+    REQUIRE(v == SmallVector<std::string, 2>(
+                     {"first", "first", "second", "first", "second", "first"}));
+
+    v.insert(v.end(), 100, v[1]);
+    REQUIRE(v.size() == 106u);
+    REQUIRE(v.back() == "first");
+
+    // Long enough to live on the heap, so that reading a destroyed copy
+    // shows.
+    const std::string kLong(100, 'x');
+    SmallVector<std::string, 2> w = {kLong, "short"};
+    w.assign(2, w[0]);
+    REQUIRE(w == SmallVector<std::string, 2>({kLong, kLong}));
+    w.assign(5, w[1]);
+    REQUIRE(w == SmallVector<std::string, 2>(5, kLong));
+  }
+
+  SECTION("move-only elements") {
+    SmallVector<std::unique_ptr<int>, 1> v;
+    v.push_back(std::unique_ptr<int>(new int(1)));
+    v.push_back(std::unique_ptr<int>(new int(2)));
+    v.emplace(v.begin(), new int(0));
+    REQUIRE(*v[0] == 0);
+    REQUIRE(*v[2] == 2);
+    v.pop_back();
+    REQUIRE(v.size() == 2u);
+  }
+
+  SECTION("split results") {
+    StringPieceSmallVector fields;
+    SplitStringPiece(" a, b ,,c ", ",", TRIM_WHITESPACE, SPLIT_WANT_ALL,
+                     &fields);
+    REQUIRE(fields.size() == 4u);
+    REQUIRE(fields[1] == "b");
+    REQUIRE(fields[2].empty());
+    REQUIRE(fields.using_inline_storage());
+    SplitStringPiece("x;y", ";", KEEP_WHITESPACE, SPLIT_WANT_NONEMPTY,
+                     &fields);
+    REQUIRE(fields.size() == 2u);
+  }
+
+  SECTION("observer lists and command lines") {
+    ObserverList<Observer> observers;
+    Observer observer[6];
+    for (Observer& o : observer)
+      observers.AddObserver(&o);
+    observers.RemoveObserver(&observer[2]);
+    FOR_EACH_OBSERVER(Observer, observers, Notify());
+    REQUIRE(observer[0].calls == 1);
+    REQUIRE(observer[2].calls == 0);
+    REQUIRE(observer[5].calls == 1);
+
+    const char* argv[] = {"program", "--switch=value", "argument"};
+    CommandLine command_line(3, argv);
+    REQUIRE(command_line.GetSwitchValueASCII("switch") == "value");
+    REQUIRE(command_line.GetArgs().size() == 1u);
+    REQUIRE(command_line.argv().size() == 3u);
+  }
+}
+
+}  // namespace base
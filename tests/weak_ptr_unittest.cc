@@ -0,0 +1,108 @@
+#include <vector>
+
+#include "catch2/catch.hpp"
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+
+namespace base {
+
+namespace {
+
+struct Target {
+  Target() : value(0) {}
+  int value;
+};
+
+class Receiver : public SupportWeakCallback {
+ public:
+  Receiver() : calls(0) {}
+
+  void Increment(int amount) { calls += amount; }
+  int Calls() const { return calls; }
+
+  int calls;
+};
+
+}  // namespace
+
+TEST_CASE("WeakPtr", "[WeakPtr]") {
+  SECTION("invalidation") {
+    Target target;
+    WeakPtrFactory<Target> factory(&target);
+    REQUIRE(!factory.HasWeakPtrs());
+    WeakPtr<Target> weak = factory.GetWeakPtr();
+    WeakPtr<Target> copy = weak;
+    REQUIRE(factory.HasWeakPtrs());
+    REQUIRE(copy.get() == &target);
+
+    factory.InvalidateWeakPtrs();
+    REQUIRE(!factory.HasWeakPtrs());
+    REQUIRE(!weak);
+    REQUIRE(copy.get() == nullptr);
+
+    // New pointers are valid again; the old ones stay invalid.
+    WeakPtr<Target> fresh = factory.GetWeakPtr();
+    REQUIRE(fresh.get() == &target);
+    REQUIRE(!weak);
+  }
+
+  SECTION("reused slots do not revive stale pointers") {
+    std::vector<WeakPtr<Target>> stale;
+    Target target;
+    for (int i = 0; i < 100; ++i) {
+      WeakPtrFactory<Target> factory(&target);
+      stale.push_back(factory.GetWeakPtr());
+    }
+    std::vector<WeakPtrFactory<Target>*> live;
+    for (int i = 0; i < 100; ++i) {
+      live.push_back(new WeakPtrFactory<Target>(&target));
+      live.back()->GetWeakPtr();
+    }
+    for (const WeakPtr<Target>& weak : stale)
+      REQUIRE(!weak);
+    for (WeakPtrFactory<Target>* factory : live)
+      delete factory;
+  }
+
+  SECTION("reset") {
+    Target target;
+    WeakPtrFactory<Target> factory(&target);
+    WeakPtr<Target> weak = factory.GetWeakPtr();
+    weak.reset();
+    REQUIRE(!weak);
+    REQUIRE(factory.GetWeakPtr().get() == &target);
+  }
+}
+
+TEST_CASE("WeakCallback", "[WeakPtr]") {
+  SECTION("callbacks expire with their receiver") {
+    Receiver* receiver = new Receiver;
+    auto callback = Bind(&Receiver::Increment, receiver, 2);
+    auto const_callback = Bind(&Receiver::Calls, receiver);
+    callback();
+    REQUIRE(receiver->calls == 2);
+    REQUIRE(const_callback() == 2);
+    delete receiver;
+    REQUIRE(callback.Expired());
+    callback();
+    REQUIRE(const_callback() == 0);
+  }
+
+  SECTION("WeakCallbackFlag cancels") {
+    int calls = 0;
+    WeakCallbackFlag flag;
+    REQUIRE(!flag.HasUsed());
+    auto callback = flag.ToWeakCallback(std::function<void()>([&calls]() {
+      ++calls;
+    }));
+    REQUIRE(flag.HasUsed());
+    callback();
+    flag.Cancel();
+    callback();
+    REQUIRE(calls == 1);
+    REQUIRE(callback.Expired());
+  }
+}
+
+}  // namespace base